@@ -7,6 +7,22 @@
  #include <stdlib.h>
  #include "includes.h"
  
+ #if OS_TRACE_EN == 0
+ #error "lab1 needs OS_TRACE_EN set to 1 in os_cfg.h to display context switches"
+ #endif
+ #if OS_DEADLINE_EN == 0
+ #error "lab1 needs OS_DEADLINE_EN set to 1 in os_cfg.h to detect deadline misses"
+ #endif
+ #if OS_TASK_PERIODIC_EN == 0
+ #error "lab1 needs OS_TASK_PERIODIC_EN set to 1 in os_cfg.h to create periodic tasks"
+ #endif
+ #if OS_SLOTQ_EN == 0
+ #error "lab1 needs OS_SLOTQ_EN set to 1 in os_cfg.h to queue its messages"
+ #endif
+ #ifndef OS_CPU_SPIN
+ #define OS_CPU_SPIN()                          /* Only the simulator (ports/posix) needs it */
+ #endif
+ 
   /* Task stack sizes */
   #define TASK_STACKSIZE 4096
  
@@ -15,7 +31,19 @@
   #define TASK1_PRIO      6   /* Highest priority - shortest period */
   #define TASK2_PRIO      7
   #define TASK3_PRIO      8   /* For task set 2 */
-  #define PRINT_TASK_PRIO 10  /* Lowest priority for print task */
+  #define TASK_LAST_PRIO  TASK3_PRIO  /* Lowest priority of the application tasks */
+ 
+  /* The print task runs above the periodic tasks.  Task set 2 overloads the CPU
+     (1/3 + 3/6 + 4/9 > 1), so below them it would only run in the few idle ticks:
+     the queue would fill up and lines would be lost, and its switches would hide
+     the completions to the idle task.  Its own switches are left out of the trace. */
+  #define PRINT_TASK_PRIO 4
+ 
+  /* Message queue: lines are formatted and printed in place in its slots.  Each
+     commit readies the print task, which prints the line at once, so few slots
+     are ever in use. */
+  #define MSG_NSLOTS      16
+  #define MSG_SIZE        64
  
   /* Global variables */
   OS_STK TaskStartStk[TASK_STACKSIZE];
@@ -24,18 +52,8 @@
   OS_STK Task3Stk[TASK_STACKSIZE];
   OS_STK PrintTaskStk[TASK_STACKSIZE];
  
-  /* Message buffer for event output */
- // #define MSG_BUF_SIZE 100
- // char MsgBuffer[MSG_BUF_SIZE];
- // INT8U MsgReady = 0;
-  //way 2
- #define MAX_MSG_QUEUE 100
- #define MSG_BUF_SIZE 100
- 
- char MsgQueue[MAX_MSG_QUEUE][MSG_BUF_SIZE];  // 消息隊列
- INT8U MsgQueueIn = 0;                       // 寫入位置
- INT8U MsgQueueOut = 0;                      // 讀取位置
- INT8U MsgCount = 0;                         // 當前消息數量
+  char      MsgSlots[MSG_NSLOTS][MSG_SIZE];
+  OS_EVENT *MsgQ;
  
   /* Task parameters (computation time, period) */
   typedef struct {
@@ -46,16 +64,16 @@
   TASK_PARAM Task1Param = {1, 3};  /* t1(1,3) */
   TASK_PARAM Task2Param = {3, 6};  /* t2(3,6) */
   TASK_PARAM Task3Param = {4, 9};  /* t3(4,9) */
-  INT32U TaskStartTime;
   /* Function prototypes */
   void TaskStart(void *pdata);
-  void PeriodicTask(void *pdata);
+  void PeriodicJob(void *pdata);
   void PrintTask(void *pdata);
+  void PrintTrace(void);
  
   /* Main function */
   int main(void)
   {
-      OSInit();                                  /* Initialize uC/OS-II */
+      /* uC/OS-II is already initialized: the port calls OSInit() before main() */
  
       /* Create the startup task */
       OSTaskCreateExt(TaskStart,
@@ -71,186 +89,152 @@
       OSStart();                                /* Start multitasking */
       return 0;
   }
-  void AddMessageToQueue(const char *msg) {
-     #if OS_CRITICAL_METHOD == 3  /* 為 CPU 狀態寄存器分配存儲空間 */
-     OS_CPU_SR cpu_sr = 0;
-     #endif
-      OS_ENTER_CRITICAL();
-      if (MsgCount < MAX_MSG_QUEUE) {
-           strcpy(MsgQueue[MsgQueueIn], msg);
-           MsgQueueIn = (MsgQueueIn + 1) % MAX_MSG_QUEUE;
-           MsgCount++;
+  /* Decode the kernel's context switch trace ring into the message queue */
+  void PrintTrace(void)
+  {
+      OS_TRACE_REC rec;
+      char *msg;
+      INT8U err;
+ 
+      while (OSTraceRead(&rec, 1) > 0) {
+          /* Hide the switches to PrintTask, made to print these lines */
+          if (rec.OSTraceFrom == PRINT_TASK_PRIO || rec.OSTraceTo == PRINT_TASK_PRIO) {
+              continue;
+          }
+          /* Only show completions involving the application tasks */
+          if (rec.OSTraceEvent == OS_TRACE_EVT_COMPLETE &&
+              !((rec.OSTraceFrom >= TASK_START_PRIO && rec.OSTraceFrom <= TASK_LAST_PRIO) ||
+                (rec.OSTraceTo   >= TASK_START_PRIO && rec.OSTraceTo   <= TASK_LAST_PRIO))) {
+              continue;
+          }
+          msg = (char *)OSSlotQReserve(MsgQ, &err);
+          if (msg == NULL) {
+              continue;                        /* Queue full: drop the line */
+          }
+          switch (rec.OSTraceEvent) {          /* Format the line in place ... */
+              case OS_TRACE_EVT_PREEMPT:
+                   snprintf(msg, MSG_SIZE, "%5d Preempt     %3d      %3d\n",
+                            (int)rec.OSTraceTime, (int)rec.OSTraceFrom, (int)rec.OSTraceTo);
+                   break;
+ 
+              case OS_TRACE_EVT_COMPLETE:
+                   snprintf(msg, MSG_SIZE, "%5d Complete    %3d      %3d\n",
+                            (int)rec.OSTraceTime, (int)rec.OSTraceFrom, (int)rec.OSTraceTo);
+                   break;
+ 
+              case OS_TRACE_EVT_DEADLINE:
+                   snprintf(msg, MSG_SIZE, "time:%5d Task%d exceed deadline\n",
+                            (int)rec.OSTraceTime, (int)rec.OSTraceFrom);
+                   break;
+ 
+              case OS_TRACE_EVT_BUDGET:
+                   snprintf(msg, MSG_SIZE, "time:%5d Task%d overran its budget\n",
+                            (int)rec.OSTraceTime, (int)rec.OSTraceFrom);
+                   break;
+ 
+              default:
+                   msg[0] = '\0';
+                   break;
+          }
+          OSSlotQCommit(MsgQ, msg);            /* ... and hand it to PrintTask */
       }
-      OS_EXIT_CRITICAL();
   }
   /* Startup task */
   void TaskStart(void *pdata)
   {
+      INT8U err;
+ 
       /* Initialize system */
       OSTimeSet(0);                            /* Reset system time */
  
-      /* Create application tasks (Task Set 1) */
-      OSTaskCreateExt(PeriodicTask,
-                      (void *)&Task1Param,
-                      (void *)&Task1Stk[TASK_STACKSIZE-1],
-                      TASK1_PRIO,
-                      TASK1_PRIO,
-                      Task1Stk,
-                      TASK_STACKSIZE,
+      /* Create the message queue and the print task */
+      MsgQ = OSSlotQCreate(&MsgSlots[0][0], MSG_NSLOTS, MSG_SIZE, &err);
+      OSTaskCreateExt(PrintTask,
                       NULL,
-                      0);
- 
-      OSTaskCreateExt(PeriodicTask,
-                      (void *)&Task2Param,
-                      (void *)&Task2Stk[TASK_STACKSIZE-1],
-                      TASK2_PRIO,
-                      TASK2_PRIO,
-                      Task2Stk,
+                      (void *)&PrintTaskStk[TASK_STACKSIZE-1],
+                      PRINT_TASK_PRIO,
+                      PRINT_TASK_PRIO,
+                      PrintTaskStk,
                       TASK_STACKSIZE,
                       NULL,
                       0);
  
-      /* Uncomment for Task Set 2 */
+      /* Create application tasks (Task Set 1) */
+      OSTaskCreatePeriodic(PeriodicJob,
+                           NULL,
+                           (void *)&Task1Stk[TASK_STACKSIZE-1],
+                           TASK1_PRIO,
+                           TASK1_PRIO,
+                           Task1Stk,
+                           TASK_STACKSIZE,
+                           NULL,
+                           0,
+                           Task1Param.c,             /* C */
+                           Task1Param.p,             /* T */
+                           0,                        /* D = T */
+                           0);                       /* Released at time 0 */
+ 
+      OSTaskCreatePeriodic(PeriodicJob,
+                           NULL,
+                           (void *)&Task2Stk[TASK_STACKSIZE-1],
+                           TASK2_PRIO,
+                           TASK2_PRIO,
+                           Task2Stk,
+                           TASK_STACKSIZE,
+                           NULL,
+                           0,
+                           Task2Param.c,             /* C */
+                           Task2Param.p,             /* T */
+                           0,                        /* D = T */
+                           0);                       /* Released at time 0 */
  
-      OSTaskCreateExt(PeriodicTask,
-                      (void *)&Task3Param,
-                      (void *)&Task3Stk[TASK_STACKSIZE-1],
-                      TASK3_PRIO,
-                      TASK3_PRIO,
-                      Task3Stk,
-                      TASK_STACKSIZE,
-                      NULL,
-                      0);
+      /* Uncomment for Task Set 2 */
  
- //     /* Create print task */
- //     OSTaskCreateExt(PrintTask,
- //                     NULL,
- //                     (void *)&PrintTaskStk[TASK_STACKSIZE-1],
- //                     PRINT_TASK_PRIO,
- //                     PRINT_TASK_PRIO,
- //                     PrintTaskStk,
- //                     TASK_STACKSIZE,
- //                     NULL,
- //                     0);
+      OSTaskCreatePeriodic(PeriodicJob,
+                           NULL,
+                           (void *)&Task3Stk[TASK_STACKSIZE-1],
+                           TASK3_PRIO,
+                           TASK3_PRIO,
+                           Task3Stk,
+                           TASK_STACKSIZE,
+                           NULL,
+                           0,
+                           Task3Param.c,             /* C */
+                           Task3Param.p,             /* T */
+                           0,                        /* D = T */
+                           0);                       /* Released at time 0 */
  
       /* Display header */
       printf("\nTime  Event       [From]   [To]\n");
       printf("---------------------------------\n");
-      OSTimeSet(0);
-      TaskStartTime=OSTimeGet();
-      /* Reset system time */
       /* Delete self */
       OSTaskDel(OS_PRIO_SELF);
   }
  
-  /* Periodic task implementation */
-  void PeriodicTask(void *pdata)
+  /* One job of a periodic task, released by the kernel every period */
+  void PeriodicJob(void *pdata)
   {
-      INT32U start;
-      INT32U end;
-      INT32U toDelay;
-      TASK_PARAM *param;
- 
-      #if OS_CRITICAL_METHOD == 3
-      OS_CPU_SR cpu_sr;
-      #endif
- 
- 
-      param = (TASK_PARAM *)pdata;
- 
-      /* Initialize task's compTime and period */
-      OS_ENTER_CRITICAL();
-      OSTCBCur->compTime = param->c;
-      OSTCBCur->period = param->p;
-      OS_EXIT_CRITICAL();
- 
-      start = (INT32U)((OSTimeGet() / OSTCBCur->period) * OSTCBCur->period+TaskStartTime);
-      OS_ENTER_CRITICAL();
-      OSTCBCur->deadline = (INT32U)(start + OSTCBCur->period);
-      OS_EXIT_CRITICAL();
- 
-      while(1) {
-          /* Consume CPU for c ticks */
-          //printf("Task %d: high proity %3d\n ",(int)OSTCBCur->OSTCBPrio,(int)OSPrioHighRdy);
-          while(((int)((OSTCBCur->period) - (OSTimeGet() - start))>0)&& OSTCBCur->compTime > 0 ) {
-              //printf("[hello] Task %d: compTime = %d\n", (int)OSTCBCur->OSTCBPrio, (int)OSTCBCur->compTime);
-              /* Do nothing, just consume CPU time */
-          }
- 
-          /* Calculate end time and delay for next period */
-          end = OSTimeGet();
-          toDelay = (OSTCBCur->period) - (end - start);
- 
-          /* Calculate start of next period */
-          start = start + (OSTCBCur->period);
-          //printf("Task %d: compTime = %d\n", (int)OSTCBCur->OSTCBPrio, (int)OSTCBCur->compTime);
-          /* Reset computation time counter */
-          OS_ENTER_CRITICAL();
-          OSTCBCur->compTime = param->c;
- 
- //         char tempBuf[MSG_BUF_SIZE];
- //         sprintf(tempBuf,"Task %d: deadline = %5d\n",  (int)OSTCBCur->OSTCBPrio,(int)OSTCBCur->deadline);
- //		 AddMessageToQueue(tempBuf);
-          OS_EXIT_CRITICAL();
- 
-          OS_ENTER_CRITICAL();
-          while (MsgCount > 0) {
-              printf("%s", MsgQueue[MsgQueueOut]);
-              MsgQueueOut = (MsgQueueOut + 1) % MAX_MSG_QUEUE;
-              MsgCount--;
-          }
-          OS_EXIT_CRITICAL();
- //		 if ((int)OSTCBCur->OSTCBPrio==8){
- //			 //printf("Task %d: compTime = %d\n", (int)OSTCBCur->OSTCBPrio, (int)OSTCBCur->compTime);
- //			 char tempBuf[MSG_BUF_SIZE];
- //			 //sprintf(tempBuf,"Task %d: compTime = %d\n", (int)OSTCBCur->OSTCBPrio, (int)OSTCBCur->compTime);
- //			 sprintf(tempBuf,"Task %d: dly = %d\n",  (int)OSTCBCur->OSTCBPrio,(int)toDelay);
- //			 AddMessageToQueue(tempBuf);
- //		  }
- 
-          /* Delay until next period */
-          OSTimeSet(end);
-          if (((int)toDelay) > 0) {
-              OS_ENTER_CRITICAL();
-              OSTCBCur->deadline += (INT32U)OSTCBCur->period;
-              OS_EXIT_CRITICAL();
-              OSTimeDly(toDelay);
+      /* Consume CPU until the tick has used up the job's computation time */
+      while (*(volatile INT8U *)&OSTCBCur->compTime > 0) {
+          OS_CPU_SPIN();                       /* Just consume CPU time */
+      }
  
-          } else {
-              /* Deadline violation occurred */
-              //printf("%5d Deadline Violation for Task %d\n", (int)OSTimeGet(), (int)OSTCBCur->OSTCBPrio);
- //             char tempBuf[MSG_BUF_SIZE];
- //			 sprintf(tempBuf, "%5d Deadline Violation for Task %d\n", (int)OSTimeGet(), (int)OSTCBCur->OSTCBPrio);
- //			 AddMessageToQueue(tempBuf);
+      PrintTrace();                            /* Format trace records outside of critical section */
+  }
  
-              /* Reset for next period */
-              // 如果出現截止期違例，重新調整週期計數
-              int periodCount = OSTimeGet() / OSTCBCur->period;
-              start = periodCount * OSTCBCur->period;
+  /* Print task: print each message in its slot, then give the slot back */
+  void PrintTask(void *pdata)
+  {
+      char *msg;
+      INT8U err;
+ 
+      while (1) {
+          msg = (char *)OSSlotQPend(MsgQ, 0, &err);
+          if (err == OS_ERR_NONE) {
+              printf("%s", msg);
+              OSSlotQRelease(MsgQ, msg);
           }
       }
   }
  
- // /* Print task implementation */
- // void PrintTask(void *pdata)
- // {
- //	while(1) {
- //		#if OS_CRITICAL_METHOD == 3
- //		OS_CPU_SR cpu_sr = 0;
- //		#endif
- //		OS_ENTER_CRITICAL();
- //		if (MsgCount > 0) {
- //			printf("%s\n", MsgQueue[MsgQueueOut]);
- //			MsgQueueOut = (MsgQueueOut + 1) % MAX_MSG_QUEUE;
- //			MsgCount--;
- //		}
- ////		if (MsgReady==1){
- ////			 printf("%s\n", MsgBuffer);
- ////			 MsgReady = 0;
- ////		}
- //		OS_EXIT_CRITICAL();
- //		//OSTimeDly(1);
- //	}
- // }
- 
  
\ No newline at end of file
@@ -0,0 +1,194 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                         CPU BUDGET ENFORCEMENT
+*
+* File    : OS_BUDGET.C
+* Version : V2.86
+*
+* Note(s) : 1) A task may be given a CPU budget of 'budget' ticks every 'period' ticks.  OSTimeTick() charges
+*              each tick to the task that was running when the tick occurred (the same accounting as
+*              OSTCBCur->compTime).  The budget is replenished lazily, the first time the task is charged in
+*              a new period.
+*
+*           2) A task overruns its budget when it is charged a tick while it has no budget left.  Every
+*              period with an overrun increments OSTCBBudgetOvrCtr and, depending on the options given to
+*              OSTaskBudgetSet(), calls the task's overrun hook and/or throttles the task: the task is delayed
+*              until its next budget period, exactly as if it had called OSTimeDly().
+*
+*           3) A task is not throttled while the scheduler is locked.  It is throttled on the first tick
+*              charged to it after the scheduler is unlocked.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_BUDGET_EN > 0
+/*
+*********************************************************************************************************
+*                                      SET THE CPU BUDGET OF A TASK
+*
+* Description: This function sets the CPU budget of a task and the action taken when the task overruns it.
+*
+* Arguments  : prio      is the priority of the task.  If you specify OS_PRIO_SELF, the budget of the calling
+*                        task is set.
+*
+*              budget    is the number of ticks the task may run in each period.  0 stops budget enforcement.
+*
+*              period    is the budget replenishment period (in ticks).  If 0, the period of the task (see
+*                        OSTaskPeriodSet() and OSTaskCreatePeriodic()) is used.
+*
+*              opt       is the action taken when the budget is overrun:
+*                        OS_BUDGET_OPT_NONE       only count the overruns
+*                        OS_BUDGET_OPT_THROTTLE   delay the task until its next budget period
+*                        OS_BUDGET_OPT_HOOK       call 'phook'
+*                        (OS_BUDGET_OPT_THROTTLE and OS_BUDGET_OPT_HOOK may be combined)
+*
+*              phook     is a pointer to the function called with the task's priority when the task overruns
+*                        its budget.  The hook is called from OSTimeTick() with interrupts disabled.
+*
+* Returns    : OS_ERR_NONE            if the budget was set.
+*              OS_ERR_PRIO_INVALID    if the priority is higher than the maximum allowed or is the idle task.
+*              OS_ERR_INVALID_OPT     if 'opt' is not valid.
+*              OS_ERR_PDATA_NULL      if OS_BUDGET_OPT_HOOK is specified and 'phook' is a NULL pointer.
+*              OS_ERR_TASK_NOT_EXIST  if the task does not exist.
+*              OS_ERR_TASK_PERIOD     if 'period' is 0 and the task has no period.
+*
+* Notes      : 1) The budget periods of a task created by OSTaskCreatePeriodic() start at the release of its
+*                 jobs.  Otherwise, the first budget period starts when this function is called.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskBudgetSet (INT8U prio, INT16U budget, INT16U period, INT8U opt, OS_BUDGET_HOOK phook)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                      /* Not allowed for the idle task either         */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if ((opt & ~(OS_BUDGET_OPT_THROTTLE | OS_BUDGET_OPT_HOOK)) != 0) {
+        return (OS_ERR_INVALID_OPT);
+    }
+    if ((opt & OS_BUDGET_OPT_HOOK) != 0) {             /* Validate 'phook'                             */
+        if (phook == (OS_BUDGET_HOOK)0) {
+            return (OS_ERR_PDATA_NULL);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if setting our own budget                */
+        prio = OSTCBCur->OSTCBPrio;
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if (ptcb == (OS_TCB *)0) {                         /* Task must exist                              */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb == OS_TCB_RESERVED) {                     /* Priority may only be reserved by a mutex     */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (period == 0) {                                 /* Use the period of the task                   */
+        period = ptcb->period;
+        if ((period == 0) && (budget != 0)) {
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_TASK_PERIOD);
+        }
+    }
+    ptcb->OSTCBBudget        = budget;
+    ptcb->OSTCBBudgetLeft    = budget;
+    ptcb->OSTCBBudgetPeriod  = period;
+    ptcb->OSTCBBudgetOpt     = opt;
+    ptcb->OSTCBBudgetHook    = phook;
+    ptcb->OSTCBBudgetOvr     = OS_FALSE;
+    ptcb->OSTCBBudgetRelease = OSTime;
+#if OS_TASK_PERIODIC_EN > 0
+    if (ptcb->OSTCBJobFnct != (void (*)(void *))0) {   /* Align budget periods with job releases       */
+        ptcb->OSTCBBudgetRelease = ptcb->OSTCBJobRelease;
+    }
+#endif
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   CHARGE A TICK TO THE RUNNING TASK
+*
+* Description: This function is called by OSTimeTick() to charge the tick that just elapsed to the budget of
+*              the running task and to enforce the budget when it is overrun.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) OSTime has already been incremented, the tick that elapsed started at OSTime - 1.
+*********************************************************************************************************
+*/
+
+void  OS_BudgetTick (void)
+{
+    OS_TCB  *ptcb;
+    INT32U   elapsed;
+    INT32U   period;
+    INT32U   dly;
+
+
+    ptcb = OSTCBCur;
+    if (ptcb->OSTCBBudget == 0) {                      /* Budget of this task is not enforced          */
+        return;
+    }
+    period  = (INT32U)ptcb->OSTCBBudgetPeriod;
+    elapsed = (OSTime - 1) - ptcb->OSTCBBudgetRelease;
+    if ((INT32S)elapsed >= (INT32S)period) {           /* Tick is in a new period, replenish budget    */
+        ptcb->OSTCBBudgetRelease += (elapsed / period) * period;
+        ptcb->OSTCBBudgetLeft     = ptcb->OSTCBBudget;
+        ptcb->OSTCBBudgetOvr      = OS_FALSE;
+    }
+    if (ptcb->OSTCBBudgetLeft > 0) {                   /* Task is within its budget                    */
+        ptcb->OSTCBBudgetLeft--;
+        return;
+    }
+    if (ptcb->OSTCBBudgetOvr == OS_FALSE) {            /* First overrun in this period                 */
+        ptcb->OSTCBBudgetOvr = OS_TRUE;
+        ptcb->OSTCBBudgetOvrCtr++;
+#if OS_TRACE_EN > 0
+        OS_TraceRec(OS_TRACE_EVT_BUDGET, ptcb->OSTCBPrio, ptcb->OSTCBPrio);
+#endif
+        if ((ptcb->OSTCBBudgetOpt & OS_BUDGET_OPT_HOOK) != 0) {
+            (*ptcb->OSTCBBudgetHook)(ptcb->OSTCBPrio);
+        }
+    }
+    if ((ptcb->OSTCBBudgetOpt & OS_BUDGET_OPT_THROTTLE) == 0) {
+        return;
+    }
+    if (OSLockNesting > 0) {                           /* Task can't be switched out, throttle later   */
+        return;
+    }
+    if ((ptcb->OSTCBStat != OS_STAT_RDY) || (ptcb->OSTCBDly != 0)) {
+        return;                                        /* Task is already blocked                      */
+    }
+    dly = (ptcb->OSTCBBudgetRelease + period) - OSTime;
+    if (dly == 0) {                                    /* Next budget period starts with the next tick */
+        return;
+    }
+    OS_RDY_DEL(ptcb);                                  /* Delay task until its next budget period      */
+    ptcb->OSTCBDly = (INT16U)dly;                      /* OSIntExit() switches to another task         */
+}
+#endif                                                 /* OS_BUDGET_EN                                 */
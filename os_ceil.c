@@ -0,0 +1,481 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                       PRIORITY CEILING MUTEXES
+*
+* File    : OS_CEIL.C
+* Version : V2.86
+*
+* Note(s) : 1) A priority ceiling mutex follows the immediate priority ceiling protocol (the single CPU form
+*              of the stack resource policy) instead of priority inheritance: the mutex is created with a
+*              ceiling, a priority higher than the priority of every task that locks it, and a task runs
+*              at the ceiling from the moment it locks the mutex until it unlocks it.  As for the PIP of
+*              OSMutexCreate(), the ceiling is reserved in OSTCBPrioTbl[] and can only be used by one
+*              mutex.
+*
+*           2) While the owner runs at the ceiling, no other task that locks the mutex can run, so the
+*              mutex is always found free: locking and unlocking only move the owner in the ready list.
+*              Wait lists and other tasks are not touched and there is no chain of blocking.  A task is
+*              blocked at most once per job, before it starts running, and for at most the longest
+*              critical section of a lower priority task on a mutex whose ceiling is at or above its
+*              priority: the blocking term of a response-time analysis.
+*
+*           3) The guarantee of Note #2 assumes that the owner does not wait (OSTimeDly(), OSSemPend(),
+*              ...) while it holds the mutex.  If it does, the tasks that lock the mutex in the meantime
+*              wait for it in OSMutexCeilPend(), as for a semaphore, and the mutex is handed over to the
+*              highest priority one when it is unlocked.
+*
+*           4) A task may hold several mutexes, but MUST unlock them in the reverse order it locked them.
+*              A task whose priority is higher than the ceiling cannot lock the mutex (OS_ERR_CEIL_LOWER):
+*              the ceiling must be raised instead.
+*
+*           5) Priority ceiling mutexes cannot be passed to OSEventPendMulti().
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_MUTEX_CEIL_EN > 0
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  OS_MUTEX_CEIL_KEEP_LOWER_8   0x00FFu          /* Priority to return the owner to              */
+#define  OS_MUTEX_CEIL_KEEP_UPPER_8   0xFF00u          /* Ceiling                                      */
+
+#define  OS_MUTEX_CEIL_AVAILABLE      0x00FFu
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_MutexCeilBasePrio(OS_TCB *ptcb);
+
+static  void   OS_MutexCeilSetPrio(OS_TCB *ptcb, INT8U prio);
+
+static  void   OS_MutexCeilTake(OS_EVENT *pevent, OS_TCB *ptcb);
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 ACCEPT A PRIORITY CEILING MUTEX
+*
+* Description: This function checks the mutex to see if it is available.  Unlike OSMutexCeilPend(),
+*              OSMutexCeilAccept() does not suspend the calling task if the mutex is not available.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the mutex.
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE         if the call was successful.
+*                               OS_ERR_EVENT_TYPE   if 'pevent' is not a pointer to a ceiling mutex
+*                               OS_ERR_PEVENT_NULL  'pevent' is a NULL pointer
+*                               OS_ERR_PEND_ISR     if you called this function from an ISR
+*                               OS_ERR_CEIL_LOWER   if the priority of the calling task is higher than the
+*                                                   ceiling: the mutex was NOT locked.
+*
+* Returns    : OS_TRUE       if the mutex was available and is now owned by the task, which runs at the
+*                            ceiling.
+*              OS_FALSE      if not.
+*********************************************************************************************************
+*/
+
+BOOLEAN  OSMutexCeilAccept (OS_EVENT *pevent, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return (OS_FALSE);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (OS_FALSE);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_MUTEX_CEIL) {  /* Validate event block type               */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (OS_FALSE);
+    }
+    if (OSIntNesting > 0) {                            /* Make sure it's not called from an ISR        */
+        *perr = OS_ERR_PEND_ISR;
+        return (OS_FALSE);
+    }
+    OS_ENTER_CRITICAL();
+    if (OS_MutexCeilBasePrio(OSTCBCur) < (INT8U)(pevent->OSEventCnt >> 8)) {  /* Above the ceiling?   */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_CEIL_LOWER;
+        return (OS_FALSE);
+    }
+    *perr = OS_ERR_NONE;
+    if ((pevent->OSEventCnt & OS_MUTEX_CEIL_KEEP_LOWER_8) == OS_MUTEX_CEIL_AVAILABLE) {
+        OS_MutexCeilTake(pevent, OSTCBCur);            /* Mutex available, task runs at the ceiling    */
+        OS_EXIT_CRITICAL();
+        return (OS_TRUE);
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_FALSE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  CREATE A PRIORITY CEILING MUTEX
+*
+* Description: This function creates a priority ceiling mutex.
+*
+* Arguments  : ceil          is the ceiling of the mutex: a priority higher (numerically lower) than the
+*                            priority of every task that locks the mutex, not used by any task.
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE         if the call was successful.
+*                               OS_ERR_CREATE_ISR   if you attempted to create a mutex from an ISR
+*                               OS_ERR_PRIO_EXIST   if a task or a mutex already uses the ceiling priority.
+*                               OS_ERR_PEVENT_NULL  No more event control blocks available.
+*                               OS_ERR_PRIO_INVALID if the priority you specify is higher that the maximum
+*                                                   allowed (i.e. >= OS_LOWEST_PRIO)
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control block allocated to the mutex.
+*              == (OS_EVENT *)0  if the mutex could not be created.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSMutexCeilCreate (INT8U ceil, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return ((OS_EVENT *)0);
+    }
+    if (ceil >= OS_LOWEST_PRIO) {                      /* Validate ceiling                             */
+        *perr = OS_ERR_PRIO_INVALID;
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                            /* See if called from ISR ...                   */
+        *perr = OS_ERR_CREATE_ISR;                     /* ... can't CREATE mutex from an ISR           */
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSTCBPrioTbl[ceil] != (OS_TCB *)0) {           /* Mutex priority must not already exist        */
+        OS_EXIT_CRITICAL();                            /* Task already exist at priority ...           */
+        *perr = OS_ERR_PRIO_EXIST;                     /* ... ceiling                                  */
+        return ((OS_EVENT *)0);
+    }
+    OSTCBPrioTbl[ceil] = OS_TCB_RESERVED;              /* Reserve the table entry                      */
+    pevent             = OSEventFreeList;              /* Get next free event control block            */
+    if (pevent == (OS_EVENT *)0) {                     /* See if an ECB was available                  */
+        OSTCBPrioTbl[ceil] = (OS_TCB *)0;              /* No, Release the table entry                  */
+        OS_EXIT_CRITICAL();
+        *perr              = OS_ERR_PEVENT_NULL;       /* No more event control blocks                 */
+        return ((OS_EVENT *)0);
+    }
+    OSEventFreeList        = (OS_EVENT *)OSEventFreeList->OSEventPtr;   /* Adjust the free list        */
+    OS_EXIT_CRITICAL();
+    pevent->OSEventType    = OS_EVENT_TYPE_MUTEX_CEIL;
+    pevent->OSEventCnt     = (INT16U)((INT16U)ceil << 8) | OS_MUTEX_CEIL_AVAILABLE;  /* Resource is avail. */
+    pevent->OSEventPtr     = (void *)0;                /* No task owning the mutex                     */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                      /* Unknown name                                 */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);                      /* Initalize the wait list                      */
+    *perr = OS_ERR_NONE;
+    return (pevent);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PEND ON A PRIORITY CEILING MUTEX
+*
+* Description: This function locks a priority ceiling mutex.  The calling task runs at the ceiling of the
+*              mutex until it unlocks it with OSMutexCeilPost().
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the mutex.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for the mutex up to the amount of time specified by this argument, if it
+*                            is held by a task that waits (see Note #3 of OS_CEIL.C).  If you specify 0,
+*                            however, your task will wait forever for the mutex.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*                               OS_ERR_NONE         The call was successful and your task owns the mutex
+*                               OS_ERR_TIMEOUT      The mutex was not available within the specified 'timeout'.
+*                               OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a ceiling mutex
+*                               OS_ERR_PEVENT_NULL  'pevent' is a NULL pointer
+*                               OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                   would lead to a suspension.
+*                               OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*                               OS_ERR_CEIL_LOWER   If the priority of the calling task is higher than the
+*                                                   ceiling: the mutex was NOT locked.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSMutexCeilPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return;
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_MUTEX_CEIL) {  /* Validate event block type               */
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    if (OSIntNesting > 0) {                            /* See if called from ISR ...                   */
+        *perr = OS_ERR_PEND_ISR;                       /* ... can't PEND from an ISR                   */
+        return;
+    }
+    if (OSLockNesting > 0) {                           /* See if called with scheduler locked ...      */
+        *perr = OS_ERR_PEND_LOCKED;                    /* ... can't PEND when locked                   */
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    if (OS_MutexCeilBasePrio(OSTCBCur) < (INT8U)(pevent->OSEventCnt >> 8)) {  /* Above the ceiling?   */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_CEIL_LOWER;
+        return;
+    }
+    if ((pevent->OSEventCnt & OS_MUTEX_CEIL_KEEP_LOWER_8) == OS_MUTEX_CEIL_AVAILABLE) {
+        OS_MutexCeilTake(pevent, OSTCBCur);            /* Mutex available, task runs at the ceiling    */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return;
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;          /* Owner waits: task will have to pend too      */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OSTCBCur->OSTCBDly       = timeout;                /* Load timeout into TCB                        */
+    OS_EventTaskWait(pevent);                          /* Suspend task until event or timeout occurs   */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                        /* Find next highest priority task ready to run */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                 /* See if we timed-out or aborted               */
+        case OS_STAT_PEND_OK:                          /* Mutex handed over by OSMutexCeilPost()       */
+            *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+            *perr = OS_ERR_PEND_ABORT;                 /* Indicate that we aborted                     */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+            *perr = OS_ERR_TIMEOUT;                    /* Indicate that we didn't get mutex within TO  */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;       /* Set   task  status to ready                  */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;   /* Clear pend  status                           */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;     /* Clear event pointers                         */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  POST TO A PRIORITY CEILING MUTEX
+*
+* Description: This function unlocks a priority ceiling mutex.  The calling task returns to the priority it
+*              had when it locked the mutex.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the mutex.
+*
+* Returns    : OS_ERR_NONE             The call was successful and the mutex was unlocked.
+*              OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a ceiling mutex
+*              OS_ERR_PEVENT_NULL      'pevent' is a NULL pointer
+*              OS_ERR_POST_ISR         Attempted to post from an ISR (not valid for mutexes)
+*              OS_ERR_NOT_MUTEX_OWNER  The task that did the post is NOT the owner of the mutex.
+*
+* Note(s)    : 1) If a task waits for the mutex (see Note #3 of OS_CEIL.C), the mutex is handed over to the
+*                 highest priority one, which then runs at the ceiling.
+*********************************************************************************************************
+*/
+
+INT8U  OSMutexCeilPost (OS_EVENT *pevent)
+{
+    INT8U      ceil;
+    INT8U      prio;
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                            /* See if called from ISR ...                   */
+        return (OS_ERR_POST_ISR);                      /* ... can't POST mutex from an ISR             */
+    }
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_MUTEX_CEIL) {  /* Validate event block type               */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSTCBCur != (OS_TCB *)pevent->OSEventPtr) {    /* See if posting task owns the mutex           */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NOT_MUTEX_OWNER);
+    }
+    ceil = (INT8U)(pevent->OSEventCnt >> 8);
+    prio = (INT8U)(pevent->OSEventCnt & OS_MUTEX_CEIL_KEEP_LOWER_8);
+    OSTCBCur->OSTCBCeilNest--;
+    if (OSTCBCur->OSTCBPrio != prio) {                 /* Return owner to its priority                 */
+        OS_MutexCeilSetPrio(OSTCBCur, prio);
+        OSTCBPrioTbl[ceil] = OS_TCB_RESERVED;          /* Reserve table entry                          */
+    }
+    ptcb = (OS_TCB *)0;
+    if (pevent->OSEventGrp != 0) {                     /* Any task waiting for the mutex?              */
+                                                       /* Yes, Make HPT waiting for mutex ready        */
+        ptcb = OS_EventTaskRdyTCB(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
+    }
+    if (ptcb != (OS_TCB *)0) {
+        OS_MutexCeilTake(pevent, ptcb);                /*      It owns the mutex, at the ceiling       */
+    } else {
+        pevent->OSEventCnt |= OS_MUTEX_CEIL_AVAILABLE; /* No,  Mutex is now available                  */
+        pevent->OSEventPtr  = (void *)0;
+    }
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                        /* Tasks below the ceiling may run again        */
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   GET THE OWN PRIORITY OF A TASK
+*
+* Description: This function returns the priority a task has when it holds no priority ceiling mutex, to
+*              check it against the ceiling of a mutex the task locks.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+* Returns    : The priority of the task, before it was raised to any ceiling.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_MutexCeilBasePrio (OS_TCB *ptcb)
+{
+    if (ptcb->OSTCBCeilNest == 0) {
+        return (ptcb->OSTCBPrio);
+    }
+    return (ptcb->OSTCBCeilBasePrio);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CHANGE THE PRIORITY OF AN OWNER
+*
+* Description: This function moves a task that is ready (or suspended) to another priority.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+*              prio          is the new priority of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The task is not in any wait list: it is the running task or a task just made ready.
+*********************************************************************************************************
+*/
+
+static  void  OS_MutexCeilSetPrio (OS_TCB *ptcb, INT8U prio)
+{
+    BOOLEAN  rdy;
+
+
+    rdy = OS_RDY_TST(ptcb);                            /* Not ready if suspended                       */
+    if (rdy == OS_TRUE) {                              /* Remove task from the ready list, if ready    */
+        OS_RDY_DEL(ptcb);
+    }
+    ptcb->OSTCBPrio = prio;
+    ptcb->OSTCBY    = (INT8U)(prio >> OS_PRIO_ROW_SHIFT);
+    ptcb->OSTCBX    = (INT8U)(prio &  OS_PRIO_ROW_MSK);
+    ptcb->OSTCBBitY = OS_PRIO_BIT_Y(ptcb->OSTCBY);
+    ptcb->OSTCBBitX = OS_PRIO_BIT_X(ptcb->OSTCBX);
+    if (rdy == OS_TRUE) {                              /* Make task ready at its new priority          */
+        OS_RDY_INS(ptcb);
+    }
+#if OS_SCHED_RR_EN > 0
+    if (prio != ptcb->OSTCBRRLevel) {                  /* Back at its level: table holds its first     */
+        OSTCBPrioTbl[prio] = ptcb;
+    }
+#else
+    OSTCBPrioTbl[prio] = ptcb;
+#endif
+    if (ptcb == OSTCBCur) {                            /* OS_Sched() compares with the running prio.   */
+        OSPrioCur = prio;
+    }
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      GIVE A MUTEX TO A TASK
+*
+* Description: This function makes a task the owner of an available mutex and raises the task to the
+*              ceiling of the mutex, if it runs below it.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the mutex.
+*
+*              ptcb          is a pointer to the TCB of the new owner.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The priority the task had is kept in the mutex, for OSMutexCeilPost().  A task holding a
+*                 mutex with a higher ceiling already runs above the ceiling and keeps its priority.
+*********************************************************************************************************
+*/
+
+static  void  OS_MutexCeilTake (OS_EVENT *pevent, OS_TCB *ptcb)
+{
+    INT8U  ceil;
+
+
+    ceil                = (INT8U)(pevent->OSEventCnt >> 8);
+    pevent->OSEventCnt &= OS_MUTEX_CEIL_KEEP_UPPER_8;  /* Keep the ceiling and ...                     */
+    pevent->OSEventCnt |= ptcb->OSTCBPrio;             /* ... the priority to return the owner to      */
+    pevent->OSEventPtr  = (void *)ptcb;                /* Point to owning task's OS_TCB                */
+    if (ptcb->OSTCBCeilNest == 0) {                    /* First mutex held by the task                 */
+        ptcb->OSTCBCeilBasePrio = ptcb->OSTCBPrio;
+    }
+    ptcb->OSTCBCeilNest++;
+    if (ptcb->OSTCBPrio > ceil) {
+        OS_MutexCeilSetPrio(ptcb, ceil);               /* Run at the ceiling                           */
+    }
+}
+#endif                                                 /* OS_MUTEX_CEIL_EN                             */
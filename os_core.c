@@ -24,10 +24,6 @@
 #ifndef  OS_MASTER_FILE
 #define  OS_GLOBALS
 #include <ucos_ii.h>
-//extra
-#include <stdio.h>
-#include <stdlib.h>
-#include "includes.h"
 #endif
 
 /*
@@ -36,9 +32,11 @@
 *
 * Note: Index into table is bit pattern to resolve highest priority
 *       Indexed value corresponds to highest priority bit position (i.e. 0..7)
+*       The table is not needed when the CPU's count trailing zeros is used instead (OS_CTZ_EN == 1)
 *********************************************************************************************************
 */
 
+#if OS_CTZ_EN == 0
 INT8U  const  OSUnMapTbl[256] = {
     0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x00 to 0x0F                             */
     4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x10 to 0x1F                             */
@@ -57,6 +55,15 @@ INT8U  const  OSUnMapTbl[256] = {
     5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0xE0 to 0xEF                             */
     4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0        /* 0xF0 to 0xFF                             */
 };
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  OS_CPU_MEM_WORD  OS_MEM_WORD;                   /* Word of OS_MemClr() and OS_MemCopy()       */
 
 /*$PAGE*/
 /*
@@ -65,6 +72,34 @@ INT8U  const  OSUnMapTbl[256] = {
 *********************************************************************************************************
 */
 
+#if OS_DLY_LIST_EN > 0
+static  void  OS_DlyLink(OS_TCB *ptcb);
+
+static  void  OS_DlySw(void);
+#endif
+
+#if (OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0)
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+static  void     OS_EventMultiFlagConsume(OS_FLAG_GRP *pgrp, INT8U wait_type);
+#endif
+
+#if OS_MUTEX_EN > 0
+static  void     OS_EventMultiPIP(OS_EVENT *pevent);
+#endif
+
+static  BOOLEAN  OS_EventMultiTake(OS_EVENT *pevent, void **pmsg, INT32U flags, INT8U wait_type);
+
+static  void     OS_EventNodeUnlink(OS_EVENT_NODE *pnode);
+
+static  INT16U   OS_EventPendMulti(OS_EVENT  **pevents_pend,
+                                   OS_EVENT  **pevents_rdy,
+                                   void      **pmsgs_rdy,
+                                   INT32U      flags,
+                                   INT8U       wait_type,
+                                   INT16U      timeout,
+                                   INT8U      *perr);
+#endif
+
 static  void  OS_InitEventList(void);
 
 static  void  OS_InitMisc(void);
@@ -81,9 +116,15 @@ static  void  OS_InitTCBList(void);
 
 static  void  OS_SchedNew(void);
 
-extern char MsgBuffer[100];
-#define MSG_BUF_SIZE 100
-extern INT8U MsgReady;
+#if OS_TICKLESS_EN > 0
+static  INT16U  OS_TimeDlyNext(void);
+
+static  void    OS_TimeTickN(INT16U ticks);
+#endif
+
+static  void  OS_TimeTickCharge(void);
+
+static  void  OS_TimeTickRdy(OS_TCB *ptcb);
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -144,6 +185,12 @@ INT8U  OSEventNameGet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+#if OS_SLOTQ_EN > 0
+        case OS_EVENT_TYPE_SLOTQ:
+#endif
+#if OS_MUTEX_CEIL_EN > 0
+        case OS_EVENT_TYPE_MUTEX_CEIL:
+#endif
              break;
 
         default:
@@ -218,6 +265,12 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+#if OS_SLOTQ_EN > 0
+        case OS_EVENT_TYPE_SLOTQ:
+#endif
+#if OS_MUTEX_CEIL_EN > 0
+        case OS_EVENT_TYPE_MUTEX_CEIL:
+#endif
              break;
 
         default:
@@ -244,7 +297,8 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
 *
 * Description: This function waits for multiple events.  If multiple events are ready at the start of the
 *              pend call, then all available events are returned as ready.  If the task must pend on the
-*              multiple events, then only the first posted or aborted event is returned as ready.
+*              multiple events, then the first event posted or aborted is returned: the task then leaves
+*              the wait lists of all the other events.
 *
 * Arguments  : pevents_pend  is a pointer to a NULL-terminated array of event control blocks to wait for.
 *
@@ -278,269 +332,90 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
 *                            OS_ERR_PEVENT_NULL  If 'pevents_pend', 'pevents_rdy', or 'pmsgs_rdy' is a 
 *                                                NULL pointer.
 *                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to an array of semaphores, 
-*                                                mailboxes, and/or queues.
+*                                                mailboxes, queues and/or mutexes.
 *                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
 *                                                would lead to a suspension.
 *                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked.
+*                            OS_ERR_EVENT_NODE_DEPLETED  If there were not enough free nodes (see
+*                                                OS_MAX_EVENT_NODES) to wait on all the events.
 *
 * Returns    : >  0          the number of events returned as ready or aborted.
 *              == 0          if no events are returned as ready because of timeout or upon error.
 *
-* Notes      : 1) a. Validate 'pevents_pend' array as valid OS_EVENTs : 
-*
-*                        semaphores, mailboxes, queues
-*
-*                 b. Return ALL available events and messages, if any
-*
-*                 c. Add    current task priority as pending to   each events's wait list
-*                      Performed in OS_EventTaskWaitMulti()
-*
-*                 d. Wait on any of multiple events
-*
-*                 e. Remove current task priority as pending from each events's wait list
-*                      Performed in OS_EventTaskRdy(), if events posted or aborted
+* Notes      : 1) A mutex returned as ready is owned by the task, which MUST release it with OSMutexPost().
+*                 The owner of a mutex the task waits on inherits the mutex's PIP, as with OSMutexPend().
 *
-*                 f. Return any event posted or aborted, if any
-*                      else
-*                    Return timeout
+*              2) Use OSEventPendMultiExt() to also wait on an event flag group.
 *
-*              2) 'pevents_rdy' initialized to NULL PRIOR to all other validation or function handling in 
-*                 case of any error(s).
+*              3) See OS_EventPendMulti() for how the events are waited on.
 *********************************************************************************************************
 */
-/*$PAGE*/
+
 #if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
 INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void **pmsgs_rdy, INT16U timeout, INT8U *perr)
 {
-    OS_EVENT  **pevents;
-    OS_EVENT   *pevent;
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
-    OS_Q       *pq;
-#endif
-    BOOLEAN     events_rdy;
-    INT16U      events_rdy_nbr;
-    INT8U       events_stat;
-#if (OS_CRITICAL_METHOD == 3)                           /* Allocate storage for CPU status register    */
-    OS_CPU_SR   cpu_sr = 0;
-#endif
-
-
-
-#if (OS_ARG_CHK_EN > 0)
-    if (perr == (INT8U *)0) {                           /* Validate 'perr'                             */
-        return (0);
-    }
-    if (pevents_pend == (OS_EVENT **)0) {               /* Validate 'pevents_pend'                     */
-       *perr =  OS_ERR_PEVENT_NULL;
-        return (0);
-    }
-    if (pevents_rdy  == (OS_EVENT **)0) {               /* Validate 'pevents_rdy'                      */
-       *perr =  OS_ERR_PEVENT_NULL;
-        return (0);
-    }
-    if (pmsgs_rdy == (void **)0) {                      /* Validate 'pmsgs_rdy'                        */
-       *perr =  OS_ERR_PEVENT_NULL;
-        return (0);
-    }
-#endif
-
-   *pevents_rdy = (OS_EVENT *)0;                        /* Init array to NULL in case of errors        */
-
-    pevents     =  pevents_pend;
-    pevent      = *pevents;
-    while  (pevent != (OS_EVENT *)0) {
-        switch (pevent->OSEventType) {                  /* Validate event block types                  */
-#if (OS_SEM_EN  > 0)
-            case OS_EVENT_TYPE_SEM:
-                 break;
-#endif
-#if (OS_MBOX_EN > 0)
-            case OS_EVENT_TYPE_MBOX:
-                 break;
-#endif
-#if ((OS_Q_EN   > 0) && (OS_MAX_QS > 0))
-            case OS_EVENT_TYPE_Q:
-                 break;
-#endif
-
-            case OS_EVENT_TYPE_MUTEX:                                            
-            case OS_EVENT_TYPE_FLAG:
-            default:           
-                *perr = OS_ERR_EVENT_TYPE;
-                 return (0);
-        }
-        pevents++;
-        pevent = *pevents;
-    }
-
-    if (OSIntNesting  > 0) {                            /* See if called from ISR ...                  */
-       *perr =  OS_ERR_PEND_ISR;                        /* ... can't PEND from an ISR                  */
-        return (0);
-    }
-    if (OSLockNesting > 0) {                            /* See if called with scheduler locked ...     */
-       *perr =  OS_ERR_PEND_LOCKED;                     /* ... can't PEND when locked                  */
-        return (0);
-    }
-
-/*$PAGE*/
-    OS_ENTER_CRITICAL();
-    events_rdy     =  OS_FALSE;
-    events_rdy_nbr =  0;
-    events_stat    =  OS_STAT_RDY;
-    pevents        =  pevents_pend;
-    pevent         = *pevents;
-    while (pevent != (OS_EVENT *)0) {                   /* See if any events already available         */
-        switch (pevent->OSEventType) {
-#if (OS_SEM_EN > 0)
-            case OS_EVENT_TYPE_SEM:
-                 if (pevent->OSEventCnt > 0) {          /* If semaphore count > 0, resource available; */
-                     pevent->OSEventCnt--;              /* ... decrement semaphore,                ... */
-                    *pevents_rdy++ =  pevent;           /* ... and return available semaphore event    */
-                      events_rdy   =  OS_TRUE;
-                    *pmsgs_rdy++   = (void *)0;         /* NO message returned  for semaphores         */
-                      events_rdy_nbr++;
-
-                 } else {
-                      events_stat |=  OS_STAT_SEM;      /* Configure multi-pend for semaphore events   */
-                 }
-                 break;
-#endif
-
-#if (OS_MBOX_EN > 0)
-            case OS_EVENT_TYPE_MBOX:
-                 if (pevent->OSEventPtr != (void *)0) { /* If mailbox NOT empty;                   ... */
-                                                        /* ... return available message,           ... */
-                    *pmsgs_rdy++         = (void *)pevent->OSEventPtr;
-                     pevent->OSEventPtr  = (void *)0;
-                    *pevents_rdy++       =  pevent;     /* ... and return available mailbox event      */
-                      events_rdy         =  OS_TRUE;
-                      events_rdy_nbr++;
-
-                 } else {
-                      events_stat |= OS_STAT_MBOX;      /* Configure multi-pend for mailbox events     */
-                 }
-                 break;
-#endif
-
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
-            case OS_EVENT_TYPE_Q:
-                 pq = (OS_Q *)pevent->OSEventPtr;
-                 if (pq->OSQEntries > 0) {              /* If queue NOT empty;                     ... */
-                                                        /* ... return available message,           ... */
-                    *pmsgs_rdy++ = (void *)*pq->OSQOut++;
-                     if (pq->OSQOut == pq->OSQEnd) {    /* If OUT ptr at queue end, ...                */
-                         pq->OSQOut  = pq->OSQStart;    /* ... wrap   to queue start                   */
-                     }
-                     pq->OSQEntries--;                  /* Update number of queue entries              */
-                    *pevents_rdy++ = pevent;            /* ... and return available queue event        */
-                      events_rdy   = OS_TRUE;
-                      events_rdy_nbr++;
-
-                 } else {
-                      events_stat |= OS_STAT_Q;         /* Configure multi-pend for queue events       */
-                 }
-                 break;
+    return (OS_EventPendMulti(pevents_pend, pevents_rdy, pmsgs_rdy, 0L, 0, timeout, perr));
+}
 #endif
 
-            case OS_EVENT_TYPE_MUTEX:                                            
-            case OS_EVENT_TYPE_FLAG:
-            default:           
-                 OS_EXIT_CRITICAL();
-                *pevents_rdy = (OS_EVENT *)0;           /* NULL terminate return event array           */
-                *perr        =  OS_ERR_EVENT_TYPE;
-                 return (events_rdy_nbr);
-        }
-        pevents++;
-        pevent = *pevents;
-    }
-
-    if ( events_rdy == OS_TRUE) {                       /* Return any events already available         */
-       *pevents_rdy = (OS_EVENT *)0;                    /* NULL terminate return event array           */
-        OS_EXIT_CRITICAL();
-       *perr        =  OS_ERR_NONE;
-        return (events_rdy_nbr);
-    }
 /*$PAGE*/
-                                                        /* Otherwise, must wait until any event occurs */
-    OSTCBCur->OSTCBStat     |= events_stat  |           /* Resource not available, ...                 */
-                               OS_STAT_MULTI;           /* ... pend on multiple events                 */
-    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;                 /* Store pend timeout in TCB                   */
-    OS_EventTaskWaitMulti(pevents_pend);                /* Suspend task until events or timeout occurs */
-
-    OS_EXIT_CRITICAL();
-    OS_Sched();                                         /* Find next highest priority task ready       */
-    OS_ENTER_CRITICAL();
-
-    switch (OSTCBCur->OSTCBStatPend) {                  /* Handle event posted, aborted, or timed-out  */
-        case OS_STAT_PEND_OK:
-        case OS_STAT_PEND_ABORT:
-             pevent = OSTCBCur->OSTCBEventPtr;
-             if (pevent != (OS_EVENT *)0) {             /* If task event ptr != NULL, ...              */
-                *pevents_rdy++ =  pevent;               /* ... return available event ...              */
-                *pevents_rdy   = (OS_EVENT *)0;         /* ... & NULL terminate return event array     */
-                  events_rdy_nbr++;
-
-             } else {                                   /* Else NO event available, handle as timeout  */
-                 OSTCBCur->OSTCBStatPend = OS_STAT_PEND_TO;
-                 OS_EventTaskRemoveMulti(OSTCBCur, pevents_pend);
-             }
-			 break;
-
-        case OS_STAT_PEND_TO:
-        default:                                        /* ... remove task from events' wait lists     */
-             OS_EventTaskRemoveMulti(OSTCBCur, pevents_pend);
-             break;
-    }
-
-    switch (OSTCBCur->OSTCBStatPend) {
-        case OS_STAT_PEND_OK:
-             switch (pevent->OSEventType) {             /* Return event's message                      */
-#if (OS_SEM_EN > 0)
-                 case OS_EVENT_TYPE_SEM:
-                     *pmsgs_rdy++ = (void *)0;          /* NO message returned for semaphores          */
-                      break;
-#endif
-
-#if ((OS_MBOX_EN > 0) ||                 \
-    ((OS_Q_EN    > 0) && (OS_MAX_QS > 0)))
-                 case OS_EVENT_TYPE_MBOX:
-                 case OS_EVENT_TYPE_Q:
-                     *pmsgs_rdy++ = (void *)OSTCBCur->OSTCBMsg;     /* Return received message         */
-                      break;
-#endif
-
-                 case OS_EVENT_TYPE_MUTEX:                                       
-                 case OS_EVENT_TYPE_FLAG:
-                 default:           
-                      OS_EXIT_CRITICAL();
-                     *pevents_rdy = (OS_EVENT *)0;      /* NULL terminate return event array           */
-                     *perr        =  OS_ERR_EVENT_TYPE;
-                      return (events_rdy_nbr);
-             }
-            *perr = OS_ERR_NONE;
-             break;
-
-        case OS_STAT_PEND_ABORT:
-            *pmsgs_rdy++ = (void *)0;                   /* NO message returned for abort               */
-            *perr        =  OS_ERR_PEND_ABORT;          /* Indicate that event  aborted                */
-             break;
-                                                        
-        case OS_STAT_PEND_TO:                                                
-        default:        
-            *pmsgs_rdy++ = (void *)0;                   /* NO message returned for timeout             */
-            *perr        =  OS_ERR_TIMEOUT;             /* Indicate that events timed out              */
-             break;
-    }
-
-    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;        /* Set   task  status to ready                 */
-    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;    /* Clear pend  status                          */
-    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;      /* Clear event pointers                        */
-    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
-    OSTCBCur->OSTCBMsg           = (void      *)0;      /* Clear task  message                         */
-    OS_EXIT_CRITICAL();
+/*
+*********************************************************************************************************
+*                          PEND ON MULTIPLE EVENTS, INCLUDING AN EVENT FLAG GROUP
+*
+* Description: This function waits for multiple events, as OSEventPendMulti() does, one of which may be an
+*              event flag group (passed as '(OS_EVENT *)pgrp' in 'pevents_pend').
+*
+* Arguments  : pevents_pend  is a pointer to a NULL-terminated array of event control blocks to wait for,
+*                            with at most one event flag group.
+*
+*              pevents_rdy   is a pointer to an array to return which events are available or ready (see
+*                            OSEventPendMulti()).
+*
+*              pmsgs_rdy     is a pointer to an array to return messages (see OSEventPendMulti()).  The
+*                            entry of the event flag group is a NULL message: call OSFlagPendGetFlagsRdy()
+*                            to get the flags that made the group ready.
+*
+*              flags         is a bit pattern indicating which bit(s) (i.e. flags) of the group to wait on.
+*
+*              wait_type     specifies whether you want ALL bits to be set or ANY of the bits to be set, as
+*                            with OSFlagPend():
+*
+*                            OS_FLAG_WAIT_CLR_ALL   You will wait for ALL bits in 'flags' to be clear (0)
+*                            OS_FLAG_WAIT_SET_ALL   You will wait for ALL bits in 'flags' to be set   (1)
+*                            OS_FLAG_WAIT_CLR_ANY   You will wait for ANY bit  in 'flags' to be clear (0)
+*                            OS_FLAG_WAIT_SET_ANY   You will wait for ANY bit  in 'flags' to be set   (1)
+*
+*                            You can add OS_FLAG_CONSUME if you want the event flag(s) to be 'consumed' by
+*                            the call.
+*
+*              timeout       is an optional timeout period (in clock ticks), 0 to wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited: the same error codes
+*                            as OSEventPendMulti() and
+*
+*                            OS_ERR_FLAG_WAIT_TYPE  You didn't specify a proper 'wait_type' argument.
+*                            OS_ERR_EVENT_TYPE      Also if 'pevents_pend' holds more than one event flag
+*                                                   group or if 'flags' is 0.
+*
+* Returns    : >  0          the number of events returned as ready or aborted.
+*              == 0          if no events are returned as ready because of timeout or upon error.
+*
+* Notes      : 1) A task has room for one event flag node (OSTCBFlagNode) and one set of ready flags
+*                 (OSTCBFlagsRdy), which is why a single group may be waited on.
+*********************************************************************************************************
+*/
 
-    return (events_rdy_nbr);
+#if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0)) && (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+INT16U  OSEventPendMultiExt (OS_EVENT  **pevents_pend,
+                             OS_EVENT  **pevents_rdy,
+                             void      **pmsgs_rdy,
+                             OS_FLAGS    flags,
+                             INT8U       wait_type,
+                             INT16U      timeout,
+                             INT8U      *perr)
+{
+    return (OS_EventPendMulti(pevents_pend, pevents_rdy, pmsgs_rdy, (INT32U)flags, wait_type, timeout, perr));
 }
 #endif
 
@@ -582,6 +457,10 @@ void  OSInit (void)
     OS_QInit();                                                  /* Initialize the message queue structures  */
 #endif
 
+#if OS_SLOTQ_EN > 0
+    OS_SlotQInit();                                              /* Initialize the slot queue structures     */
+#endif
+
     OS_InitTaskIdle();                                           /* Create the Idle Task                     */
 #if OS_TASK_STAT_EN > 0
     OS_InitTaskStat();                                           /* Create the Statistic Task                */
@@ -632,6 +511,11 @@ void  OSIntEnter (void)
         if (OSIntNesting < 255u) {
             OSIntNesting++;                      /* Increment ISR nesting level                        */
         }
+#if OS_PROFILE_EN > 0
+        if (OSIntNesting == 1) {                 /* Stop charging the interrupted task                 */
+            OS_ProfileIntEnter();
+        }
+#endif
         OS_EXIT_CRITICAL();
     }
 }
@@ -669,17 +553,31 @@ void  OSIntExit (void)
             OSIntNesting--;
         }
         if (OSIntNesting == 0) {                           /* Reschedule only if all ISRs complete ... */
+#if OS_PROFILE_EN > 0
+            OS_ProfileIntExit();                           /* Resume charging the interrupted task     */
+#endif
             if (OSLockNesting == 0) {                      /* ... and not locked.                      */
                 OS_SchedNew();
-
+                OSTCBHighRdy = OS_TCB_HIGH_RDY();
+#if OS_SCHED_RR_EN > 0
+                if (OSTCBHighRdy != OSTCBCur) {            /* Tasks may share the highest priority     */
+#else
                 if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy */
-						char tempBuf[MSG_BUF_SIZE];
-						sprintf(tempBuf, "%5d Preempt     %3d      %3d\n",
-								(int)OSTimeGet(), (int)OSPrioCur, (int)OSPrioHighRdy);
-						AddMessageToQueue(tempBuf);
-                    OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
+#if OS_TRACE_EN > 0
+                    OS_TraceRec(OS_TRACE_EVT_PREEMPT, OSPrioCur, OSPrioHighRdy);
+#endif
+#if OS_DLY_LIST_EN > 0
+                    OS_DlySw();                            /* Update delay list for tasks switched     */
+#endif
 #if OS_TASK_PROFILE_EN > 0
                     OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task  */
+#endif
+#if OS_PROFILE_EN > 0
+                    OS_ProfileSw(OS_CPU_CYCLES_GET());     /* Charge the task switched out             */
+#endif
+#if OS_STK_WM_EN > 0
+                    OS_StkWmSw();                          /* Check stack of the task switched in      */
 #endif
                     OSCtxSwCtr++;                          /* Keep track of the number of ctx switches */
                     OSIntCtxSw();                          /* Perform interrupt level ctx switch       */
@@ -689,17 +587,6 @@ void  OSIntExit (void)
 
         OS_EXIT_CRITICAL();
     }
-//    sprintf(MsgBuffer,"OSIntExit: OSPrioCur=%3d, OSPrioHighRdy=%3d, Task %d Status: %d\n",
-//    		OSPrioCur, OSPrioHighRdy, 6, OSTCBPrioTbl[6]->OSTCBStat);
-//    sprintf(MsgBuffer,"Task 6 Status: %d, Dly: %d\n",
-//           OSTCBPrioTbl[6]->OSTCBStat,
-//           OSTCBPrioTbl[6]->OSTCBDly);
-//	if (OSPrioHighRdy != OSPrioCur) {
-//			  sprintf(MsgBuffer, "%5d Preempt     %3d      %3d\n",
-//					  (int)OSTimeGet(), (int)OSPrioCur, (int)OSPrioHighRdy);
-//			  MsgReady = 1;
-//		  }
-
 }
 /*$PAGE*/
 /*
@@ -811,8 +698,11 @@ void  OSStart (void)
     if (OSRunning == OS_FALSE) {
         OS_SchedNew();                               /* Find highest priority's task priority number   */
         OSPrioCur     = OSPrioHighRdy;
-        OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy]; /* Point to highest priority task ready to run    */
+        OSTCBHighRdy  = OS_TCB_HIGH_RDY();           /* Point to highest priority task ready to run    */
         OSTCBCur      = OSTCBHighRdy;
+#if OS_PROFILE_EN > 0
+        OSProfileReset();                            /* Start profiling with the first task            */
+#endif
         OSStartHighRdy();                            /* Execute target specific code to start task     */
     }
 }
@@ -834,6 +724,9 @@ void  OSStart (void)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) With OS_STAT_LOAD_EN set to 1, the CPU usage is computed from the measured run time of the
+*                 idle task (see OS_LoadUpdate()) and no calibration is needed: this function returns at once.
 *********************************************************************************************************
 */
 
@@ -846,6 +739,11 @@ void  OSStatInit (void)
 
 
 
+#if OS_STAT_LOAD_EN > 0
+    OS_ENTER_CRITICAL();
+    OSStatRdy    = OS_TRUE;
+    OS_EXIT_CRITICAL();
+#else
     OSTimeDly(2);                                /* Synchronize with clock tick                        */
     OS_ENTER_CRITICAL();
     OSIdleCtr    = 0L;                           /* Clear idle counter                                 */
@@ -855,6 +753,7 @@ void  OSStatInit (void)
     OSIdleCtrMax = OSIdleCtr;                    /* Store maximum idle counter count in 1/10 second    */
     OSStatRdy    = OS_TRUE;
     OS_EXIT_CRITICAL();
+#endif
 }
 #endif
 /*$PAGE*/
@@ -869,19 +768,28 @@ void  OSStatInit (void)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) With OS_DLY_LIST_EN set to 1, only the delayed tasks that expire on this tick are visited
+*                 (see OS_DlyLink()).  Otherwise every TCB in OSTCBList is visited.
 *********************************************************************************************************
 */
 
 void  OSTimeTick (void)
 {
-    OS_TCB    *ptcb;
+    OS_TCB        *ptcb;
 #if OS_TICK_STEP_EN > 0
-    BOOLEAN    step;
+    BOOLEAN        step;
+#endif
+#if OS_PROFILE_EN > 0
+    OS_CPU_CYCLES  ts;
 #endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
-    OS_CPU_SR  cpu_sr = 0;
+    OS_CPU_SR      cpu_sr = 0;
 #endif
 
+#if OS_PROFILE_EN > 0
+    ts = OS_CPU_CYCLES_GET();                              /* Time the tick processing                     */
+#endif
 #if OS_TIME_TICK_HOOK_EN > 0
     OSTimeTickHook();                                      /* Call user definable hook                     */
 #endif
@@ -915,50 +823,51 @@ void  OSTimeTick (void)
             return;
         }
 #endif
+#if OS_DLY_LIST_EN > 0
+        OS_ENTER_CRITICAL();
+        ptcb = OSTCBCur;
+        if ((ptcb->OSTCBDly != 0) && (ptcb->OSTCBDlyLinked == OS_FALSE)) {
+            OS_DlyLink(ptcb);                              /* Task blocked but was not switched out yet    */
+        }
+        ptcb = OSTCBDlyList;                               /* Only the head of the delay list counts down  */
+        if (ptcb != (OS_TCB *)0) {
+            ptcb->OSTCBDlyDelta--;
+        }
+        while ((ptcb != (OS_TCB *)0) && (ptcb->OSTCBDlyDelta == 0)) {  /* Process all expired TCBs     */
+            OS_DlyUnlink(ptcb);
+            if (ptcb->OSTCBDly != 0) {                     /* Skip tasks already made ready elsewhere      */
+                ptcb->OSTCBDly = 0;
+                OS_TimeTickRdy(ptcb);
+            }
+            OS_EXIT_CRITICAL();                            /* Let interrupts in between expirations        */
+            OS_ENTER_CRITICAL();
+            ptcb = OSTCBDlyList;
+        }
+        OS_EXIT_CRITICAL();
+#else
         ptcb = OSTCBList;                                  /* Point at first TCB in TCB list               */
         while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {     /* Go through all TCBs in TCB list              */
             OS_ENTER_CRITICAL();
             if (ptcb->OSTCBDly != 0) {                     /* No, Delayed or waiting for event with TO     */
 
                 if (--ptcb->OSTCBDly == 0) {               /* Decrement nbr of ticks to end of delay       */
-                                                           /* Check for timeout                            */
-
-                    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
-                        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;          /* Yes, Clear status flag   */
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                 /* Indicate PEND timeout    */
-                    } else {
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
-                    }
-
-                    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?       */
-                        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready          */
-                        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
-                    }
-
+                    OS_TimeTickRdy(ptcb);                  /* Check for timeout                            */
                 }
             }
-            // 只檢查優先級為 6, 7, 8 的任務
-			if (ptcb->OSTCBPrio >= 6 && ptcb->OSTCBPrio <= 8) {
-				// 如果當前時間超過了截止期且任務不在就緒列表中
-				if (OSTime >= ptcb->deadline && OSTime>=9) {
-					ptcb->deadline = ptcb->deadline+(INT32U)ptcb->period;
-					char tempBuf[MSG_BUF_SIZE];
-					sprintf(tempBuf, "time:%5d Task%d exceed deadline\n",
-						   (int)OSTime, (int)ptcb->OSTCBPrio);
-					AddMessageToQueue(tempBuf);
-
-				}
-			}
             ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
             OS_EXIT_CRITICAL();
         }
-//        sprintf(MsgBuffer,"OSIntExit: OSPrioCur=%3d, OSPrioHighRdy=%3d, Task %d Dly: %d\n"
-//						,OSPrioCur, OSPrioHighRdy, 6, OSTCBPrioTbl[6]->OSTCBDly);
-
+#endif
+#if OS_DEADLINE_EN > 0
+        OS_ENTER_CRITICAL();
+        OS_DeadlineChk();                                  /* Look for missed deadlines                    */
+        OS_EXIT_CRITICAL();
+#endif
         OS_ENTER_CRITICAL();
-		if (OSTCBCur->compTime > 0) {
-			OSTCBCur->compTime--;
-		}
+        OS_TimeTickCharge();                               /* Charge the tick to the running task          */
+#if OS_PROFILE_EN > 0
+        OSProfileTickCycles += OS_CPU_CYCLES_GET() - ts;
+#endif
 		OS_EXIT_CRITICAL();
     }
 
@@ -987,84 +896,928 @@ INT16U  OSVersion (void)
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                                            DUMMY FUNCTION
+*                                    INSERT A TASK IN THE DELAY LIST
 *
-* Description: This function doesn't do anything.  It is called by OSTaskDel().
+* Description: This function is called when a task that has a non-zero OSTCBDly is switched out.  The task
+*              is inserted in OSTCBDlyList which is sorted by expiry time.  Each TCB in the list holds the
+*              number of ticks between its expiry and the expiry of the TCB ahead of it (OSTCBDlyDelta) so
+*              that OSTimeTick() only needs to decrement the head of the list.
 *
-* Arguments  : none
+* Arguments  : ptcb     is a pointer to the TCB of the task to insert.
 *
 * Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) Services (e.g. OSTimeDly() or the xxxPend() functions) only set OSTCBDly of the current
+*                 task before calling OS_Sched().  The TCB is linked when the task is switched out or, if a
+*                 tick occurs before that, by OSTimeTick().  OSTCBDly stays non-zero until the delay
+*                 expires so that those services can still tell whether a task is delayed.
 *********************************************************************************************************
 */
 
-#if OS_TASK_DEL_EN > 0
-void  OS_Dummy (void)
+#if OS_DLY_LIST_EN > 0
+static  void  OS_DlyLink (OS_TCB *ptcb)
 {
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+    INT16U   dly;
+
+
+    dly   = ptcb->OSTCBDly;
+    pprev = (OS_TCB *)0;
+    pnext = OSTCBDlyList;
+    while ((pnext != (OS_TCB *)0) && (pnext->OSTCBDlyDelta <= dly)) { /* Find TCB expiring after us    */
+        dly  -= pnext->OSTCBDlyDelta;
+        pprev = pnext;
+        pnext = pnext->OSTCBDlyNext;
+    }
+    ptcb->OSTCBDlyDelta = dly;
+    ptcb->OSTCBDlyPrev  = pprev;
+    ptcb->OSTCBDlyNext  = pnext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBDlyDelta -= dly;                       /* Next TCB now expires relative to us      */
+        pnext->OSTCBDlyPrev   = ptcb;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBDlyNext = ptcb;
+    } else {
+        OSTCBDlyList        = ptcb;
+    }
+    ptcb->OSTCBDlyLinked = OS_TRUE;
 }
-#endif
 
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                             MAKE TASK READY TO RUN BASED ON EVENT OCCURING
-*
-* Description: This function is called by other uC/OS-II services and is used to ready a task that was
-*              waiting for an event to occur.
-*
-* Arguments  : pevent      is a pointer to the event control block corresponding to the event.
-*
-*              pmsg        is a pointer to a message.  This pointer is used by message oriented services
-*                          such as MAILBOXEs and QUEUEs.  The pointer is not used when called by other
-*                          service functions.
-*
-*              msk         is a mask that is used to clear the status byte of the TCB.  For example,
-*                          OSSemPost() will pass OS_STAT_SEM, OSMboxPost() will pass OS_STAT_MBOX etc.
+*                                UPDATE THE DELAY LIST ON A CONTEXT SWITCH
 *
-*              pend_stat   is used to indicate the readied task's pending status:
+* Description: This function is called by OS_Sched() and OSIntExit() just before switching from OSTCBCur
+*              to OSTCBHighRdy.
 *
-*                          OS_STAT_PEND_OK      Task ready due to a post (or delete), not a timeout or
-*                                               an abort.
-*                          OS_STAT_PEND_ABORT   Task ready due to an abort.
+* Arguments  : none
 *
 * Returns    : none
 *
-* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) A task that is switched in is not delayed.  The services that make a delayed task ready
+*                 remove it from the delay list (see OS_DlyUnlink()); any entry still left is removed here.
 *********************************************************************************************************
 */
-#if (OS_EVENT_EN)
-INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
+
+static  void  OS_DlySw (void)
+{
+    if (OSTCBHighRdy->OSTCBDlyLinked == OS_TRUE) {         /* Remove stale entry of task switched in   */
+        OS_DlyUnlink(OSTCBHighRdy);
+    }
+    if ((OSTCBCur->OSTCBDly != 0) && (OSTCBCur->OSTCBDlyLinked == OS_FALSE)) {
+        OS_DlyLink(OSTCBCur);                              /* Task switched out is delayed             */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   GET THE TICKS LEFT IN A TASK'S DELAY
+*
+* Description: This function returns the number of ticks before the delay or timeout of a task expires.
+*              Once the task is in OSTCBDlyList, OSTCBDly keeps the delay the task started with and the ticks
+*              left are the sum of the OSTCBDlyDelta of the TCBs up to the task's.
+*
+* Arguments  : ptcb     is a pointer to the TCB of the task.
+*
+* Returns    : The ticks left, 0 if the task is not delayed.
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+INT16U  OS_DlyGet (OS_TCB *ptcb)
+{
+    OS_TCB  *pscan;
+    INT16U   dly;
+
+
+    if ((ptcb->OSTCBDly == 0) || (ptcb->OSTCBDlyLinked == OS_FALSE)) {
+        return (ptcb->OSTCBDly);                           /* Not in the list yet, OSTCBDly is exact   */
+    }
+    dly   = 0;
+    pscan = OSTCBDlyList;
+    while (pscan != ptcb) {                                /* Add the deltas of the TCBs ahead of us   */
+        dly  += pscan->OSTCBDlyDelta;
+        pscan = pscan->OSTCBDlyNext;
+    }
+    return ((INT16U)(dly + ptcb->OSTCBDlyDelta));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REMOVE A TASK FROM THE DELAY LIST
+*
+* Description: This function removes a task from OSTCBDlyList.  The ticks left for the task are given
+*              to the TCB that follows it so that the expiry of the other tasks is unchanged.
+*
+* Arguments  : ptcb     is a pointer to the TCB of the task to remove.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) It is called by each service that clears OSTCBDly of a task that may be in the list
+*                 (e.g. OSTimeDlyResume(), a post or OSTaskDel()).
+*********************************************************************************************************
+*/
+
+void  OS_DlyUnlink (OS_TCB *ptcb)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    pprev = ptcb->OSTCBDlyPrev;
+    pnext = ptcb->OSTCBDlyNext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBDlyDelta += ptcb->OSTCBDlyDelta;
+        pnext->OSTCBDlyPrev   = pprev;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBDlyNext = pnext;
+    } else {
+        OSTCBDlyList        = pnext;
+    }
+    ptcb->OSTCBDlyNext   = (OS_TCB *)0;
+    ptcb->OSTCBDlyPrev   = (OS_TCB *)0;
+    ptcb->OSTCBDlyLinked = OS_FALSE;
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            DUMMY FUNCTION
+*
+* Description: This function doesn't do anything.  It is called by OSTaskDel().
+*
+* Arguments  : none
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_TASK_DEL_EN > 0
+void  OS_Dummy (void)
+{
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                           CONSUME THE FLAGS THAT MADE A MULTI-PEND READY
+*
+* Description: This function consumes the flags that made an event flag group ready for the current task
+*              (OSTCBFlagsRdy), if OS_FLAG_CONSUME was given, as OSFlagPend() does.
+*
+* Arguments  : pgrp        is a pointer to the event flag group.
+*
+*              wait_type   is the wait type given to OSEventPendMultiExt().
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+#if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0)) && (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+static  void  OS_EventMultiFlagConsume (OS_FLAG_GRP *pgrp, INT8U wait_type)
+{
+    if ((wait_type & OS_FLAG_CONSUME) == 0) {
+        return;
+    }
+    switch (wait_type & ~OS_FLAG_CONSUME) {
+        case OS_FLAG_WAIT_SET_ALL:
+        case OS_FLAG_WAIT_SET_ANY:
+             pgrp->OSFlagFlags &= ~OSTCBCur->OSTCBFlagsRdy;     /* Clear the flags that were set       */
+             break;
+
+#if OS_FLAG_WAIT_CLR_EN > 0
+        case OS_FLAG_WAIT_CLR_ALL:
+        case OS_FLAG_WAIT_CLR_ANY:
+             pgrp->OSFlagFlags |=  OSTCBCur->OSTCBFlagsRdy;     /* Set the flags that were cleared     */
+             break;
+#endif
+
+        default:
+             break;
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                     RAISE THE PRIORITY OF A MUTEX OWNER FOR OSEventPendMulti()
+*
+* Description: This function raises the priority of the owner of a mutex to the mutex's priority
+*              inheritance priority (PIP), as OSMutexPend() does, when the current task is about to wait
+*              on the mutex and has a higher priority than the owner.
+*
+* Arguments  : pevent      is a pointer to the event control block of the (owned) mutex.
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) Unlike OSMutexPend(), the owner may itself wait in OSEventPendMulti(): it is then moved
+*                 to its new priority in the wait list of each of the events it waits on.  This is done
+*                 even when the owner is ready: a task that timed out stays in the wait lists until it
+*                 runs, and a post in the meantime must find it at its new priority.
+*********************************************************************************************************
+*/
+#if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0)) && (OS_MUTEX_EN > 0)
+static  void  OS_EventMultiPIP (OS_EVENT *pevent)
+{
+    OS_TCB       *ptcb;
+    OS_EVENT    **pevents;
+    OS_EVENT     *pevent2;
+    BOOLEAN       rdy;
+    INT8U         prio_old;
+    INT8U         pip;
+    INT8U         mprio;
+
+
+    pip   = (INT8U)(pevent->OSEventCnt >> 8);           /* Get PIP from mutex                          */
+    mprio = (INT8U)(pevent->OSEventCnt & 0x00FF);       /* Get priority of mutex owner                 */
+    ptcb  = (OS_TCB *)(pevent->OSEventPtr);             /* Point to TCB of mutex owner                 */
+    if ((ptcb->OSTCBPrio <= pip) || (mprio <= OSTCBCur->OSTCBPrio)) {
+        return;                                         /* Owner already raised or of higher priority  */
+    }
+    prio_old = ptcb->OSTCBPrio;
+    rdy      = OS_RDY_TST(ptcb);                        /* See if mutex owner is ready                 */
+    if (rdy == OS_TRUE) {
+        OS_RDY_DEL(ptcb);
+    }
+    ptcb->OSTCBPrio = pip;                              /* Change owner task prio to PIP               */
+    ptcb->OSTCBY    = (INT8U)(pip >> OS_PRIO_ROW_SHIFT);
+    ptcb->OSTCBX    = (INT8U)(pip &  OS_PRIO_ROW_MSK);
+    ptcb->OSTCBBitY = OS_PRIO_BIT_Y(ptcb->OSTCBY);
+    ptcb->OSTCBBitX = OS_PRIO_BIT_X(ptcb->OSTCBX);
+    if (rdy == OS_TRUE) {                               /* Yes, make it ready at new priority          */
+        OS_RDY_INS(ptcb);
+    }
+    pevent2 = ptcb->OSTCBEventPtr;                      /* Move owner in the wait lists, see Note #3   */
+    if (pevent2 != (OS_EVENT *)0) {
+        OS_EventTaskMove(ptcb, pevent2, prio_old);
+    }
+    pevents = ptcb->OSTCBEventMultiPtr;
+    if (pevents != (OS_EVENT **)0) {
+        while (*pevents != (OS_EVENT *)0) {
+            OS_EventTaskMove(ptcb, *pevents, prio_old);
+            pevents++;
+        }
+    }
+    OSTCBPrioTbl[pip] = ptcb;
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                           TAKE AN AVAILABLE EVENT FOR OSEventPendMulti()
+*
+* Description: This function takes a semaphore unit, a message or a mutex from an event, or the flags of
+*              an event flag group, if available.
+*
+* Arguments  : pevent      is a pointer to the event control block (or to the event flag group).
+*
+*              pmsg        is a pointer to where the message is deposited (NULL for other events).
+*
+*              flags       are the flags to wait on if 'pevent' is an event flag group.
+*
+*              wait_type   is the wait type of the flags (see OSEventPendMultiExt()).
+*
+* Returns    : OS_TRUE     if the event was available and was taken.
+*              OS_FALSE    if not.
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) A mutex is taken by making the current task its owner.  The flags of an event flag group
+*                 are left in OSTCBFlagsRdy.
+*********************************************************************************************************
+*/
+#if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
+static  BOOLEAN  OS_EventMultiTake (OS_EVENT *pevent, void **pmsg, INT32U flags, INT8U wait_type)
+{
+#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
+    OS_Q         *pq;
+#endif
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    OS_FLAG_GRP  *pgrp;
+    OS_FLAGS      flags_rdy;
+#endif
+
+
+   *pmsg = (void *)0;                                   /* NO message returned for other events        */
+    switch (pevent->OSEventType) {
+#if (OS_SEM_EN > 0)
+        case OS_EVENT_TYPE_SEM:
+             if (pevent->OSEventCnt > 0) {              /* If semaphore count > 0, resource available; */
+                 pevent->OSEventCnt--;                  /* ... decrement semaphore                     */
+                 return (OS_TRUE);
+             }
+             break;
+#endif
+
+#if (OS_MBOX_EN > 0)
+        case OS_EVENT_TYPE_MBOX:
+             if (pevent->OSEventPtr != (void *)0) {     /* If mailbox NOT empty, return message        */
+                *pmsg               = (void *)pevent->OSEventPtr;
+                 pevent->OSEventPtr = (void *)0;
+                 return (OS_TRUE);
+             }
+             break;
+#endif
+
+#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
+        case OS_EVENT_TYPE_Q:
+             pq = (OS_Q *)pevent->OSEventPtr;
+             if (pq->OSQEntries > 0) {                  /* If queue NOT empty, return message          */
+                *pmsg = (void *)*pq->OSQOut++;
+                 if (pq->OSQOut == pq->OSQEnd) {        /* If OUT ptr at queue end, ...                */
+                     pq->OSQOut  = pq->OSQStart;        /* ... wrap   to queue start                   */
+                 }
+                 pq->OSQEntries--;                      /* Update number of queue entries              */
+                 return (OS_TRUE);
+             }
+             break;
+#endif
+
+#if (OS_MUTEX_EN > 0)
+        case OS_EVENT_TYPE_MUTEX:
+             if ((pevent->OSEventCnt & 0x00FF) == 0x00FF) {   /* If mutex available, ...               */
+                 pevent->OSEventCnt &= 0xFF00;                /* ... keep PIP and ...                  */
+                 pevent->OSEventCnt |= OSTCBCur->OSTCBPrio;   /* ... save priority of owning task      */
+                 pevent->OSEventPtr  = (void *)OSTCBCur;      /* Point to owning task's OS_TCB         */
+                 return (OS_TRUE);
+             }
+             break;
+#endif
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+        case OS_EVENT_TYPE_FLAG:
+             pgrp = (OS_FLAG_GRP *)pevent;
+             switch (wait_type & ~OS_FLAG_CONSUME) {
+                 case OS_FLAG_WAIT_SET_ALL:
+                 case OS_FLAG_WAIT_SET_ANY:
+                      flags_rdy = (OS_FLAGS)(pgrp->OSFlagFlags & (OS_FLAGS)flags);
+                      break;
+
+#if OS_FLAG_WAIT_CLR_EN > 0
+                 case OS_FLAG_WAIT_CLR_ALL:
+                 case OS_FLAG_WAIT_CLR_ANY:
+                      flags_rdy = (OS_FLAGS)(~pgrp->OSFlagFlags & (OS_FLAGS)flags);
+                      break;
+#endif
+
+                 default:
+                      flags_rdy = (OS_FLAGS)0;
+                      break;
+             }
+             if ((wait_type & ~OS_FLAG_CONSUME) == OS_FLAG_WAIT_SET_ALL ||
+                 (wait_type & ~OS_FLAG_CONSUME) == OS_FLAG_WAIT_CLR_ALL) {
+                 if (flags_rdy != (OS_FLAGS)flags) {    /* Must match ALL the bits that we want        */
+                     break;
+                 }
+             } else if (flags_rdy == (OS_FLAGS)0) {     /* Must match ANY of the bits that we want     */
+                 break;
+             }
+             OSTCBCur->OSTCBFlagsRdy = flags_rdy;
+             OS_EventMultiFlagConsume(pgrp, wait_type);
+             return (OS_TRUE);
+#endif
+
+        default:
+             break;
+    }
+    return (OS_FALSE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              UNLINK A MULTI-PEND NODE FROM ITS EVENT
+*
+* Description: This function removes a node from the list of nodes of its event.
+*
+* Arguments  : pnode       is a pointer to the node.
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+#if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
+static  void  OS_EventNodeUnlink (OS_EVENT_NODE *pnode)
+{
+    if (pnode->OSEventNodePrev == (OS_EVENT_NODE *)0) { /* Was node at the head of the list?           */
+        pnode->OSEventNodeEvent->OSEventNodeList    = pnode->OSEventNodeNext;
+    } else {
+        pnode->OSEventNodePrev->OSEventNodeNext     = pnode->OSEventNodeNext;
+    }
+    if (pnode->OSEventNodeNext != (OS_EVENT_NODE *)0) {
+        pnode->OSEventNodeNext->OSEventNodePrev     = pnode->OSEventNodePrev;
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      PEND ON MULTIPLE EVENTS
+*
+* Description: This function does the work of OSEventPendMulti() and OSEventPendMultiExt().
+*
+* Arguments  : pevents_pend  is a pointer to a NULL-terminated array of event control blocks to wait for.
+*
+*              pevents_rdy   is a pointer to an array to return which events are available or ready.
+*
+*              pmsgs_rdy     is a pointer to an array to return messages.
+*
+*              flags         are the flags to wait on if 'pevents_pend' holds an event flag group, else 0.
+*
+*              wait_type     is the wait type of the flags.
+*
+*              timeout       is an optional timeout period (in clock ticks), 0 to wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited (see
+*                            OSEventPendMulti() and OSEventPendMultiExt()).
+*
+* Returns    : The number of events returned as ready or aborted.
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*
+*              2) a. Validate 'pevents_pend' array as valid OS_EVENTs : 
+*
+*                        semaphores, mailboxes, queues, mutexes and at most one event flag group
+*
+*                 b. Return ALL available events and messages, if any
+*
+*                 c. Link a node (OS_EVENT_NODE) of the task to each event and add the task priority
+*                    as pending to each event's wait list, from the last event to the first.  The
+*                    event flag group gets an event flag node (OS_FLAG_NODE) instead
+*
+*                 d. Wait on any of multiple events
+*
+*                 e. Unlink the nodes and remove the task priority from each event's wait list, from the
+*                    first event to the last
+*
+*                 f. Return the event posted or aborted that readied the task, if any
+*                      else
+*                    Return timeout
+*
+*              3) 'pevents_rdy' initialized to NULL PRIOR to all other validation or function handling in 
+*                 case of any error(s).
+*
+*              4) Each event is checked and linked in a critical section of its own, so that interrupts
+*                 are never disabled for a time that depends on the number of events.  A post or an
+*                 abort readies the task in OS_EventTaskRdy(), which marks the task's node, and
+*                 OS_EventMultiRdy() then removes the task from the wait lists of all its other events.
+*                 A post or an abort sets the task's OSTCBStatPend, which is OS_STAT_PEND_TO while the
+*                 nodes are linked: the task stops linking nodes once readied, and only waits if it is
+*                 still OS_STAT_PEND_TO once all the nodes are linked.
+*
+*              5) Only the event that readied the task is returned: the other events keep their
+*                 semaphore units, messages and mutexes for other tasks.  After a timeout, the nodes
+*                 stay linked until the task runs and unlinks them, one per critical section: an event
+*                 posted meanwhile readies the task again and is returned instead of the timeout.
+*
+*              6) OSTCBEventMultiPtr always points to the events the task is in the wait lists of (the
+*                 events of the linked nodes), which is what OSTaskChangePrio() and OSTaskDel() expect,
+*                 or is NULL once the task is readied by an event.  An event flag group has no wait
+*                 list, so this NULL-terminated list of events is built at the end of 'pevents_rdy'
+*                 rather than taken from 'pevents_pend'.  The event returned is stored at the start of
+*                 'pevents_rdy' and never reaches the list, which shrinks by one event per node
+*                 unlinked after a timeout.
+*
+*              7) A task waiting on an event flag group only has OS_STAT_FLAG set in OSTCBStat, because
+*                 OSFlagPost() readies a task only once no other OS_STAT_??? bit is set.
+*
+*              8) The owner of a mutex the task waits on inherits the mutex's PIP as in OSMutexPend().  A
+*                 mutex posted to the task by OSMutexPost() is owned by the task.
+*********************************************************************************************************
+*/
+#if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
+static  INT16U  OS_EventPendMulti (OS_EVENT  **pevents_pend,
+                                   OS_EVENT  **pevents_rdy,
+                                   void      **pmsgs_rdy,
+                                   INT32U      flags,
+                                   INT8U       wait_type,
+                                   INT16U      timeout,
+                                   INT8U      *perr)
+{
+    OS_EVENT       **pevents;
+    OS_EVENT       **pevents_wait;
+    OS_EVENT        *pevent;
+    OS_EVENT_NODE   *pnode;
+    BOOLEAN          aborted;
+    INT16U           events_nbr;
+    INT16U           events_rdy_nbr;
+    INT8U            events_stat;
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    OS_FLAG_GRP     *pgrp;
+    OS_FLAG_NODE     node_flag;
+    OS_FLAG_NODE    *pnode_flag;
+#endif
+#if (OS_CRITICAL_METHOD == 3)                           /* Allocate storage for CPU status register    */
+    OS_CPU_SR        cpu_sr = 0;
+#endif
+
+
+
+#if (OS_ARG_CHK_EN > 0)
+    if (perr == (INT8U *)0) {                           /* Validate 'perr'                             */
+        return (0);
+    }
+    if (pevents_pend == (OS_EVENT **)0) {               /* Validate 'pevents_pend'                     */
+       *perr =  OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pevents_rdy  == (OS_EVENT **)0) {               /* Validate 'pevents_rdy'                      */
+       *perr =  OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs_rdy == (void **)0) {                      /* Validate 'pmsgs_rdy'                        */
+       *perr =  OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+#endif
+
+   *pevents_rdy = (OS_EVENT *)0;                        /* Init array to NULL in case of errors        */
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    pgrp        = (OS_FLAG_GRP *)0;
+#endif
+    events_nbr  =  0;
+    events_stat =  OS_STAT_MULTI;
+    pevents     =  pevents_pend;
+    pevent      = *pevents;
+    while  (pevent != (OS_EVENT *)0) {
+        switch (pevent->OSEventType) {                  /* Validate event block types                  */
+#if (OS_SEM_EN  > 0)
+            case OS_EVENT_TYPE_SEM:
+                 events_stat |= OS_STAT_SEM;            /* Configure multi-pend for semaphore events   */
+                 break;
+#endif
+#if (OS_MBOX_EN > 0)
+            case OS_EVENT_TYPE_MBOX:
+                 events_stat |= OS_STAT_MBOX;           /* Configure multi-pend for mailbox events     */
+                 break;
+#endif
+#if ((OS_Q_EN   > 0) && (OS_MAX_QS > 0))
+            case OS_EVENT_TYPE_Q:
+                 events_stat |= OS_STAT_Q;              /* Configure multi-pend for queue events       */
+                 break;
+#endif
+#if (OS_MUTEX_EN > 0)
+            case OS_EVENT_TYPE_MUTEX:
+                 events_stat |= OS_STAT_MUTEX;          /* Configure multi-pend for mutex events       */
+                 break;
+#endif
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+            case OS_EVENT_TYPE_FLAG:
+                 if ((flags == 0) || (pgrp != (OS_FLAG_GRP *)0)) {
+                    *perr = OS_ERR_EVENT_TYPE;          /* No flags to wait on or second flag group    */
+                     return (0);
+                 }
+                 pgrp = (OS_FLAG_GRP *)pevent;
+                 break;
+#endif
+
+            default:           
+                *perr = OS_ERR_EVENT_TYPE;
+                 return (0);
+        }
+        events_nbr++;
+        pevents++;
+        pevent = *pevents;
+    }
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    if (pgrp != (OS_FLAG_GRP *)0) {
+        switch (wait_type & ~OS_FLAG_CONSUME) {         /* Validate wait type                          */
+            case OS_FLAG_WAIT_SET_ALL:
+            case OS_FLAG_WAIT_SET_ANY:
+#if OS_FLAG_WAIT_CLR_EN > 0
+            case OS_FLAG_WAIT_CLR_ALL:
+            case OS_FLAG_WAIT_CLR_ANY:
+#endif
+                 break;
+
+            default:
+                *perr = OS_ERR_FLAG_WAIT_TYPE;
+                 return (0);
+        }
+        events_stat = OS_STAT_FLAG;                     /* See Note #7                                 */
+    }
+#endif
+
+    if (OSIntNesting  > 0) {                            /* See if called from ISR ...                  */
+       *perr =  OS_ERR_PEND_ISR;                        /* ... can't PEND from an ISR                  */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                            /* See if called with scheduler locked ...     */
+       *perr =  OS_ERR_PEND_LOCKED;                     /* ... can't PEND when locked                  */
+        return (0);
+    }
+
+/*$PAGE*/
+    events_rdy_nbr = 0;
+    pevents        = pevents_pend;
+    while (*pevents != (OS_EVENT *)0) {                 /* See if any events already available         */
+        OS_ENTER_CRITICAL();
+        if (OS_EventMultiTake(*pevents, &pmsgs_rdy[events_rdy_nbr], flags, wait_type) == OS_TRUE) {
+            pevents_rdy[events_rdy_nbr] = *pevents;
+            events_rdy_nbr++;
+        }
+        OS_EXIT_CRITICAL();
+        pevents++;
+    }
+    if (events_rdy_nbr > 0) {                           /* Return any events already available         */
+        pevents_rdy[events_rdy_nbr] = (OS_EVENT *)0;    /* NULL terminate return event array           */
+       *perr                        =  OS_ERR_NONE;
+        return (events_rdy_nbr);
+    }
+
+   *perr         =  OS_ERR_NONE;
+    pevents_wait = &pevents_rdy[events_nbr];            /* Events waited on, see Note #6               */
+   *pevents_wait = (OS_EVENT *)0;
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    pnode_flag   = (OS_FLAG_NODE *)0;
+#endif
+    OS_ENTER_CRITICAL();
+    OSTCBCur->OSTCBStatPend = OS_STAT_PEND_TO;          /* Changed by the first post or abort          */
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    OSTCBCur->OSTCBFlagsRdy = (OS_FLAGS)0;              /* Set by OSFlagPost()                         */
+#endif
+    OS_EXIT_CRITICAL();
+    pevents = &pevents_pend[events_nbr];
+    while (pevents != pevents_pend) {                   /* Link a node to each event, last one first   */
+        pevents--;
+        pevent = *pevents;
+        OS_ENTER_CRITICAL();
+        if (OSTCBCur->OSTCBStatPend != OS_STAT_PEND_TO) {
+            OS_EXIT_CRITICAL();                         /* Already readied by an event, see Note #4    */
+            break;
+        }
+        if (OS_EventMultiTake(pevent, &pmsgs_rdy[0], flags, wait_type) == OS_TRUE) {
+            OS_EXIT_CRITICAL();                         /* Became available: do not wait               */
+            pevents_rdy[0] = pevent;
+            events_rdy_nbr = 1;
+            break;
+        }
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+        if (pevent == (OS_EVENT *)pgrp) {               /* Link event flag node to the group           */
+            node_flag.OSFlagNodeTCB      = (void *)OSTCBCur;
+            node_flag.OSFlagNodeFlagGrp  = (void *)pgrp;
+            node_flag.OSFlagNodeFlags    = (OS_FLAGS)flags;
+            node_flag.OSFlagNodeWaitType = (INT8U)(wait_type & ~OS_FLAG_CONSUME);
+            node_flag.OSFlagNodePrev     = (void *)0;
+            node_flag.OSFlagNodeNext     = pgrp->OSFlagWaitList;
+            if (node_flag.OSFlagNodeNext != (void *)0) {
+                ((OS_FLAG_NODE *)node_flag.OSFlagNodeNext)->OSFlagNodePrev = (void *)&node_flag;
+            }
+            pgrp->OSFlagWaitList         = (void *)&node_flag;
+            OSTCBCur->OSTCBFlagNode      = &node_flag;
+            pnode_flag                   = &node_flag;
+            OS_EXIT_CRITICAL();
+            continue;
+        }
+#endif
+        pnode = OSEventNodeFreeList;
+        if (pnode == (OS_EVENT_NODE *)0) {
+            OS_EXIT_CRITICAL();
+           *perr = OS_ERR_EVENT_NODE_DEPLETED;
+            break;
+        }
+#if (OS_MUTEX_EN > 0)
+        if (pevent->OSEventType == OS_EVENT_TYPE_MUTEX) {
+            OS_EventMultiPIP(pevent);                   /* Owner inherits the PIP, see Note #8         */
+        }
+#endif
+        OSEventNodeFreeList          = pnode->OSEventNodeNext;
+        pnode->OSEventNodeTCB        = OSTCBCur;
+        pnode->OSEventNodeEvent      = pevent;
+        pnode->OSEventNodeMsg        = (void *)0;
+        pnode->OSEventNodeStat       = OS_STAT_PEND_TO;
+        pnode->OSEventNodePrev       = (OS_EVENT_NODE *)0;
+        pnode->OSEventNodeNext       = pevent->OSEventNodeList;
+        if (pnode->OSEventNodeNext != (OS_EVENT_NODE *)0) {
+            pnode->OSEventNodeNext->OSEventNodePrev = pnode;
+        }
+        pevent->OSEventNodeList      = pnode;           /* Link node to event's list ...               */
+        pnode->OSEventNodeTaskNext   = OSTCBCur->OSTCBEventNodeList;
+        OSTCBCur->OSTCBEventNodeList = pnode;           /* ... and to the task's, in events order      */
+       *--pevents_wait               = pevent;
+        OSTCBCur->OSTCBEventMultiPtr = pevents_wait;
+        pevent->OSEventTbl[OSTCBCur->OSTCBY] |= OSTCBCur->OSTCBBitX;   /* Put task in waiting list     */
+        pevent->OSEventGrp                   |= OSTCBCur->OSTCBBitY;
+        OS_EXIT_CRITICAL();
+    }
+
+    OS_ENTER_CRITICAL();                                /* Wait unless an event was received           */
+    if ((*perr == OS_ERR_NONE) && (events_rdy_nbr == 0) && (OSTCBCur->OSTCBStatPend == OS_STAT_PEND_TO)) {
+        OSTCBCur->OSTCBStat     |= events_stat;         /* Resource not available, ...                 */
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;     /* ... pend on multiple events                 */
+        OSTCBCur->OSTCBDly       = timeout;             /* Store pend timeout in TCB                   */
+        OS_RDY_DEL(OSTCBCur);                           /* Task no longer ready                        */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                     /* Find next highest priority task ready       */
+    } else {
+        OS_EXIT_CRITICAL();
+    }
+/*$PAGE*/
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    if (pnode_flag != (OS_FLAG_NODE *)0) {              /* Unlink the event flag node, if not posted   */
+        OS_ENTER_CRITICAL();
+        pnode_flag = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
+        while ((pnode_flag != (OS_FLAG_NODE *)0) && (pnode_flag != &node_flag)) {
+            pnode_flag = (OS_FLAG_NODE *)pnode_flag->OSFlagNodeNext;
+        }
+        if (pnode_flag != (OS_FLAG_NODE *)0) {
+            OS_FlagUnlink(&node_flag);
+        } else if (OSTCBCur->OSTCBFlagsRdy != 0) {      /* Posted: consume flags and return group      */
+            OS_EventMultiFlagConsume(pgrp, wait_type);
+            pevents_rdy[events_rdy_nbr] = (OS_EVENT *)pgrp;
+            pmsgs_rdy[events_rdy_nbr]   = (void *)0;
+            events_rdy_nbr++;
+        }
+        OS_EXIT_CRITICAL();
+    }
+#endif
+    aborted = OS_FALSE;
+    for (;;) {                                          /* Unlink the nodes, first event first         */
+        OS_ENTER_CRITICAL();
+        pnode = OSTCBCur->OSTCBEventNodeList;
+        if (pnode == (OS_EVENT_NODE *)0) {
+            break;
+        }
+        OSTCBCur->OSTCBEventNodeList = pnode->OSEventNodeTaskNext;
+        pevent = pnode->OSEventNodeEvent;
+        switch (pnode->OSEventNodeStat) {
+            case OS_STAT_PEND_OK:                       /* Posted: return event and message            */
+                 pevents_rdy[events_rdy_nbr] = pevent;
+                 pmsgs_rdy[events_rdy_nbr]   = pnode->OSEventNodeMsg;
+                 events_rdy_nbr++;
+                 break;
+
+            case OS_STAT_PEND_ABORT:                    /* Aborted: return event                       */
+                 aborted                     = OS_TRUE;
+                 pevents_rdy[events_rdy_nbr] = pevent;
+                 pmsgs_rdy[events_rdy_nbr]   = (void *)0;
+                 events_rdy_nbr++;
+                 break;
+
+            case OS_STAT_PEND_TO:                       /* Not posted: remove task from wait list      */
+            default:
+                 OS_EventNodeUnlink(pnode);
+                 OS_EventTaskRemove(OSTCBCur, pevent);
+                 OSTCBCur->OSTCBEventMultiPtr++;        /* See Note #6                                 */
+                 break;
+        }
+        pnode->OSEventNodeNext = OSEventNodeFreeList;   /* Return node to free list                    */
+        OSEventNodeFreeList    = pnode;
+        OS_EXIT_CRITICAL();
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;        /* Set   task  status to ready                 */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;    /* Clear pend  status                          */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;      /* Clear event pointers                        */
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SLOTQ_EN > 0)
+    OSTCBCur->OSTCBMsg           = (void      *)0;      /* Clear task  message                         */
+#endif
+    OS_EXIT_CRITICAL();
+
+    pevents_rdy[events_rdy_nbr] = (OS_EVENT *)0;        /* NULL terminate return event array           */
+    if (aborted == OS_TRUE) {
+       *perr = OS_ERR_PEND_ABORT;                       /* Indicate that events aborted                */
+    } else if (events_rdy_nbr > 0) {
+       *perr = OS_ERR_NONE;
+    } else if (*perr == OS_ERR_NONE) {
+       *perr = OS_ERR_TIMEOUT;                          /* Indicate that events timed out              */
+    }
+    return (events_rdy_nbr);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                             MAKE TASK READY TO RUN BASED ON EVENT OCCURING
+*
+* Description: This function is called by other uC/OS-II services and is used to ready a task that was
+*              waiting for an event to occur.
+*
+* Arguments  : pevent      is a pointer to the event control block corresponding to the event.
+*
+*              pmsg        is a pointer to a message.  This pointer is used by message oriented services
+*                          such as MAILBOXEs and QUEUEs.  The pointer is not used when called by other
+*                          service functions.
+*
+*              msk         is a mask that is used to clear the status byte of the TCB.  For example,
+*                          OSSemPost() will pass OS_STAT_SEM, OSMboxPost() will pass OS_STAT_MBOX etc.
+*
+*              pend_stat   is used to indicate the readied task's pending status:
+*
+*                          OS_STAT_PEND_OK      Task ready due to a post (or delete), not a timeout or
+*                                               an abort.
+*                          OS_STAT_PEND_ABORT   Task ready due to an abort.
+*
+* Returns    : The priority of the task readied, or
+*              OS_PRIO_SELF if the wait list only held stale entries (see Note #3): no task was readied.
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) A task waiting in OSEventPendMulti() has a node in the event's list of nodes.  The
+*                 message and the pend status are stored in the node, which is unlinked from the event,
+*                 and OS_EventMultiRdy() removes the task from the wait lists of all its other events:
+*                 a task is readied by one event only.
+*              3) A task is only readied if it waits on 'pevent': its OSTCBEventPtr is 'pevent' or it has
+*                 a node in the event's list of nodes.  Any other entry of the wait list is stale: it is
+*                 removed and the next highest priority entry is tried.
+*              4) With OS_SCHED_RR_EN, the task of the priority waiting the longest on 'pevent' is readied
+*                 (see OS_EventTaskFind()).  OS_EventTaskRdyTCB() returns its OS_TCB.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN)
+INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
+{
+    OS_TCB  *ptcb;
+
+
+    ptcb = OS_EventTaskRdyTCB(pevent, pmsg, msk, pend_stat);
+    if (ptcb == (OS_TCB *)0) {                          /* Only stale entries, see Note #3             */
+        return (OS_PRIO_SELF);
+    }
+    return (ptcb->OSTCBPrio);
+}
+
+OS_TCB  *OS_EventTaskRdyTCB (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
 {
     OS_TCB  *ptcb;
     INT8U    y;
     INT8U    x;
     INT8U    prio;
-#if OS_LOWEST_PRIO > 63
-    INT16U  *ptbl;
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT_NODE  *pnode;
 #endif
 
 
-#if OS_LOWEST_PRIO <= 63
-    y    = OSUnMapTbl[pevent->OSEventGrp];              /* Find HPT waiting for message                */
-    x    = OSUnMapTbl[pevent->OSEventTbl[y]];
-    prio = (INT8U)((y << 3) + x);                       /* Find priority of task getting the msg       */
+    for (;;) {
+        if (pevent->OSEventGrp == 0) {                  /* No task waiting on the event                */
+            return ((OS_TCB *)0);
+        }
+        y    = OS_PRIO_GRP_LOW(pevent->OSEventGrp);     /* Find HPT waiting for message                */
+        x    = OS_PRIO_ROW_LOW(pevent->OSEventTbl[y]);
+        prio = (INT8U)((y << OS_PRIO_ROW_SHIFT) + x);   /* Find priority of task getting the msg       */
+#if OS_SCHED_RR_EN > 0
+        ptcb = OS_EventTaskFind(pevent, prio, (OS_TCB *)0); /* Task of 'prio' waiting longest, Note #4 */
 #else
-    if ((pevent->OSEventGrp & 0xFF) != 0) {             /* Find HPT waiting for message                */
-        y = OSUnMapTbl[ pevent->OSEventGrp & 0xFF];
-    } else {
-        y = OSUnMapTbl[(pevent->OSEventGrp >> 8) & 0xFF] + 8;
+        ptcb = OSTCBPrioTbl[prio];                      /* Point to this task's OS_TCB                 */
+#endif
+#if (OS_EVENT_MULTI_EN > 0)
+        pnode = (OS_EVENT_NODE *)0;
+#endif
+        if ((ptcb != (OS_TCB *)0) && (ptcb != OS_TCB_RESERVED)) {
+            if (ptcb->OSTCBEventPtr == pevent) {        /* Task waits on this event ...                */
+                break;
+            }
+#if (OS_EVENT_MULTI_EN > 0)
+            pnode = pevent->OSEventNodeList;            /* ... or in OSEventPendMulti()                */
+            while ((pnode != (OS_EVENT_NODE *)0) && (pnode->OSEventNodeTCB != ptcb)) {
+                pnode = pnode->OSEventNodeNext;
+            }
+            if (pnode != (OS_EVENT_NODE *)0) {
+                break;
+            }
+#endif
+        }
+        pevent->OSEventTbl[y] &= ~OS_PRIO_BIT_X(x);     /* Stale entry, see Note #3                    */
+        if (pevent->OSEventTbl[y] == 0) {
+            pevent->OSEventGrp &= ~OS_PRIO_BIT_Y(y);
+        }
     }
-    ptbl = &pevent->OSEventTbl[y];
-    if ((*ptbl & 0xFF) != 0) {
-        x = OSUnMapTbl[*ptbl & 0xFF];
-    } else {
-        x = OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8;
+#if (OS_EVENT_MULTI_EN > 0)
+    if (pnode != (OS_EVENT_NODE *)0) {                  /* Hand event over to the task's node          */
+        pnode->OSEventNodeMsg  = pmsg;
+        pnode->OSEventNodeStat = pend_stat;
+        OS_EventNodeUnlink(pnode);
+        OS_EventMultiRdy(ptcb, pnode);                  /* Leave the other events, see Note #2         */
     }
-    prio = (INT8U)((y << 4) + x);                       /* Find priority of task getting the msg       */
 #endif
-
-    ptcb                  =  OSTCBPrioTbl[prio];        /* Point to this task's OS_TCB                 */
     ptcb->OSTCBDly        =  0;                         /* Prevent OSTimeTick() from readying task     */
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
+#if OS_DLY_LIST_EN > 0
+    if (ptcb->OSTCBDlyLinked == OS_TRUE) {              /* Remove timeout from the delay list          */
+        OS_DlyUnlink(ptcb);
+    }
+#endif
+#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SLOTQ_EN > 0)
     ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
 #else
     pmsg                  =  pmsg;                      /* Prevent compiler warning if not used        */
@@ -1073,19 +1826,123 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     ptcb->OSTCBStatPend   =  pend_stat;                 /* Set pend status of post or abort            */
                                                         /* See if task is ready (could be susp'd)      */
     if ((ptcb->OSTCBStat &   OS_STAT_SUSPEND) == OS_STAT_RDY) {
-        OSRdyGrp         |=  ptcb->OSTCBBitY;           /* Put task in the ready to run list           */
-        OSRdyTbl[y]      |=  ptcb->OSTCBBitX;
+        OS_RDY_INS(ptcb);                               /* Put task in the ready to run list           */
     }
 
     OS_EventTaskRemove(ptcb, pevent);                   /* Remove this task from event   wait list     */
-#if (OS_EVENT_MULTI_EN > 0)
-    if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {   /* Remove this task from events' wait lists    */
-        OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
-        ptcb->OSTCBEventPtr       = (OS_EVENT  *)pevent;/* Return event as first multi-pend event ready*/
+
+    return (ptcb);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                          MAKE ALL TASKS WAITING FOR AN EVENT READY TO RUN
+*
+* Description: This function is called by other uC/OS-II services to ready ALL the tasks waiting for an
+*              event, as calling OS_EventTaskRdy() until the wait list is empty would, but in one pass over
+*              the wait list.
+*
+* Arguments  : pevent      is a pointer to the event control block corresponding to the event.
+*
+*              pmsg        is a pointer to a message, given to every task (see OS_EventTaskRdy()).
+*
+*              msk         is a mask that is used to clear the status byte of the TCBs.
+*
+*              pend_stat   is used to indicate the readied tasks' pending status (see OS_EventTaskRdy()).
+*
+* Returns    : The number of tasks that were waiting.
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The bit of a task in OSEventTbl[] is the bit of the task in OSRdyTbl[]: each row of the
+*                 wait list is ORed into the ready list at once, without the bits of suspended tasks, and
+*                 cleared.  Each TCB is only visited to clear its delay and its status.
+*              4) The node of each task waiting in OSEventPendMulti() is marked and unlinked, and the task
+*                 leaves the wait lists of its other events, as in OS_EventTaskRdy().  Its bit in this
+*                 event's wait list is left for the pass over the rows.
+*              5) With OS_SCHED_RR_EN, a bit of the wait list may stand for several tasks: the tasks are
+*                 readied one at a time by OS_EventTaskRdyTCB(), in the order they would be by posts.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN)
+INT16U  OS_EventTaskRdyAll (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
+{
+#if OS_SCHED_RR_EN > 0
+    INT16U          nbr;
+
+
+    nbr = 0;
+    while (OS_EventTaskRdyTCB(pevent, pmsg, msk, pend_stat) != (OS_TCB *)0) {   /* See Note #5         */
+        nbr++;
     }
+    return (nbr);
+#else
+    OS_TCB         *ptcb;
+    OS_PRIO_GRP     grp;
+    OS_PRIO_ROW     bits;
+    OS_PRIO_ROW     rdy;
+    INT16U          nbr;
+    INT8U           y;
+    INT8U           x;
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT_NODE  *pnode;
 #endif
 
-    return (prio);
+
+#if (OS_EVENT_MULTI_EN > 0)
+    pnode = pevent->OSEventNodeList;                    /* Hand event over to all the nodes            */
+    while (pnode != (OS_EVENT_NODE *)0) {
+        OS_EventNodeUnlink(pnode);
+        pnode->OSEventNodeMsg  = pmsg;
+        pnode->OSEventNodeStat = pend_stat;
+        OS_EventMultiRdy(pnode->OSEventNodeTCB, pnode); /* Leave the other events, see Note #4         */
+        pnode = pevent->OSEventNodeList;
+    }
+#endif
+    nbr = 0;
+    grp = pevent->OSEventGrp;
+    while (grp != 0) {                                  /* For each row of the wait list ...           */
+        y     = OS_PRIO_GRP_LOW(grp);
+        grp  &= grp - 1;
+        bits  = pevent->OSEventTbl[y];
+        rdy   = bits;
+        while (bits != 0) {                             /* ... update the TCB of each waiting task     */
+            x     = OS_PRIO_ROW_LOW(bits);
+            bits &= bits - 1;
+            ptcb  = OSTCBPrioTbl[(y << OS_PRIO_ROW_SHIFT) + x];
+            ptcb->OSTCBDly       = 0;                   /* Prevent OSTimeTick() from readying task     */
+#if OS_DLY_LIST_EN > 0
+            if (ptcb->OSTCBDlyLinked == OS_TRUE) {      /* Remove timeout from the delay list          */
+                OS_DlyUnlink(ptcb);
+            }
+#endif
+#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SLOTQ_EN > 0)
+            ptcb->OSTCBMsg       = pmsg;                /* Send message directly to waiting task       */
+#endif
+            ptcb->OSTCBStat     &= ~msk;                /* Clear bit associated with event type        */
+            ptcb->OSTCBStatPend  = pend_stat;           /* Set pend status of post or abort            */
+            if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) {
+                rdy &= ~ptcb->OSTCBBitX;                /* Suspended task is not made ready            */
+#if OS_SCHED_EDF_EN > 0
+            } else if (ptcb->OSTCBEdfEn == OS_TRUE) {
+                OS_EdfRdy(ptcb);                        /* Ready EDF task is ordered by deadline       */
+#endif
+            }
+            nbr++;
+        }
+        if (rdy != 0) {                                 /* Put the row's tasks in the ready list       */
+            OSRdyTbl[y] |= rdy;
+            OSRdyGrp    |= OS_PRIO_BIT_Y(y);
+        }
+        pevent->OSEventTbl[y] = 0;                      /* Remove the row's tasks from wait list       */
+    }
+    pevent->OSEventGrp = 0;
+#if !(((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SLOTQ_EN > 0))
+    pmsg = pmsg;                                        /* Prevent compiler warning if not used        */
+#endif
+    return (nbr);
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1106,139 +1963,271 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
 #if (OS_EVENT_EN)
 void  OS_EventTaskWait (OS_EVENT *pevent)
 {
-    INT8U  y;
-
-
     OSTCBCur->OSTCBEventPtr               = pevent;                 /* Store ptr to ECB in TCB         */
 
     pevent->OSEventTbl[OSTCBCur->OSTCBY] |= OSTCBCur->OSTCBBitX;    /* Put task in waiting list        */
     pevent->OSEventGrp                   |= OSTCBCur->OSTCBBitY;
 
-    y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
-    OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
-    if (OSRdyTbl[y] == 0) {
-        OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
+    OS_RDY_DEL(OSTCBCur);                                           /* Task no longer ready            */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REMOVE TASK FROM EVENT WAIT LIST
+*
+* Description: Remove a task from an event's wait list.
+*
+* Arguments  : ptcb     is a pointer to the task to remove.
+*
+*              pevent   is a pointer to the event control block.
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) With OS_SCHED_RR_EN, the bit stays in the wait list while another task of the same
+*                 priority waits on the event.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN)
+void  OS_EventTaskRemove (OS_TCB   *ptcb,
+                          OS_EVENT *pevent)
+{
+    INT8U  y;
+
+
+#if OS_SCHED_RR_EN > 0
+    if (OS_EventTaskFind(pevent, ptcb->OSTCBPrio, ptcb) != (OS_TCB *)0) {
+        return;                                         /* Bit also stands for another task            */
+    }
+#endif
+    y                       =  ptcb->OSTCBY;
+    pevent->OSEventTbl[y]  &= ~ptcb->OSTCBBitX;         /* Remove task from wait list                  */
+    if (pevent->OSEventTbl[y] == 0) {
+        pevent->OSEventGrp &= ~ptcb->OSTCBBitY;
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                          MOVE A TASK TO ITS NEW PRIORITY IN AN EVENT'S WAIT LIST
+*
+* Description: This function moves a task whose priority just changed to its new priority in the wait list
+*              of an event, if the task is in that wait list at its old priority.
+*
+* Arguments  : ptcb        is a pointer to the task, already at its new priority.
+*
+*              pevent      is a pointer to the event control block.
+*
+*              prio_old    is the old priority of the task.
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) With OS_SCHED_RR_EN, the bit of the old priority is left in the wait list if other
+*                 tasks of that priority still wait on the event.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN)
+void  OS_EventTaskMove (OS_TCB *ptcb, OS_EVENT *pevent, INT8U prio_old)
+{
+    OS_PRIO_ROW  bitx_old;
+    INT8U        y_old;
+
+
+    y_old    = (INT8U)(prio_old >> OS_PRIO_ROW_SHIFT);
+    bitx_old = OS_PRIO_BIT_X(prio_old & OS_PRIO_ROW_MSK);
+    if ((pevent->OSEventTbl[y_old] & bitx_old) != 0) {  /* Is task in the wait list?                   */
+#if OS_SCHED_RR_EN > 0
+        if (OS_EventTaskFind(pevent, prio_old, ptcb) == (OS_TCB *)0) {
+#endif
+            pevent->OSEventTbl[y_old] &= ~bitx_old;     /* Yes, remove it at its old priority ...      */
+            if (pevent->OSEventTbl[y_old] == 0) {
+                pevent->OSEventGrp &= ~OS_PRIO_BIT_Y(y_old);
+            }
+#if OS_SCHED_RR_EN > 0
+        }
+#endif
+        pevent->OSEventGrp               |= ptcb->OSTCBBitY;   /* ... and add it at its new priority   */
+        pevent->OSEventTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
     }
 }
 #endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                          MAKE TASK WAIT FOR ANY OF MULTIPLE EVENTS TO OCCUR
+*                             FIND A TASK WAITING FOR AN EVENT AT A PRIORITY
 *
-* Description: This function is called by other uC/OS-II services to suspend a task because any one of
-*              multiple events has not occurred.
+* Description: This function looks for a task of priority 'prio' waiting on an event, when tasks may share
+*              a priority: the tasks of the level of 'prio' are all tried, and the one that has waited
+*              the longest is returned, so that the tasks of a priority are readied first in, first out.
 *
-* Arguments  : pevents_wait     is a pointer to an array of event control blocks, NULL-terminated, for 
-*                               which the task will be waiting for.
+* Arguments  : pevent   is a pointer to the event control block.
 *
-* Returns    : none.
+*              prio     is the priority whose bit is set in the event's wait list.
 *
-* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+*              pskip    is a pointer to a task to ignore, or NULL.
+*
+* Returns    : A pointer to the OS_TCB of the task that has waited the longest, or NULL if none.
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) A task waits on 'pevent' when it pends on it (or timed out and has not run yet, and is
+*                 still in the wait list as with one task per priority), or when it has a node in the
+*                 event's list of nodes.
+*              4) A mutex owner raised to 'prio' is the only task at 'prio': it is reached through
+*                 OSTCBPrioTbl[prio] and its own level is walked, where it is the only one at 'prio'.
+*              5) OS_RRUnrdy() stamps a task with OSRRSeq when it blocks: the task waiting the longest
+*                 has the oldest stamp (compared as a difference, OSRRSeq wraps around).
 *********************************************************************************************************
 */
-#if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
-void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
+#if (OS_EVENT_EN) && (OS_SCHED_RR_EN > 0)
+OS_TCB  *OS_EventTaskFind (OS_EVENT *pevent, INT8U prio, OS_TCB *pskip)
 {
-    OS_EVENT **pevents;
-    OS_EVENT  *pevent;
-    INT8U      y;
-
-
-    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;
-    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)pevents_wait;       /* Store ptr to ECBs in TCB        */
+    OS_TCB         *pfirst;
+    OS_TCB         *ptcb;
+    OS_TCB         *pfound;
+    BOOLEAN         waits;
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT_NODE  *pnode;
+#endif
 
-    pevents =  pevents_wait;
-    pevent  = *pevents;
-    while (pevent != (OS_EVENT *)0) {                               /* Put task in waiting lists       */
-        pevent->OSEventTbl[OSTCBCur->OSTCBY] |= OSTCBCur->OSTCBBitX;
-        pevent->OSEventGrp                   |= OSTCBCur->OSTCBBitY;
-        pevents++;
-        pevent = *pevents;
-    }
 
-    y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
-    OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
-    if (OSRdyTbl[y] == 0) {
-        OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
+    pfirst = OSTCBPrioTbl[prio];
+    if ((pfirst == (OS_TCB *)0) || (pfirst == OS_TCB_RESERVED)) {
+        return ((OS_TCB *)0);
     }
+    pfound = (OS_TCB *)0;
+    ptcb   = pfirst;
+    do {
+        if ((ptcb != pskip) && (ptcb->OSTCBPrio == prio)) {
+            waits = OS_FALSE;
+            if (ptcb->OSTCBEventPtr == pevent) {        /* Task pends on this event ...                */
+                if (((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != 0) ||
+                     (ptcb->OSTCBStatPend == OS_STAT_PEND_TO)) {
+                    waits = OS_TRUE;
+                }
+            }
+#if (OS_EVENT_MULTI_EN > 0)
+            pnode = pevent->OSEventNodeList;            /* ... or in OSEventPendMulti()                */
+            while ((waits == OS_FALSE) && (pnode != (OS_EVENT_NODE *)0)) {
+                if (pnode->OSEventNodeTCB == ptcb) {
+                    waits = OS_TRUE;
+                }
+                pnode = pnode->OSEventNodeNext;
+            }
+#endif
+            if (waits == OS_TRUE) {                     /* Keep the one waiting the longest, Note #5   */
+                if ((pfound == (OS_TCB *)0) || ((INT32S)(ptcb->OSTCBRRSeq - pfound->OSTCBRRSeq) < 0)) {
+                    pfound = ptcb;
+                }
+            }
+        }
+        ptcb = ptcb->OSTCBRRLevelNext;
+    } while (ptcb != pfirst);
+    return (pfound);
 }
 #endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                                   REMOVE TASK FROM EVENT WAIT LIST
+*                             REMOVE TASK FROM MULTIPLE EVENTS WAIT LISTS
 *
-* Description: Remove a task from an event's wait list.
+* Description: Remove a task waiting in OSEventPendMulti() from multiple events' wait lists, when the task
+*              is deleted.  The nodes of the task are unlinked and freed.
 *
-* Arguments  : ptcb     is a pointer to the task to remove.
+* Arguments  : ptcb             is a pointer to the task to remove.
 *
-*              pevent   is a pointer to the event control block.
+*              pevents_multi    is a pointer to the array of event control blocks, NULL-terminated.  The
+*                               events are found from the nodes of the task instead.
 *
 * Returns    : none
 *
-* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
 *********************************************************************************************************
 */
-#if (OS_EVENT_EN)
-void  OS_EventTaskRemove (OS_TCB   *ptcb,
-                          OS_EVENT *pevent)
+#if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
+void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
+                               OS_EVENT **pevents_multi)
 {
-    INT8U  y;
+    OS_EVENT_NODE  *pnode;
 
 
-    y                       =  ptcb->OSTCBY;
-    pevent->OSEventTbl[y]  &= ~ptcb->OSTCBBitX;         /* Remove task from wait list                  */
-    if (pevent->OSEventTbl[y] == 0) {
-        pevent->OSEventGrp &= ~ptcb->OSTCBBitY;
+    pevents_multi = pevents_multi;                      /* Prevent compiler warning for not using arg  */
+    pnode         = ptcb->OSTCBEventNodeList;
+    while (pnode != (OS_EVENT_NODE *)0) {               /* Remove task from all events' wait lists     */
+        ptcb->OSTCBEventNodeList = pnode->OSEventNodeTaskNext;
+        if (pnode->OSEventNodeStat == OS_STAT_PEND_TO) {/* Node still linked to its event              */
+            OS_EventNodeUnlink(pnode);
+            OS_EventTaskRemove(ptcb, pnode->OSEventNodeEvent);
+        }
+        pnode->OSEventNodeNext   = OSEventNodeFreeList; /* Return node to free list                    */
+        OSEventNodeFreeList      = pnode;
+        pnode                    = ptcb->OSTCBEventNodeList;
     }
+    ptcb->OSTCBEventMultiPtr = (OS_EVENT **)0;
 }
 #endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                             REMOVE TASK FROM MULTIPLE EVENTS WAIT LISTS
+*                        REMOVE A READIED TASK FROM ITS OTHER EVENTS' WAIT LISTS
 *
-* Description: Remove a task from multiple events' wait lists.
+* Description: Remove a task waiting in OSEventPendMulti() from the wait lists of all its events but the
+*              one that readied it.  The other nodes of the task are unlinked and freed.
 *
-* Arguments  : ptcb             is a pointer to the task to remove.
+* Arguments  : ptcb        is a pointer to the task readied.
 *
-*              pevents_multi    is a pointer to the array of event control blocks, NULL-terminated.
+*              pnode_rdy   is a pointer to the node of the event that readied the task, already unlinked
+*                          from the event, or NULL if the task was readied by its event flag group.
 *
 * Returns    : none
 *
-* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The task keeps 'pnode_rdy', the only node left in its list, to get the message and the
+*                 pend status once it runs.  It is no longer in any other wait list, so OSTCBEventMultiPtr
+*                 is cleared: a later post, a priority change or a deletion no longer sees those events.
+*              4) The bit of the task in the wait list of the event of 'pnode_rdy' is left to the caller,
+*                 even when the task has an other node on the same event.
 *********************************************************************************************************
 */
 #if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
-void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
-                               OS_EVENT **pevents_multi)
+void  OS_EventMultiRdy (OS_TCB        *ptcb,
+                        OS_EVENT_NODE *pnode_rdy)
 {
-    OS_EVENT **pevents;
-    OS_EVENT  *pevent;
-    INT8U      y;
-#if (OS_LOWEST_PRIO <= 63)
-    INT8U      bity;
-    INT8U      bitx;
-#else
-    INT16U     bity;
-    INT16U     bitx;
-#endif
-
-
-    y       =  ptcb->OSTCBY;
-    bity    =  ptcb->OSTCBBitY;
-    bitx    =  ptcb->OSTCBBitX;
-    pevents =  pevents_multi;
-    pevent  = *pevents;
-    while (pevent != (OS_EVENT *)0) {                   /* Remove task from all events' wait lists     */
-        pevent->OSEventTbl[y]  &= ~bitx;
-        if (pevent->OSEventTbl[y] == 0) {
-            pevent->OSEventGrp &= ~bity;
+    OS_EVENT_NODE  *pnode;
+    OS_EVENT       *pevent;
+
+
+    pnode = ptcb->OSTCBEventNodeList;
+    while (pnode != (OS_EVENT_NODE *)0) {               /* Leave all the other events                  */
+        ptcb->OSTCBEventNodeList = pnode->OSEventNodeTaskNext;
+        if (pnode != pnode_rdy) {
+            pevent = pnode->OSEventNodeEvent;
+            OS_EventNodeUnlink(pnode);
+            if ((pnode_rdy == (OS_EVENT_NODE *)0) || (pevent != pnode_rdy->OSEventNodeEvent)) {
+                OS_EventTaskRemove(ptcb, pevent);       /* See Note #4                                 */
+            }
+            pnode->OSEventNodeNext = OSEventNodeFreeList;   /* Return node to free list                */
+            OSEventNodeFreeList    = pnode;
         }
-        pevents++;
-        pevent = *pevents;
+        pnode = ptcb->OSTCBEventNodeList;
+    }
+    if (pnode_rdy != (OS_EVENT_NODE *)0) {              /* Keep the node of the event, see Note #3     */
+        pnode_rdy->OSEventNodeTaskNext = (OS_EVENT_NODE *)0;
+    }
+    ptcb->OSTCBEventNodeList = pnode_rdy;
+    ptcb->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    if (ptcb->OSTCBFlagNode != (OS_FLAG_NODE *)0) {     /* Leave the event flag group                  */
+        OS_FlagUnlink(ptcb->OSTCBFlagNode);
     }
+#endif
+    ptcb->OSTCBStat &= ~(OS_STAT_PEND_ANY | OS_STAT_MULTI);
 }
 #endif
 /*$PAGE*/
@@ -1258,15 +2247,14 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 #if (OS_EVENT_EN)
 void  OS_EventWaitListInit (OS_EVENT *pevent)
 {
-#if OS_LOWEST_PRIO <= 63
-    INT8U  *ptbl;
-#else
-    INT16U *ptbl;
-#endif
-    INT8U   i;
+    OS_PRIO_ROW  *ptbl;
+    INT8U         i;
 
 
     pevent->OSEventGrp = 0;                      /* No task waiting on event                           */
+#if (OS_EVENT_MULTI_EN > 0)
+    pevent->OSEventNodeList = (OS_EVENT_NODE *)0;
+#endif
     ptbl               = &pevent->OSEventTbl[0];
 
     for (i = 0; i < OS_EVENT_TBL_SIZE; i++) {
@@ -1291,6 +2279,9 @@ void  OS_EventWaitListInit (OS_EVENT *pevent)
 static  void  OS_InitEventList (void)
 {
 #if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
+#if (OS_EVENT_MULTI_EN > 0)
+    INT16U     j;
+#endif
 #if (OS_MAX_EVENTS > 1)
     INT16U     i;
     OS_EVENT  *pevent1;
@@ -1326,6 +2317,13 @@ static  void  OS_InitEventList (void)
     OSEventFreeList->OSEventName[1] = OS_ASCII_NUL;
 #endif
 #endif
+#if (OS_EVENT_MULTI_EN > 0)
+    for (j = 0; j < (OS_MAX_EVENT_NODES - 1); j++) {        /* Init. list of free multi-pend nodes     */
+        OSEventNodeTbl[j].OSEventNodeNext = &OSEventNodeTbl[j + 1];
+    }
+    OSEventNodeTbl[OS_MAX_EVENT_NODES - 1].OSEventNodeNext = (OS_EVENT_NODE *)0;
+    OSEventNodeFreeList             = &OSEventNodeTbl[0];
+#endif
 #endif
 }
 /*$PAGE*/
@@ -1363,6 +2361,27 @@ static  void  OS_InitMisc (void)
     OSIdleCtrMax  = 0L;
     OSStatRdy     = OS_FALSE;                              /* Statistic task is not ready              */
 #endif
+
+#if OS_DEADLINE_EN > 0
+    OSDeadlineHeapCtr = 0;                                 /* No task's deadlines are monitored        */
+    OSDeadlineMissCtr = 0L;
+#endif
+
+#if OS_TRACE_EN > 0
+    OSTraceIn     = 0L;                                    /* Empty the context switch trace ring      */
+    OSTraceOut    = 0L;
+    OSTraceLost   = 0L;
+#endif
+
+#if OS_STK_WM_EN > 0
+    OSStkOvfHook  = (OS_STK_OVF_HOOK)0;                    /* No stack overflow hook                   */
+    OSStkOvfCtr   = 0;
+#endif
+
+#if OS_SCHED_RR_EN > 0
+    OSRRQuantum   = OS_SCHED_RR_QUANTUM;                   /* Time slice of tasks sharing a priority   */
+    OSRRSeq       = 0;
+#endif
 }
 /*$PAGE*/
 /*
@@ -1380,12 +2399,8 @@ static  void  OS_InitMisc (void)
 
 static  void  OS_InitRdyList (void)
 {
-    INT8U    i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U   *prdytbl;
-#else
-    INT16U  *prdytbl;
-#endif
+    INT8U         i;
+    OS_PRIO_ROW  *prdytbl;
 
 
     OSRdyGrp      = 0;                                     /* Clear the ready list                     */
@@ -1393,6 +2408,9 @@ static  void  OS_InitRdyList (void)
     for (i = 0; i < OS_RDY_TBL_SIZE; i++) {
         *prdytbl++ = 0;
     }
+#if OS_SCHED_RR_EN > 0
+    OS_MemClr((INT8U *)&OSRRRdyList[0], sizeof(OSRRRdyList));  /* No task ready at any priority        */
+#endif
 
     OSPrioCur     = 0;
     OSPrioHighRdy = 0;
@@ -1574,6 +2592,12 @@ static  void  OS_InitTCBList (void)
 #endif
     OSTCBList               = (OS_TCB *)0;                       /* TCB lists initializations          */
     OSTCBFreeList           = &OSTCBTbl[0];
+#if OS_DLY_LIST_EN > 0
+    OSTCBDlyList            = (OS_TCB *)0;                       /* No task is delayed                 */
+#endif
+#if OS_SCHED_EDF_EN > 0
+    OSEdfHeapCtr            = 0;                                 /* No task scheduled by deadline yet  */
+#endif
 }
 /*$PAGE*/
 /*
@@ -1589,16 +2613,42 @@ static  void  OS_InitTCBList (void)
 * Returns    : none
 *
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
-*              2) Note that we can only clear up to 64K bytes of RAM.  This is not an issue because none
-*                 of the uses of this function gets close to this limit.
-*              3) The clear is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the destination.
+*              2) The bytes up to the first word boundary are cleared one at a time, the bulk of the block is
+*                 cleared one OS_MEM_WORD at a time (4 words per loop pass) and the remaining bytes are
+*                 cleared one at a time.  This works on any processor irrespective of the alignment of the
+*                 destination and needs a quarter of the stores of a byte loop on the large tables
+*                 (OSTCBTbl[], OSEventTbl[], ...) cleared by OSInit().
+*              3) The words are stored through OS_CPU_MEM_WORD, a type the compiler must assume may alias
+*                 the objects being cleared, and the alignment is tested on the address converted to
+*                 OS_CPU_ADDR, an integer as wide as a pointer.  Both are defined by the port (OS_CPU.H);
+*                 by default OS_CPU_MEM_WORD is a byte, so the word loops move one byte at a time.
 *********************************************************************************************************
 */
 
-void  OS_MemClr (INT8U *pdest, INT16U size)
+void  OS_MemClr (INT8U *pdest, INT32U size)
 {
-    while (size > 0) {
+    OS_MEM_WORD  *pdest32;
+
+
+    while ((size > 0) && (((OS_CPU_ADDR)pdest & (sizeof(OS_MEM_WORD) - 1)) != 0)) {
+        *pdest++ = (INT8U)0;                             /* Clear up to the first word boundary        */
+        size--;
+    }
+    pdest32 = (OS_MEM_WORD *)pdest;
+    while (size >= 4 * sizeof(OS_MEM_WORD)) {            /* Clear 4 words at a time                    */
+        pdest32[0] = 0;
+        pdest32[1] = 0;
+        pdest32[2] = 0;
+        pdest32[3] = 0;
+        pdest32   += 4;
+        size      -= 4 * sizeof(OS_MEM_WORD);
+    }
+    while (size >= sizeof(OS_MEM_WORD)) {
+        *pdest32++ = 0;
+        size      -= sizeof(OS_MEM_WORD);
+    }
+    pdest = (INT8U *)pdest32;
+    while (size > 0) {                                   /* Clear the remaining bytes                  */
         *pdest++ = (INT8U)0;
         size--;
     }
@@ -1622,15 +2672,43 @@ void  OS_MemClr (INT8U *pdest, INT16U size)
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.  There is
 *                 no provision to handle overlapping memory copy.  However, that's not a problem since this
 *                 is not a situation that will happen.
-*              2) Note that we can only copy up to 64K bytes of RAM
-*              3) The copy is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the source and destination.
+*              2) When the source and the destination have the same alignment, the bytes up to the first
+*                 word boundary are copied one at a time and the bulk of the block one OS_MEM_WORD at a time
+*                 (see OS_MemClr()).  Otherwise, the copy is done one byte at a time since this will work on
+*                 any processor irrespective of the alignment of the source and destination.
 *********************************************************************************************************
 */
 
-void  OS_MemCopy (INT8U *pdest, INT8U *psrc, INT16U size)
+void  OS_MemCopy (INT8U *pdest, INT8U *psrc, INT32U size)
 {
-    while (size > 0) {
+    OS_MEM_WORD  *pdest32;
+    OS_MEM_WORD  *psrc32;
+
+
+    if ((((OS_CPU_ADDR)pdest ^ (OS_CPU_ADDR)psrc) & (sizeof(OS_MEM_WORD) - 1)) == 0) {
+        while ((size > 0) && (((OS_CPU_ADDR)pdest & (sizeof(OS_MEM_WORD) - 1)) != 0)) {
+            *pdest++ = *psrc++;                          /* Copy up to the first word boundary         */
+            size--;
+        }
+        pdest32 = (OS_MEM_WORD *)pdest;
+        psrc32  = (OS_MEM_WORD *)psrc;
+        while (size >= 4 * sizeof(OS_MEM_WORD)) {        /* Copy 4 words at a time                     */
+            pdest32[0] = psrc32[0];
+            pdest32[1] = psrc32[1];
+            pdest32[2] = psrc32[2];
+            pdest32[3] = psrc32[3];
+            pdest32   += 4;
+            psrc32    += 4;
+            size      -= 4 * sizeof(OS_MEM_WORD);
+        }
+        while (size >= sizeof(OS_MEM_WORD)) {
+            *pdest32++ = *psrc32++;
+            size      -= sizeof(OS_MEM_WORD);
+        }
+        pdest = (INT8U *)pdest32;
+        psrc  = (INT8U *)psrc32;
+    }
+    while (size > 0) {                                   /* Copy the remaining (or all the) bytes      */
         *pdest++ = *psrc++;
         size--;
     }
@@ -1655,26 +2733,42 @@ void  OS_MemCopy (INT8U *pdest, INT8U *psrc, INT16U size)
 
 void  OS_Sched (void)
 {
+#if OS_PROFILE_EN > 0
+    OS_CPU_CYCLES  ts;
+#endif
 #if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
-    OS_CPU_SR  cpu_sr = 0;
+    OS_CPU_SR      cpu_sr = 0;
 #endif
 
 
 
+#if OS_PROFILE_EN > 0
+    ts = OS_CPU_CYCLES_GET();                          /* Time the scheduling decision                 */
+#endif
     OS_ENTER_CRITICAL();
     if (OSIntNesting == 0) {                           /* Schedule only if all ISRs done and ...       */
         if (OSLockNesting == 0) {                      /* ... scheduler is not locked                  */
             OS_SchedNew();
+            OSTCBHighRdy = OS_TCB_HIGH_RDY();
+#if OS_SCHED_RR_EN > 0
+            if (OSTCBHighRdy != OSTCBCur) {            /* Tasks may share the highest priority         */
+#else
             if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy     */
-            	if ((OSPrioCur >= 5 && OSPrioCur <= 20) || (OSPrioHighRdy >= 5 && OSPrioHighRdy <= 20)) {
-					char tempBuf[MSG_BUF_SIZE];
-					sprintf(tempBuf, "%5d Complete    %3d      %3d\n",
-							(int)OSTimeGet(), (int)OSPrioCur, (int)OSPrioHighRdy);
-					AddMessageToQueue(tempBuf);
-				}
-                OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
+#if OS_TRACE_EN > 0
+                OS_TraceRec(OS_TRACE_EVT_COMPLETE, OSPrioCur, OSPrioHighRdy);
+#endif
+#if OS_DLY_LIST_EN > 0
+                OS_DlySw();                            /* Update delay list for tasks switched         */
+#endif
 #if OS_TASK_PROFILE_EN > 0
                 OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task      */
+#endif
+#if OS_PROFILE_EN > 0
+                OS_ProfileSw(ts);                      /* Charge the task switched out                 */
+#endif
+#if OS_STK_WM_EN > 0
+                OS_StkWmSw();                          /* Check stack of the task switched in          */
 #endif
                 OSCtxSwCtr++;                          /* Increment context switch counter             */
                 OS_TASK_SW();                          /* Perform a context switch                     */
@@ -1698,32 +2792,28 @@ void  OS_Sched (void)
 *
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
 *              2) Interrupts are assumed to be disabled when this function is called.
+*              3) Each level of the ready list is resolved by OS_PRIO_GRP_LOW() and OS_PRIO_ROW_LOW(), as
+*                 the wait list of an event is by OS_EventTaskRdy(): with OS_CTZ_EN set to 1, a single count
+*                 trailing zeros per level (see OS_CPU_CTZ()) instead of OSUnMapTbl[] lookups and, with rows
+*                 of 16 priorities, the tests on each half of the words (see PRIORITY BITMAPS in UCOS_II.H).
+*              4) When the highest priority ready task is scheduled by deadline (see OSTaskDeadlineSet()),
+*                 the ready EDF task with the earliest deadline runs instead.
+*              5) With OS_SCHED_RR_EN, several tasks may be ready at OSPrioHighRdy: the caller runs the
+*                 one whose turn it is, OS_TCB_HIGH_RDY() (see OS_RR.C).
 *********************************************************************************************************
 */
 
 static  void  OS_SchedNew (void)
 {
-#if OS_LOWEST_PRIO <= 63                         /* See if we support up to 64 tasks                   */
     INT8U   y;
 
 
-    y             = OSUnMapTbl[OSRdyGrp];
-    OSPrioHighRdy = (INT8U)((y << 3) + OSUnMapTbl[OSRdyTbl[y]]);
-#else                                            /* We support up to 256 tasks                         */
-    INT8U   y;
-    INT16U *ptbl;
-
+    y             = OS_PRIO_GRP_LOW(OSRdyGrp);   /* Find the highest priority ready row, then task     */
+    OSPrioHighRdy = (INT8U)((y << OS_PRIO_ROW_SHIFT) + OS_PRIO_ROW_LOW(OSRdyTbl[y]));
 
-    if ((OSRdyGrp & 0xFF) != 0) {
-        y = OSUnMapTbl[OSRdyGrp & 0xFF];
-    } else {
-        y = OSUnMapTbl[(OSRdyGrp >> 8) & 0xFF] + 8;
-    }
-    ptbl = &OSRdyTbl[y];
-    if ((*ptbl & 0xFF) != 0) {
-        OSPrioHighRdy = (INT8U)((y << 4) + OSUnMapTbl[(*ptbl & 0xFF)]);
-    } else {
-        OSPrioHighRdy = (INT8U)((y << 4) + OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8);
+#if OS_SCHED_EDF_EN > 0
+    if (OSTCBPrioTbl[OSPrioHighRdy]->OSTCBEdfEn == OS_TRUE) {   /* Order EDF tasks by deadline instead */
+        OSPrioHighRdy = OS_EdfSchedNew();
     }
 #endif
 }
@@ -1813,11 +2903,18 @@ INT8U  OS_StrLen (INT8U *psrc)
 *                 interrupts.
 *              2) This hook has been added to allow you to do such things as STOP the CPU to conserve
 *                 power.
+*              3) With OS_TICKLESS_EN set to 1, when the idle task is the only task ready, the port is asked
+*                 to stop the tick until the next delay expires (see OS_CPU_TickSuppress()).  The ticks that
+*                 elapsed while asleep are then accounted for in a single pass.  OSIdleCtr is not incremented
+*                 while asleep.
 *********************************************************************************************************
 */
 
 void  OS_TaskIdle (void *p_arg)
 {
+#if OS_TICKLESS_EN > 0
+    INT16U     ticks;
+#endif
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -1828,7 +2925,20 @@ void  OS_TaskIdle (void *p_arg)
     for (;;) {
         OS_ENTER_CRITICAL();
         OSIdleCtr++;
+#if OS_TICKLESS_EN > 0
+        ticks = 0;
+        if ((OSRdyGrp                    == OSTCBCur->OSTCBBitY) &&   /* Only the idle task ready?     */
+            (OSRdyTbl[OSTCBCur->OSTCBY] == OSTCBCur->OSTCBBitX)) {
+            ticks = OS_CPU_TickSuppress(OS_TimeDlyNext());  /* Sleep, interrupts stay disabled         */
+            OS_TimeTickN(ticks);                     /* Account for the ticks that were suppressed     */
+        }
+#endif
         OS_EXIT_CRITICAL();
+#if OS_TICKLESS_EN > 0
+        if (ticks != 0) {
+            OS_Sched();                              /* Run the tasks whose delay expired              */
+        }
+#endif
         OSTaskIdleHook();                        /* Call user definable HOOK                           */
     }
 }
@@ -1854,19 +2964,22 @@ void  OS_TaskIdle (void *p_arg)
 *              2) You can disable this task by setting the configuration #define OS_TASK_STAT_EN to 0.
 *              3) You MUST have at least a delay of 2/10 seconds to allow for the system to establish the
 *                 maximum value for the idle counter.
+*              4) With OS_STAT_LOAD_EN set to 1, OS_LoadUpdate() computes OSCPUUsage, OSCPULoad[] and the load
+*                 of each task from the measured run times instead, and there is no wait for OSStatInit().
 *********************************************************************************************************
 */
 
 #if OS_TASK_STAT_EN > 0
 void  OS_TaskStat (void *p_arg)
 {
-#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+#if (OS_CRITICAL_METHOD == 3) && (OS_STAT_LOAD_EN == 0)  /* Allocate storage for CPU status register     */
     OS_CPU_SR  cpu_sr = 0;
 #endif
 
 
 
     (void)p_arg;                                 /* Prevent compiler warning for not using 'p_arg'     */
+#if OS_STAT_LOAD_EN == 0
     while (OSStatRdy == OS_FALSE) {
         OSTimeDly(2 * OS_TICKS_PER_SEC / 10);    /* Wait until statistic task is ready                 */
     }
@@ -1875,17 +2988,25 @@ void  OS_TaskStat (void *p_arg)
         OSCPUUsage = 0;
         (void)OSTaskSuspend(OS_PRIO_SELF);
     }
+#endif
     for (;;) {
+#if OS_STAT_LOAD_EN > 0
+        OSTimeDly(OS_TICKS_PER_SEC / 10);        /* Measure the loads over the next 1/10 second        */
+        OS_LoadUpdate();
+#else
         OS_ENTER_CRITICAL();
         OSIdleCtrRun = OSIdleCtr;                /* Obtain the of the idle counter for the past second */
         OSIdleCtr    = 0L;                       /* Reset the idle counter for the next second         */
         OS_EXIT_CRITICAL();
         OSCPUUsage   = (INT8U)(100L - OSIdleCtrRun / OSIdleCtrMax);
+#endif
         OSTaskStatHook();                        /* Invoke user definable hook                         */
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
         OS_TaskStatStkChk();                     /* Check the stacks for each task                     */
 #endif
+#if OS_STAT_LOAD_EN == 0
         OSTimeDly(OS_TICKS_PER_SEC / 10);        /* Accumulate OSIdleCtr for the next 1/10 second      */
+#endif
     }
 }
 #endif
@@ -1899,12 +3020,32 @@ void  OS_TaskStat (void *p_arg)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) With OS_STK_WM_EN set to 1, each stack is only scanned from its last known high-water mark
+*                 (see OS_StkWmScan()) instead of from its bottom by OSTaskStkChk().
 *********************************************************************************************************
 */
 
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
 void  OS_TaskStatStkChk (void)
 {
+#if OS_STK_WM_EN > 0
+    OS_TCB      *ptcb;
+#if OS_CRITICAL_METHOD == 3                                          /* Storage for CPU status register   */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBList;
+    OS_EXIT_CRITICAL();
+    while (ptcb != (OS_TCB *)0) {                                    /* Go through all TCBs in TCB list   */
+        OS_StkWmScan(ptcb);
+        OS_ENTER_CRITICAL();
+        ptcb = ptcb->OSTCBNext;
+        OS_EXIT_CRITICAL();
+    }
+#else
     OS_TCB      *ptcb;
     OS_STK_DATA  stk_data;
     INT8U        err;
@@ -1929,6 +3070,7 @@ void  OS_TaskStatStkChk (void)
             }
         }
     }
+#endif
 }
 #endif
 /*$PAGE*/
@@ -2013,30 +3155,24 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBDelReq        = OS_ERR_NONE;
 #endif
 
-#if OS_LOWEST_PRIO <= 63
-        ptcb->OSTCBY             = (INT8U)(prio >> 3);          /* Pre-compute X, Y, BitX and BitY     */
-        ptcb->OSTCBX             = (INT8U)(prio & 0x07);
-        ptcb->OSTCBBitY          = (INT8U)(1 << ptcb->OSTCBY);
-        ptcb->OSTCBBitX          = (INT8U)(1 << ptcb->OSTCBX);
-#else
-        ptcb->OSTCBY             = (INT8U)((prio >> 4) & 0xFF); /* Pre-compute X, Y, BitX and BitY     */
-        ptcb->OSTCBX             = (INT8U) (prio & 0x0F);
-        ptcb->OSTCBBitY          = (INT16U)(1 << ptcb->OSTCBY);
-        ptcb->OSTCBBitX          = (INT16U)(1 << ptcb->OSTCBX);
-#endif
+        ptcb->OSTCBY             = (INT8U)(prio >> OS_PRIO_ROW_SHIFT); /* Pre-compute X, Y, BitX, BitY */
+        ptcb->OSTCBX             = (INT8U)(prio &  OS_PRIO_ROW_MSK);
+        ptcb->OSTCBBitY          = OS_PRIO_BIT_Y(ptcb->OSTCBY);
+        ptcb->OSTCBBitX          = OS_PRIO_BIT_X(ptcb->OSTCBX);
 
 #if (OS_EVENT_EN)
         ptcb->OSTCBEventPtr      = (OS_EVENT  *)0;         /* Task is not pending on an  event         */
 #if (OS_EVENT_MULTI_EN > 0)
         ptcb->OSTCBEventMultiPtr = (OS_EVENT **)0;         /* Task is not pending on any events        */
+        ptcb->OSTCBEventNodeList = (OS_EVENT_NODE *)0;
 #endif
 #endif
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0) && (OS_TASK_DEL_EN > 0)
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0) && ((OS_TASK_DEL_EN > 0) || (OS_EVENT_MULTI_EN > 0))
         ptcb->OSTCBFlagNode  = (OS_FLAG_NODE *)0;          /* Task is not pending on an event flag     */
 #endif
 
-#if (OS_MBOX_EN > 0) || ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
+#if (OS_MBOX_EN > 0) || ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_SLOTQ_EN > 0)
         ptcb->OSTCBMsg       = (void *)0;                  /* No message received                      */
 #endif
 
@@ -2053,20 +3189,66 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBTaskName[1] = OS_ASCII_NUL;
 #endif
 
+#if OS_TASK_PERIODIC_EN > 0
+        ptcb->OSTCBJobFnct     = (void (*)(void *))0;      /* Task is not periodic                     */
+#endif
+
+#if OS_MUTEX_CEIL_EN > 0
+        ptcb->OSTCBCeilNest     = 0;                       /* Task holds no priority ceiling mutex     */
+#endif
+
+#if OS_BUDGET_EN > 0
+        ptcb->OSTCBBudget       = 0;                       /* CPU budget is not enforced               */
+        ptcb->OSTCBBudgetOvrCtr = 0L;
+#endif
+
+#if OS_STK_WM_EN > 0
+        ptcb->OSTCBStkWm        = ptos;                    /* Only the initial frame is used           */
+        ptcb->OSTCBStkLimit     = (OS_STK *)0;             /* No limit if the stack bottom is unknown  */
+        if (pbos != (OS_STK *)0) {
+#if OS_STK_GROWTH == 1
+            ptcb->OSTCBStkLimit = pbos + OS_STK_RED_SIZE;
+#else
+            ptcb->OSTCBStkLimit = pbos - OS_STK_RED_SIZE;
+#endif
+        }
+        ptcb->OSTCBStkOvf       = OS_FALSE;
+#endif
+
+#if OS_STAT_LOAD_EN > 0
+        ptcb->OSTCBLoadCycles   = 0L;                      /* No load measured yet                     */
+        OS_MemClr((INT8U *)&ptcb->OSTCBLoad, sizeof(OS_LOAD));
+#endif
+
+#if OS_SCHED_RR_EN > 0
+        ptcb->OSTCBRRNext       = (OS_TCB *)0;             /* Not in the ready ring yet                */
+        ptcb->OSTCBRRPrev       = (OS_TCB *)0;
+#endif
+
         OSTCBInitHook(ptcb);
 
         OSTaskCreateHook(ptcb);                            /* Call user defined hook                   */
 
         OS_ENTER_CRITICAL();
+#if OS_DEADLINE_EN > 0
+        ptcb->OSTCBDeadlineMissCtr = 0L;
+#endif
+#if OS_SCHED_EDF_EN > 0
+        ptcb->OSTCBEdfIx = 0;                              /* Task starts as fixed priority            */
+        ptcb->OSTCBEdfEn = OS_FALSE;
+#endif
+#if OS_SCHED_RR_EN > 0
+        OS_RRLevelLink(ptcb);                              /* Priority may be shared, see OS_RR.C      */
+#else
         OSTCBPrioTbl[prio] = ptcb;
+#endif
         ptcb->OSTCBNext    = OSTCBList;                    /* Link into TCB chain                      */
         ptcb->OSTCBPrev    = (OS_TCB *)0;
         if (OSTCBList != (OS_TCB *)0) {
             OSTCBList->OSTCBPrev = ptcb;
         }
         OSTCBList               = ptcb;
-        OSRdyGrp               |= ptcb->OSTCBBitY;         /* Make task ready to run                   */
-        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+        OS_RDY_INS(ptcb);                                  /* Make task ready to run                   */
         OSTaskCtr++;                                       /* Increment the #tasks counter             */
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
@@ -2074,3 +3256,207 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
     OS_EXIT_CRITICAL();
     return (OS_ERR_TASK_NO_MORE_TCB);
 }
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    FIND THE NEXT DELAY TO EXPIRE
+*
+* Description: This function is called by the idle task to find how many ticks can be suppressed before a
+*              delayed task (or a task pending with a timeout) must be made ready, or a deadline is reached.
+*
+* Arguments  : none
+*
+* Returns    : The number of ticks until the next expiry or, 0 if no task is delayed and no deadline is
+*              monitored.
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) When timers are enabled, OSTmrSignal() is expected to be called from the tick ISR so no more
+*                 than a timer tick worth of system ticks is suppressed.
+*              3) The earliest deadline of OSDeadlineHeap[] also ends the sleep, so that OS_DeadlineChk()
+*                 records a miss at the tick it occurs, as it would without tickless idle.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+static  INT16U  OS_TimeDlyNext (void)
+{
+    INT16U   ticks;
+#if OS_DLY_LIST_EN == 0
+    OS_TCB  *ptcb;
+#endif
+#if OS_DEADLINE_EN > 0
+    INT32S   left;
+#endif
+
+
+#if OS_DLY_LIST_EN > 0
+    ticks = 0;
+    if (OSTCBDlyList != (OS_TCB *)0) {                     /* Head of delay list expires first         */
+        ticks = OSTCBDlyList->OSTCBDlyDelta;
+    }
+#else
+    ticks = 0;
+    ptcb  = OSTCBList;
+    while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {         /* Find the shortest delay                  */
+        if (ptcb->OSTCBDly != 0) {
+            if ((ticks == 0) || (ptcb->OSTCBDly < ticks)) {
+                ticks = ptcb->OSTCBDly;
+            }
+        }
+        ptcb = ptcb->OSTCBNext;
+    }
+#endif
+#if OS_DEADLINE_EN > 0
+    if (OSDeadlineHeapCtr > 0) {                           /* Earliest deadline, see Note #3           */
+        left = (INT32S)(OSDeadlineHeap[0]->deadline - OSTime);
+        if (left < 1) {
+            left = 1;
+        }
+        if ((ticks == 0) || (left < (INT32S)ticks)) {
+            ticks = (left < 65535L) ? (INT16U)left : 65535u;
+        }
+    }
+#endif
+#if OS_TMR_EN > 0
+    if ((ticks == 0) || (ticks > (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC))) {
+        ticks = OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC;
+    }
+#endif
+    return (ticks);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     PROCESS SEVERAL SYSTEM TICKS
+*
+* Description: This function is called by the idle task after the port suppressed ticks.  Each tick is
+*              accounted for as OSTimeTick() would: OSTimeTickHook() is called, the system clock advances
+*              and the tick is charged to the running task.  The delays of all tasks are then advanced by
+*              'ticks' in a single pass.
+*
+* Arguments  : ticks    is the number of ticks that elapsed while the tick was suppressed.
+*
+* Returns    : none
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called so that no ISR can
+*                 observe the system clock before it is corrected.  OSTimeTickHook() is also called with
+*                 interrupts disabled.
+*              2) No delay expires and no deadline is reached before the last tick (see OS_TimeDlyNext()):
+*                 the single pass readies the same tasks, and records the same misses, as 'ticks' calls
+*                 to OSTimeTick() would.
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeTickN (INT16U ticks)
+{
+    OS_TCB  *ptcb;
+    INT16U   n;
+
+
+    if (ticks == 0) {
+        return;
+    }
+    for (n = ticks; n > 0; n--) {
+#if OS_TIME_TICK_HOOK_EN > 0
+        OSTimeTickHook();                                  /* Call user definable hook                 */
+#endif
+#if OS_TIME_GET_SET_EN > 0
+        OSTime++;                                          /* Update the 32-bit tick counter           */
+#endif
+        OS_TimeTickCharge();                               /* Charge the tick to the idle task         */
+    }
+#if OS_DLY_LIST_EN > 0
+    ptcb = OSTCBDlyList;
+    while (ptcb != (OS_TCB *)0) {
+        if (ptcb->OSTCBDlyDelta > ticks) {                 /* Remaining TCBs expire after 'ticks'      */
+            ptcb->OSTCBDlyDelta -= ticks;
+            break;
+        }
+        ticks               -= ptcb->OSTCBDlyDelta;
+        ptcb->OSTCBDlyDelta  = 0;
+        OS_DlyUnlink(ptcb);
+        if (ptcb->OSTCBDly != 0) {                         /* Skip tasks already made ready elsewhere  */
+            ptcb->OSTCBDly = 0;
+            OS_TimeTickRdy(ptcb);
+        }
+        ptcb = OSTCBDlyList;
+    }
+#else
+    ptcb = OSTCBList;
+    while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {         /* Go through all TCBs in TCB list          */
+        if (ptcb->OSTCBDly != 0) {
+            if (ptcb->OSTCBDly > ticks) {
+                ptcb->OSTCBDly -= ticks;
+            } else {
+                ptcb->OSTCBDly  = 0;
+                OS_TimeTickRdy(ptcb);
+            }
+        }
+        ptcb = ptcb->OSTCBNext;
+    }
+#endif
+#if OS_DEADLINE_EN > 0
+    OS_DeadlineChk();                                      /* Look for missed deadlines                */
+#endif
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  CHARGE A TICK TO THE RUNNING TASK
+*
+* Description: This function is called by OSTimeTick(), and by OS_TimeTickN() for each suppressed tick, to
+*              charge the tick to the computation time, CPU budget and time slice of the running task.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeTickCharge (void)
+{
+    if (OSTCBCur->compTime > 0) {
+        OSTCBCur->compTime--;
+    }
+#if OS_BUDGET_EN > 0
+    OS_BudgetTick();                                       /* Charge the tick to the task's budget     */
+#endif
+#if OS_SCHED_RR_EN > 0
+    OS_RRTick();                                           /* Charge the tick to the time slice        */
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      END THE DELAY OF A TASK
+*
+* Description: This function is called when the delay (or the pend timeout) of a task expires.  A pending
+*              task is flagged as having timed out and the task is made ready unless it is suspended.
+*
+* Arguments  : ptcb     is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeTickRdy (OS_TCB *ptcb)
+{
+    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {     /* Was task pending?                */
+        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;              /* Yes, Clear status flag           */
+        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                     /* Indicate PEND timeout            */
+    } else {
+        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
+    }
+
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {      /* Is task suspended?               */
+        OS_RDY_INS(ptcb);                                          /* No,  Make ready                  */
+    }
+}
@@ -0,0 +1,351 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                     TASK DEADLINES AND MISS MONITOR
+*
+* File    : OS_DEADLINE.C
+* Version : V2.86
+*
+* Note(s) : 1) The absolute deadline of a task (OS_TCB.deadline) is used by the EDF scheduler (see OS_EDF.C)
+*              and by the deadline miss monitor.
+*
+*           2) Tasks registered with the monitor through OSTaskPeriodSet() are kept in OSDeadlineHeap[], a
+*              binary min-heap ordered by deadline.  OSTimeTick() only looks at the root of the heap so a
+*              tick costs the same whatever the number of tasks, unless a deadline is missed.  On a miss,
+*              the task's and the global miss counters are incremented, an OS_TRACE_EVT_DEADLINE record is
+*              logged (when OS_TRACE_EN is 1) and the deadline is moved one period ahead.
+*
+*           3) Deadlines are compared as (INT32S)(a - b) so that they keep working across the wrap of the
+*              32-bit tick counter, as long as deadlines are less than 2^31 ticks apart.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_DEADLINE_EN > 0
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_DeadlineFix(INT16U ix);
+
+static  void  OS_DeadlinePut(INT16U ix, OS_TCB *ptcb);
+#endif
+
+#if (OS_SCHED_EDF_EN > 0) || (OS_DEADLINE_EN > 0)
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       SET A TASK'S ABSOLUTE DEADLINE
+*
+* Description: This function sets the absolute deadline (in ticks) of a task, typically when the task
+*              completes a job and moves on to the next one.  When EDF scheduling is enabled, the task is
+*              scheduled by deadline from now on.
+*
+* Arguments  : prio      is the priority of the task.  If you specify OS_PRIO_SELF, the deadline of the
+*                        calling task is set.
+*
+*              deadline  is the absolute time (see OSTimeGet()) by which the task's current job must be
+*                        complete.
+*
+* Returns    : OS_ERR_NONE            if the deadline was set.
+*              OS_ERR_PRIO_INVALID    if the priority is higher than the maximum allowed or is the idle task.
+*              OS_ERR_TASK_NOT_EXIST  if the task does not exist.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskDeadlineSet (INT8U prio, INT32U deadline)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                      /* Not allowed for the idle task either         */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if setting our own deadline              */
+        prio = OSTCBCur->OSTCBPrio;
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if (ptcb == (OS_TCB *)0) {                         /* Task must exist                              */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb == OS_TCB_RESERVED) {                     /* Priority may only be reserved by a mutex     */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    OS_TaskDeadlineSet(ptcb, deadline);
+    OS_EXIT_CRITICAL();
+#if OS_SCHED_EDF_EN > 0
+    if (OSRunning == OS_TRUE) {
+        OS_Sched();                                    /* Another EDF task may now be due first        */
+    }
+#endif
+    return (OS_ERR_NONE);
+}
+#endif
+
+#if OS_DEADLINE_EN > 0
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                MONITOR THE DEADLINES OF A PERIODIC TASK
+*
+* Description: This function registers a task with the deadline miss monitor.
+*
+* Arguments  : prio      is the priority of the task.  If you specify OS_PRIO_SELF, the calling task is
+*                        registered.
+*
+*              period    is the period of the task (in ticks).  When a deadline is missed, the next deadline
+*                        is set 'period' ticks later.  If 0, the task is no longer monitored after a miss.
+*
+*              deadline  is the absolute time (see OSTimeGet()) by which the task's first job must be
+*                        complete.  Use OSTaskDeadlineSet() to move it as each job completes.
+*
+* Returns    : OS_ERR_NONE            if the task is now monitored.
+*              OS_ERR_PRIO_INVALID    if the priority is higher than the maximum allowed or is the idle task.
+*              OS_ERR_TASK_NOT_EXIST  if the task does not exist.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskPeriodSet (INT8U prio, INT16U period, INT32U deadline)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                      /* Not allowed for the idle task either         */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if registering ourself                   */
+        prio = OSTCBCur->OSTCBPrio;
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if (ptcb == (OS_TCB *)0) {                         /* Task must exist                              */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb == OS_TCB_RESERVED) {                     /* Priority may only be reserved by a mutex     */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    ptcb->period = period;
+    if (ptcb->OSTCBDeadlineIx == 0) {                  /* Add task at the bottom of the heap           */
+        OS_DeadlinePut(OSDeadlineHeapCtr, ptcb);
+        OSDeadlineHeapCtr++;
+    }
+    OS_TaskDeadlineSet(ptcb, deadline);                /* Move task to its place in the heap           */
+    OS_EXIT_CRITICAL();
+#if OS_SCHED_EDF_EN > 0
+    if (OSRunning == OS_TRUE) {
+        OS_Sched();
+    }
+#endif
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        CHECK FOR MISSED DEADLINES
+*
+* Description: This function is called by OSTimeTick() to detect the tasks whose deadline has been reached
+*              while their job was not complete.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) OSTaskDel() removes a deleted task from the heap: every task in the heap exists.
+*********************************************************************************************************
+*/
+
+void  OS_DeadlineChk (void)
+{
+    OS_TCB  *ptcb;
+
+
+    while (OSDeadlineHeapCtr > 0) {
+        ptcb = OSDeadlineHeap[0];                      /* Task with the earliest deadline              */
+        if ((INT32S)(OSTime - ptcb->deadline) < 0) {
+            break;                                     /* Earliest deadline not reached yet            */
+        }
+        ptcb->OSTCBDeadlineMissCtr++;
+        OSDeadlineMissCtr++;
+#if OS_TRACE_EN > 0
+        OS_TraceRec(OS_TRACE_EVT_DEADLINE, ptcb->OSTCBPrio, OSPrioCur);
+#endif
+        if (ptcb->period == 0) {                       /* One shot deadline, stop monitoring task      */
+            OS_DeadlineUnlink(ptcb);
+        } else {
+            OS_TaskDeadlineSet(ptcb, ptcb->deadline + (INT32U)ptcb->period);
+        }
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   STOP MONITORING THE DEADLINES OF A TASK
+*
+* Description: This function removes a task from OSDeadlineHeap[].
+*
+* Arguments  : ptcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_DeadlineUnlink (OS_TCB *ptcb)
+{
+    INT16U  ix;
+
+
+    ix                    = ptcb->OSTCBDeadlineIx - 1;
+    ptcb->OSTCBDeadlineIx = 0;
+    OSDeadlineHeapCtr--;
+    if (ix != OSDeadlineHeapCtr) {                     /* Move last task in the hole and reorder       */
+        OS_DeadlinePut(ix, OSDeadlineHeap[OSDeadlineHeapCtr]);
+        OS_DeadlineFix(ix);
+    }
+    OSDeadlineHeap[OSDeadlineHeapCtr] = (OS_TCB *)0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    RESTORE THE ORDER OF THE HEAP
+*
+* Description: This function moves the task at position 'ix' of OSDeadlineHeap[] up or down until the heap
+*              is ordered by deadline again.
+*
+* Arguments  : ix        is the position of the task whose deadline changed.
+*
+* Returns    : none
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_DeadlineFix (INT16U ix)
+{
+    OS_TCB  *ptcb;
+    INT16U   parent;
+    INT16U   child;
+
+
+    ptcb = OSDeadlineHeap[ix];
+    while (ix > 0) {                                   /* Move up while due before our parent          */
+        parent = (INT16U)((ix - 1) / 2);
+        if ((INT32S)(ptcb->deadline - OSDeadlineHeap[parent]->deadline) >= 0) {
+            break;
+        }
+        OS_DeadlinePut(ix, OSDeadlineHeap[parent]);
+        ix = parent;
+    }
+    for (;;) {                                         /* Move down while a child is due before us     */
+        child = (INT16U)(ix * 2 + 1);
+        if (child >= OSDeadlineHeapCtr) {
+            break;
+        }
+        if ((child + 1) < OSDeadlineHeapCtr) {         /* Pick the child that is due first             */
+            if ((INT32S)(OSDeadlineHeap[child + 1]->deadline - OSDeadlineHeap[child]->deadline) < 0) {
+                child++;
+            }
+        }
+        if ((INT32S)(OSDeadlineHeap[child]->deadline - ptcb->deadline) >= 0) {
+            break;
+        }
+        OS_DeadlinePut(ix, OSDeadlineHeap[child]);
+        ix = child;
+    }
+    OS_DeadlinePut(ix, ptcb);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      PLACE A TASK IN THE HEAP
+*
+* Description: This function stores a task at position 'ix' of OSDeadlineHeap[] and records the position
+*              in the task's OS_TCB.
+*
+* Arguments  : ix        is the position in the heap.
+*
+*              ptcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_DeadlinePut (INT16U ix, OS_TCB *ptcb)
+{
+    OSDeadlineHeap[ix]    = ptcb;
+    ptcb->OSTCBDeadlineIx = (INT16U)(ix + 1);
+}
+#endif
+
+#if (OS_SCHED_EDF_EN > 0) || (OS_DEADLINE_EN > 0)
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   CHANGE THE DEADLINE OF A TASK
+*
+* Description: This function sets the deadline of a task and updates the EDF and deadline heaps.
+*
+* Arguments  : ptcb      is a pointer to the task's OS_TCB.
+*
+*              deadline  is the new absolute deadline of the task.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_TaskDeadlineSet (OS_TCB *ptcb, INT32U deadline)
+{
+#if OS_SCHED_EDF_EN > 0
+    OS_EdfSet(ptcb, deadline);                         /* Set deadline and reorder EDF heap            */
+#else
+    ptcb->deadline = deadline;
+#endif
+#if OS_DEADLINE_EN > 0
+    if (ptcb->OSTCBDeadlineIx != 0) {                  /* Reorder heap if task is monitored            */
+        OS_DeadlineFix((INT16U)(ptcb->OSTCBDeadlineIx - 1));
+    }
+#endif
+}
+#endif
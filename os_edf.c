@@ -0,0 +1,286 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                   EARLIEST DEADLINE FIRST SCHEDULING
+*
+* File    : OS_EDF.C
+* Version : V2.86
+*
+* Note(s) : A task joins the EDF set the first time its absolute deadline is set (see OS_DEADLINE.C).
+*           The ready EDF tasks are kept in OSEdfHeap[], a binary min-heap ordered by deadline (ties are
+*           broken by priority): OS_RDY_INS() and OS_RDY_DEL() add and remove them in O(log n) and the
+*           root is the task due first.  The bitmap scheduler still decides whether an EDF task should
+*           run at all: when the highest priority ready task is an EDF task, OS_SchedNew() runs the root
+*           instead.  EDF tasks should therefore be given a contiguous band of priorities, below any task
+*           that must always preempt them.
+*
+*           Deadlines are compared as (INT32S)(a - b) so that they keep working across the wrap of the
+*           32-bit tick counter, as long as deadlines are less than 2^31 ticks apart.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_SCHED_EDF_EN > 0
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_EdfBefore(OS_TCB *ptcb1, OS_TCB *ptcb2);
+
+static  void     OS_EdfFix(INT16U ix);
+
+static  void     OS_EdfPut(INT16U ix, OS_TCB *ptcb);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   ADD A READY EDF TASK TO THE HEAP
+*
+* Description: This function is called by OS_RDY_INS() when an EDF task is made ready and places it in
+*              OSEdfHeap[] by deadline.
+*
+* Arguments  : ptcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) A task that is already in the heap is left where it is.
+*********************************************************************************************************
+*/
+
+void  OS_EdfRdy (OS_TCB *ptcb)
+{
+    if (ptcb->OSTCBEdfIx == 0) {                       /* Add task at the bottom of the heap           */
+        OS_EdfPut(OSEdfHeapCtr, ptcb);
+        OSEdfHeapCtr++;
+        OS_EdfFix((INT16U)(OSEdfHeapCtr - 1));
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                FIND EDF TASK WITH THE EARLIEST DEADLINE
+*
+* Description: This function is called by OS_SchedNew() when the highest priority ready task is an EDF task
+*              and returns the priority of the ready EDF task with the earliest deadline.
+*
+* Arguments  : none
+*
+* Returns    : The priority of the task to run.
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+INT8U  OS_EdfSchedNew (void)
+{
+    if (OSEdfHeapCtr == 0) {                           /* Not reached, caller found an EDF task ready  */
+        return (OSPrioHighRdy);
+    }
+    return (OSEdfHeap[0]->OSTCBPrio);                  /* Root is the ready task due first             */
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CHANGE THE DEADLINE OF AN EDF TASK
+*
+* Description: This function sets the deadline of a task, which is scheduled by deadline from now on, and
+*              moves the task to its new place in OSEdfHeap[] if it is ready.
+*
+* Arguments  : ptcb      is a pointer to the task's OS_TCB.
+*
+*              deadline  is the new absolute deadline of the task.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_EdfSet (OS_TCB *ptcb, INT32U deadline)
+{
+    ptcb->deadline = deadline;
+    if (ptcb->OSTCBEdfIx != 0) {                       /* Ready, reorder the heap                      */
+        OS_EdfFix((INT16U)(ptcb->OSTCBEdfIx - 1));
+    } else if (ptcb->OSTCBEdfEn == OS_FALSE) {         /* Joins the EDF tasks                          */
+        ptcb->OSTCBEdfEn = OS_TRUE;
+        if (OS_RDY_TST(ptcb)) {
+            OS_EdfRdy(ptcb);
+        }
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    STOP SCHEDULING A TASK BY DEADLINE
+*
+* Description: This function removes a task from the EDF tasks, e.g. when it is deleted.  The task is
+*              scheduled by priority only.
+*
+* Arguments  : ptcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_EdfUnlink (OS_TCB *ptcb)
+{
+    if (ptcb->OSTCBEdfIx != 0) {
+        OS_EdfUnrdy(ptcb);
+    }
+    ptcb->OSTCBEdfEn = OS_FALSE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                REMOVE A READY EDF TASK FROM THE HEAP
+*
+* Description: This function is called by OS_RDY_DEL() when an EDF task is no longer ready and removes it
+*              from OSEdfHeap[].
+*
+* Arguments  : ptcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The task must be in the heap (OSTCBEdfIx != 0).
+*********************************************************************************************************
+*/
+
+void  OS_EdfUnrdy (OS_TCB *ptcb)
+{
+    INT16U  ix;
+
+
+    ix               = (INT16U)(ptcb->OSTCBEdfIx - 1);
+    ptcb->OSTCBEdfIx = 0;
+    OSEdfHeapCtr--;
+    if (ix != OSEdfHeapCtr) {                          /* Move last task in the hole and reorder       */
+        OS_EdfPut(ix, OSEdfHeap[OSEdfHeapCtr]);
+        OS_EdfFix(ix);
+    }
+    OSEdfHeap[OSEdfHeapCtr] = (OS_TCB *)0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 COMPARE THE DEADLINES OF TWO TASKS
+*
+* Description: This function tells whether a task runs before another one: it is due first or, with the
+*              same deadline, it has the higher priority.
+*
+* Arguments  : ptcb1     is a pointer to the OS_TCB of the first task.
+*
+*              ptcb2     is a pointer to the OS_TCB of the second task.
+*
+* Returns    : OS_TRUE   if the first task runs before the second one.
+*              OS_FALSE  otherwise.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_EdfBefore (OS_TCB *ptcb1, OS_TCB *ptcb2)
+{
+    INT32S  diff;
+
+
+    diff = (INT32S)(ptcb1->deadline - ptcb2->deadline);
+    if (diff < 0) {
+        return (OS_TRUE);
+    }
+    if ((diff == 0) && (ptcb1->OSTCBPrio < ptcb2->OSTCBPrio)) {
+        return (OS_TRUE);
+    }
+    return (OS_FALSE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    RESTORE THE ORDER OF THE HEAP
+*
+* Description: This function moves the task at position 'ix' of OSEdfHeap[] up or down until the heap is
+*              ordered by deadline again.
+*
+* Arguments  : ix        is the position of the task whose deadline changed.
+*
+* Returns    : none
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_EdfFix (INT16U ix)
+{
+    OS_TCB  *ptcb;
+    INT16U   parent;
+    INT16U   child;
+
+
+    ptcb = OSEdfHeap[ix];
+    while (ix > 0) {                                   /* Move up while due before our parent          */
+        parent = (INT16U)((ix - 1) / 2);
+        if (OS_EdfBefore(ptcb, OSEdfHeap[parent]) == OS_FALSE) {
+            break;
+        }
+        OS_EdfPut(ix, OSEdfHeap[parent]);
+        ix = parent;
+    }
+    for (;;) {                                         /* Move down while a child is due before us     */
+        child = (INT16U)(ix * 2 + 1);
+        if (child >= OSEdfHeapCtr) {
+            break;
+        }
+        if ((child + 1) < OSEdfHeapCtr) {              /* Pick the child that is due first             */
+            if (OS_EdfBefore(OSEdfHeap[child + 1], OSEdfHeap[child]) == OS_TRUE) {
+                child++;
+            }
+        }
+        if (OS_EdfBefore(OSEdfHeap[child], ptcb) == OS_FALSE) {
+            break;
+        }
+        OS_EdfPut(ix, OSEdfHeap[child]);
+        ix = child;
+    }
+    OS_EdfPut(ix, ptcb);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      PLACE A TASK IN THE HEAP
+*
+* Description: This function stores a task at position 'ix' of OSEdfHeap[] and records the position in the
+*              task's OS_TCB.
+*
+* Arguments  : ix        is the position in the heap.
+*
+*              ptcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_EdfPut (INT16U ix, OS_TCB *ptcb)
+{
+    OSEdfHeap[ix]    = ptcb;
+    ptcb->OSTCBEdfIx = (INT16U)(ix + 1);
+}
+#endif                                                 /* OS_SCHED_EDF_EN                              */
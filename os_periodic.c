@@ -0,0 +1,355 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                            PERIODIC TASKS
+*
+* File    : OS_PERIODIC.C
+* Version : V2.86
+*
+* Note(s) : 1) A periodic task is described by its computation time (C), period (T), relative deadline (D)
+*              and phase.  The kernel releases job 'n' at time 'phase + n * T' (counted from the creation of
+*              the task) and sets the absolute deadline of the job to its release time plus D.  Releases are
+*              computed from the previous release, not from the time the job completed, so they never drift.
+*
+*           2) The task body is called once per job.  It either returns when the job is complete or calls
+*              OSTaskJobEnd() itself from an endless loop.
+*
+*           3) When a job completes after the release of the next one, the releases that have already passed
+*              are skipped (see OSJobSkipCtr) so that the task keeps its phase.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_TaskJobWait(void);
+
+static  void  OS_TaskPeriodic(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        CREATE A PERIODIC TASK
+*
+* Description: This function creates a task whose jobs are released by the kernel every 'period' ticks.
+*              The task is created with OSTaskCreateExt() and accepts the same arguments plus the timing
+*              parameters of the task.
+*
+* Arguments  : task      is a pointer to the body of each job.  The function is called with 'p_arg' for every
+*                        job and should return when the job is complete.
+*
+*              p_arg     is a pointer to an optional data area passed to 'task' for every job.
+*
+*              ptos, prio, id, pbos, stk_size, pext and opt
+*                        are passed to OSTaskCreateExt() (see OS_TASK.C).
+*
+*              comp      is the computation time of each job (in ticks).  OSTCBCur->compTime is reloaded
+*                        with this value when each job is released.
+*
+*              period    is the period of the task (in ticks).
+*
+*              deadline  is the relative deadline of each job (in ticks).  If 0, the deadline is the end of
+*                        the period.
+*
+*              phase     is the delay (in ticks) between the creation of the task and its first release.
+*
+* Returns    : OS_ERR_TASK_PERIOD       if 'period' is 0.
+*              OS_ERR_TASK_CREATE_ISR   if you tried to create a task from an ISR.
+*              Otherwise, the error code returned by OSTaskCreateExt().
+*
+* Notes      : 1) The scheduler is locked while the task is created so that the task cannot run before its
+*                 timing parameters are set.
+*              2) When OS_DEADLINE_EN is 1, the task is registered with the deadline miss monitor.
+*              3) 'period' is checked even when OS_ARG_CHK_EN is 0: OSTaskJobEnd() divides by it.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskCreatePeriodic (void   (*task)(void *p_arg),
+                             void    *p_arg,
+                             OS_STK  *ptos,
+                             INT8U    prio,
+                             INT16U   id,
+                             OS_STK  *pbos,
+                             INT32U   stk_size,
+                             void    *pext,
+                             INT16U   opt,
+                             INT8U    comp,
+                             INT16U   period,
+                             INT16U   deadline,
+                             INT16U   phase)
+{
+    OS_TCB    *ptcb;
+    INT32U     release;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (period == 0) {                                 /* A periodic task needs a period, see Note #3  */
+        return (OS_ERR_TASK_PERIOD);
+    }
+    if (OSIntNesting > 0) {                            /* Make sure we don't create the task from ISR  */
+        return (OS_ERR_TASK_CREATE_ISR);
+    }
+    if (deadline == 0) {                               /* Implicit deadline, end of the period         */
+        deadline = period;
+    }
+    OSSchedLock();                                     /* Task must not run before it is set up        */
+    err = OSTaskCreateExt(OS_TaskPeriodic, p_arg, ptos, prio, id, pbos, stk_size, pext, opt);
+    if (err == OS_ERR_NONE) {
+        OS_ENTER_CRITICAL();
+        ptcb                   = OSTCBList;            /* Task just created heads the TCB list         */
+        release                = OSTime + (INT32U)phase;
+        ptcb->OSTCBJobFnct     = task;
+        ptcb->OSTCBJobRelease  = release;
+        ptcb->OSTCBJobCtr      = 0L;
+        ptcb->OSTCBJobSkipCtr  = 0L;
+        ptcb->OSTCBJobDeadline = deadline;
+        ptcb->OSTCBJobRespLast = 0;
+        ptcb->OSTCBJobRespMin  = 0xFFFF;
+        ptcb->OSTCBJobRespMax  = 0;
+        ptcb->OSTCBJobComp     = comp;
+        ptcb->compTime         = comp;
+        ptcb->period           = period;
+#if (OS_SCHED_EDF_EN > 0) && (OS_DEADLINE_EN == 0)
+        OS_TaskDeadlineSet(ptcb, release + (INT32U)deadline);
+#else
+        ptcb->deadline         = release + (INT32U)deadline;
+#endif
+        OS_EXIT_CRITICAL();
+#if OS_DEADLINE_EN > 0
+        (void)OSTaskPeriodSet(prio, period, release + (INT32U)deadline);
+#endif
+    }
+    OSSchedUnlock();
+    return (err);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      END THE CURRENT JOB OF A TASK
+*
+* Description: This function is called by a periodic task when its current job is complete.  The response
+*              time of the job is recorded, the deadline and computation time of the next job are set and the
+*              task is delayed until the next job is released.
+*
+* Arguments  : none
+*
+* Returns    : OS_ERR_NONE               if the next job was released.
+*              OS_ERR_TIME_DLY_ISR       if called from an ISR.
+*              OS_ERR_TASK_NOT_PERIODIC  if the calling task was not created by OSTaskCreatePeriodic().
+*
+* Notes      : 1) Tasks whose body returns at the end of each job don't need to call this function.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskJobEnd (void)
+{
+    OS_TCB    *ptcb;
+    INT32U     late;
+    INT32U     skip;
+    INT32U     resp;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                            /* See if trying to call from an ISR            */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBCur;
+    if ((ptcb->OSTCBJobFnct == (void (*)(void *))0) || (ptcb->period == 0)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    resp = OSTime - ptcb->OSTCBJobRelease;             /* Response time of the job                     */
+    if (resp > 0xFFFFL) {
+        resp = 0xFFFFL;
+    }
+    ptcb->OSTCBJobRespLast = (INT16U)resp;
+    if (ptcb->OSTCBJobRespMin > (INT16U)resp) {
+        ptcb->OSTCBJobRespMin = (INT16U)resp;
+    }
+    if (ptcb->OSTCBJobRespMax < (INT16U)resp) {
+        ptcb->OSTCBJobRespMax = (INT16U)resp;
+    }
+    ptcb->OSTCBJobCtr++;
+    ptcb->OSTCBJobRelease += (INT32U)ptcb->period;     /* Next release, one period after the last one  */
+    late = OSTime - ptcb->OSTCBJobRelease;
+    if ((INT32S)late > 0) {                            /* Skip the releases that have already passed   */
+        skip                   = (late + ptcb->period - 1) / ptcb->period;
+        ptcb->OSTCBJobRelease += skip * (INT32U)ptcb->period;
+        ptcb->OSTCBJobSkipCtr += skip;
+    }
+#if (OS_SCHED_EDF_EN > 0) || (OS_DEADLINE_EN > 0)
+    OS_TaskDeadlineSet(ptcb, ptcb->OSTCBJobRelease + (INT32U)ptcb->OSTCBJobDeadline);
+#else
+    ptcb->deadline = ptcb->OSTCBJobRelease + (INT32U)ptcb->OSTCBJobDeadline;
+#endif
+    ptcb->compTime = ptcb->OSTCBJobComp;               /* Reload computation time of the next job      */
+    OS_EXIT_CRITICAL();
+    OS_TaskJobWait();                                  /* Wait for the next release                    */
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    OBTAIN THE JOB STATISTICS OF A TASK
+*
+* Description: This function returns the response time statistics of a periodic task.
+*
+* Arguments  : prio        is the priority of the task.  If you specify OS_PRIO_SELF, the statistics of the
+*                          calling task are returned.
+*
+*              p_job_data  is a pointer to a structure of type OS_JOB_DATA that will receive the statistics.
+*
+* Returns    : OS_ERR_NONE               if the statistics were copied.
+*              OS_ERR_PRIO_INVALID       if the priority is higher than the maximum allowed.
+*              OS_ERR_PDATA_NULL         if 'p_job_data' is a NULL pointer.
+*              OS_ERR_TASK_NOT_EXIST     if the task does not exist.
+*              OS_ERR_TASK_NOT_PERIODIC  if the task was not created by OSTaskCreatePeriodic().
+*
+* Notes      : 1) OSJobRespMin and OSJobJitter are 0 until the first job completes.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskJobQuery (INT8U prio, OS_JOB_DATA *p_job_data)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                       /* Make sure task priority is valid             */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (p_job_data == (OS_JOB_DATA *)0) {              /* Validate 'p_job_data'                        */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if querying ourself                      */
+        prio = OSTCBCur->OSTCBPrio;
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if (ptcb == (OS_TCB *)0) {                         /* Task must exist                              */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb == OS_TCB_RESERVED) {                     /* Priority may only be reserved by a mutex     */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb->OSTCBJobFnct == (void (*)(void *))0) {   /* Task must be periodic                        */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    p_job_data->OSJobCtr      = ptcb->OSTCBJobCtr;
+    p_job_data->OSJobSkipCtr  = ptcb->OSTCBJobSkipCtr;
+    p_job_data->OSJobRelease  = ptcb->OSTCBJobRelease;
+    p_job_data->OSJobRespLast = ptcb->OSTCBJobRespLast;
+    p_job_data->OSJobRespMax  = ptcb->OSTCBJobRespMax;
+    if (ptcb->OSTCBJobCtr > 0L) {
+        p_job_data->OSJobRespMin = ptcb->OSTCBJobRespMin;
+        p_job_data->OSJobJitter  = ptcb->OSTCBJobRespMax - ptcb->OSTCBJobRespMin;
+    } else {
+        p_job_data->OSJobRespMin = 0;
+        p_job_data->OSJobJitter  = 0;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    WAIT FOR THE RELEASE OF THE NEXT JOB
+*
+* Description: This function delays the calling task until the release time of its next job.  The delay is
+*              computed from the absolute release time so that time spent preempted before this point does not
+*              shift the release.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) The task is delayed with OSTimeDly(), so it waits in the delay list like any other delayed
+*                 task (see OS_DLY_LIST_EN) and can be woken up early by OSTimeDlyResume().
+*              2) A release more than 65535 ticks away is waited for with several delays.
+*              3) When the next job is already released, the scheduler still runs: the new deadline of the
+*                 task may let another EDF task run first.
+*********************************************************************************************************
+*/
+
+static  void  OS_TaskJobWait (void)
+{
+    INT32S     ticks;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ticks = (INT32S)(OSTCBCur->OSTCBJobRelease - OSTime);
+    OS_EXIT_CRITICAL();
+    if (ticks <= 0) {                                  /* Next job already released, see Note #3       */
+        OS_Sched();
+        return;
+    }
+    while (ticks > 0) {                                /* Delay until the release, see Note #2         */
+        if (ticks > 65535L) {
+            ticks = 65535L;
+        }
+        OSTimeDly((INT16U)ticks);
+        OS_ENTER_CRITICAL();
+        ticks = (INT32S)(OSTCBCur->OSTCBJobRelease - OSTime);
+        OS_EXIT_CRITICAL();
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           PERIODIC TASK BODY
+*
+* Description: This function is the task created by OSTaskCreatePeriodic().  It waits for the first release
+*              and then runs one job per period.
+*
+* Arguments  : p_arg     is the argument passed to each job.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_TaskPeriodic (void *p_arg)
+{
+    OS_TaskJobWait();                                  /* Wait for the first release (phase)           */
+    for (;;) {
+        (*OSTCBCur->OSTCBJobFnct)(p_arg);              /* Run one job ...                              */
+        (void)OSTaskJobEnd();                          /* ... and wait for the next release            */
+    }
+}
+#endif                                                 /* OS_TASK_PERIODIC_EN                          */
@@ -0,0 +1,236 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                 BATCHED SEMAPHORE AND QUEUE POSTS
+*
+* File    : OS_POSTN.C
+* Version : V2.86
+*
+* Note(s) : 1) OSSemPostN() and OSQPostN() do the work of several OSSemPost() or OSQPost() calls in one
+*              critical section: every waiting task that can be satisfied is made ready, the rest is
+*              added to the semaphore count or to the queue, and the scheduler is called once at the end
+*              (and only if a task was made ready).  A task posting a burst of samples thus no longer
+*              enters OS_Sched() once per sample.
+*
+*           2) Interrupts stay disabled while the whole batch is posted.  The interrupt latency grows
+*              with the number of messages and of tasks made ready: keep batches short, or post from an
+*              ISR with OSRingPost() (see OS_RING.C) instead.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_SEM_EN > 0) && (OS_SEM_POST_N_EN > 0) && (OS_SCHED_RR_EN == 0)
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT16U  OS_PostNWaitCnt(OS_EVENT *pevent);
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     POST SEVERAL MESSAGES TO A QUEUE
+*
+* Description: This function sends 'nmsgs' messages to a queue, as 'nmsgs' calls to OSQPost() would: the
+*              first messages go to the tasks waiting on the queue, highest priority first, one message
+*              per task, and the following ones are appended to the queue.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to an array of 'nmsgs' messages.  NULL pointers may be posted.
+*
+*              nmsgs         is the number of messages to post.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         All the messages were posted.
+*                            OS_ERR_Q_FULL       If the queue was filled before all the messages were
+*                                                posted: the remaining ones were NOT posted.
+*                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a queue.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*                            OS_ERR_PDATA_NULL   If 'pmsgs' is a NULL pointer.
+*
+* Returns    : The number of messages posted, from the start of 'pmsgs'.
+*********************************************************************************************************
+*/
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0) && (OS_Q_POST_N_EN > 0)
+INT16U  OSQPostN (OS_EVENT *pevent, void **pmsgs, INT16U nmsgs, INT8U *perr)
+{
+    OS_Q      *pq;
+    INT16U     nposted;
+    BOOLEAN    sched;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                         /* Validate 'pmsgs'                             */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    nposted = 0;
+    sched   = OS_FALSE;
+    OS_ENTER_CRITICAL();
+    while ((nposted < nmsgs) && (pevent->OSEventGrp != 0)) {   /* Give messages to the waiting tasks  */
+        if (OS_EventTaskRdy(pevent, pmsgs[nposted], OS_STAT_Q, OS_STAT_PEND_OK) == OS_PRIO_SELF) {
+            break;                                     /* Only stale entries were left                 */
+        }
+        nposted++;
+        sched = OS_TRUE;
+    }
+    pq = (OS_Q *)pevent->OSEventPtr;                   /* Queue the others                             */
+    while ((nposted < nmsgs) && (pq->OSQEntries < pq->OSQSize)) {
+        *pq->OSQIn++ = pmsgs[nposted];
+        if (pq->OSQIn == pq->OSQEnd) {                 /* Wrap IN ptr if we are at end of queue        */
+            pq->OSQIn = pq->OSQStart;
+        }
+        pq->OSQEntries++;
+        nposted++;
+    }
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+    }
+    if (nposted < nmsgs) {
+        *perr = OS_ERR_Q_FULL;
+    } else {
+        *perr = OS_ERR_NONE;
+    }
+    return (nposted);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    SIGNAL A SEMAPHORE SEVERAL TIMES
+*
+* Description: This function signals a semaphore 'cnt' times, as 'cnt' calls to OSSemPost() would: up to
+*              'cnt' of the tasks waiting on the semaphore are made ready, highest priority first, and
+*              the remaining units are added to the semaphore count.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired
+*                            semaphore.
+*
+*              cnt           is the number of units to post.
+*
+* Returns    : OS_ERR_NONE         The call was successful and the semaphore was signaled.
+*              OS_ERR_SEM_OVF      If the units left once the waiting tasks were made ready would overflow
+*                                  the semaphore count.  The tasks were made ready but the count was NOT
+*                                  changed.
+*              OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a semaphore.
+*              OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*
+* Note(s)    : 1) When 'cnt' covers all the waiting tasks (a barrier release), they are made ready at once by
+*                 OS_EventTaskRdyAll() instead of one OS_EventTaskRdy() call per task.
+*              2) With OS_SCHED_RR_EN, a bit of the wait list may stand for several tasks sharing a
+*                 priority: the tasks are always made ready one at a time.
+*********************************************************************************************************
+*/
+
+#if (OS_SEM_EN > 0) && (OS_SEM_POST_N_EN > 0)
+INT8U  OSSemPostN (OS_EVENT *pevent, INT16U cnt)
+{
+    BOOLEAN    sched;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SEM) {    /* Validate event block type                    */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    sched = OS_FALSE;
+    err   = OS_ERR_NONE;
+    OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN == 0
+    if ((cnt > 0) && (pevent->OSEventGrp != 0) && (cnt >= OS_PostNWaitCnt(pevent))) {
+        cnt  -= OS_EventTaskRdyAll(pevent, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
+        sched = OS_TRUE;
+    }
+#endif
+    while ((cnt > 0) && (pevent->OSEventGrp != 0)) {   /* Ready as many waiting tasks as units         */
+        if (OS_EventTaskRdy(pevent, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK) == OS_PRIO_SELF) {
+            break;                                     /* Only stale entries were left                 */
+        }
+        cnt--;
+        sched = OS_TRUE;
+    }
+    if (cnt > 0) {
+        if (pevent->OSEventCnt <= (65535u - cnt)) {    /* Make sure semaphore will not overflow        */
+            pevent->OSEventCnt += cnt;                 /* Increment semaphore count to register event  */
+        } else {
+            err = OS_ERR_SEM_OVF;
+        }
+    }
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+    }
+    return (err);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 COUNT THE TASKS WAITING FOR AN EVENT
+*
+* Description: This function returns the number of tasks in the wait list of an event.
+*
+* Arguments  : pevent        is a pointer to the event control block.
+*
+* Returns    : The number of tasks waiting.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if (OS_SEM_EN > 0) && (OS_SEM_POST_N_EN > 0) && (OS_SCHED_RR_EN == 0)
+static  INT16U  OS_PostNWaitCnt (OS_EVENT *pevent)
+{
+    OS_PRIO_ROW  bits;
+    INT16U       nbr;
+    INT8U        y;
+
+
+    nbr = 0;
+    for (y = 0; y < OS_EVENT_TBL_SIZE; y++) {
+        bits = pevent->OSEventTbl[y];
+        while (bits != 0) {                            /* Count the bits set in the row                */
+            bits &= bits - 1;
+            nbr++;
+        }
+    }
+    return (nbr);
+}
+#endif
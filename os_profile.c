@@ -0,0 +1,445 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                             CPU PROFILING
+*
+* File    : OS_PROFILE.C
+* Version : V2.86
+*
+* Note(s) : 1) The port provides OS_CPU_CYCLES_GET(), which reads a free running counter (e.g. the CPU cycle
+*              counter or a high resolution timer) of type OS_CPU_CYCLES.  Every context switch, outermost
+*              ISR entry and ISR exit reads the counter and charges the cycles elapsed since the previous
+*              reading to the task that was running (OSTCBCyclesTot) or to the ISRs (OSProfileIntCycles).
+*              The run time of a task therefore excludes the time spent in the ISRs that interrupted it,
+*              unlike OSTCBCur->compTime and OS_BUDGET.C which charge whole ticks.
+*
+*           2) The kernel overhead is measured as the time spent in OSTimeTick() and the time spent in
+*              OS_Sched() up to a context switch.  Both are also included in the time of the ISR or task that
+*              called them.
+*
+*           3) ISR time is only measured for ISRs that call OSIntEnter().  An ISR that increments OSIntNesting
+*              directly is charged to the task it interrupted.
+*
+*           4) Differences of counter values are correct across a wrap of the counter, but the totals wrap
+*              too: read them (see OSProfileSnap()) and reset them (see OSProfileReset()) often enough, or
+*              make OS_CPU_CYCLES a 64-bit type.
+*
+*           5) With OS_STAT_LOAD_EN set to 1, the statistic task samples the run time of every task every
+*              1/10 second (see OS_LoadUpdate()).  The load of a task over a window is its run time divided by
+*              the time elapsed, in units of 0.01 %.  The CPU load (OSCPULoad[]) is 100 % minus the load of
+*              the idle task, so it includes the ISRs and it remains exact when the idle task sleeps with the
+*              tick suppressed (OS_TICKLESS_EN) or when the CPU clock changes.  The 1 second load is the
+*              average of the last ten 1/10 second loads and the 10 second load the average of the last ten
+*              1 second loads: they are updated once per second and once every 10 seconds respectively.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_PROFILE_EN > 0
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+#if OS_STAT_LOAD_EN > 0
+static  INT16U  OS_LoadCalc(OS_CPU_CYCLES cycles, OS_CPU_CYCLES elapsed);
+
+static  void    OS_LoadSample(OS_LOAD *pload, OS_CPU_CYCLES cycles, OS_CPU_CYCLES elapsed);
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         RESET THE CPU PROFILE
+*
+* Description: This function clears the run time and context switch counter of every task and the ISR and
+*              kernel overhead counters, and starts a new profiling period.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) OSStart() calls this function before running the first task.
+*              2) OSCtxSwCtr, which is cleared every second by the statistic task, is not affected.
+*********************************************************************************************************
+*/
+
+void  OSProfileReset (void)
+{
+    OS_TCB        *ptcb;
+    OS_CPU_CYCLES  now;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    now  = OS_CPU_CYCLES_GET();
+    ptcb = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {                      /* Clear the counters of every task             */
+        ptcb->OSTCBCyclesTot = 0;
+        ptcb->OSTCBCtxSwCtr  = 0;
+#if OS_STAT_LOAD_EN > 0
+        ptcb->OSTCBLoadCycles = 0;
+        OS_MemClr((INT8U *)&ptcb->OSTCBLoad, sizeof(OS_LOAD));
+#endif
+        ptcb = ptcb->OSTCBNext;
+    }
+    if (OSTCBCur != (OS_TCB *)0) {                     /* The running task (or ISR) starts now         */
+        OSTCBCur->OSTCBCyclesStart = now;
+    }
+    OSProfileIntStart          = now;
+    OSProfileStart             = now;
+    OSProfileIntCycles         = 0;
+    OSProfileTickCycles        = 0;
+    OSProfileSchedCycles       = 0;
+    OSProfileIntCtr            = 0;
+    OSProfileCtxSwCtr          = 0;
+#if OS_STAT_LOAD_EN > 0
+    OSLoadTime                 = now;              /* Restart the load windows                     */
+    OSLoadCtr                  = 0;
+    OS_MemClr((INT8U *)&OSCPULoad[0], sizeof(OSCPULoad));
+#endif
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     TAKE A SNAPSHOT OF THE CPU PROFILE
+*
+* Description: This function copies the CPU profile at the time of the call: the time elapsed since the
+*              profile was started, the time spent in ISRs and in the kernel, and the run time of each task.
+*
+* Arguments  : psnap     is a pointer to the snapshot to fill in.  The entries of OSProfileTaskCycles[] and
+*                        OSProfileTaskCtxSwCtr[] of the priorities that have no task are 0.
+*
+* Returns    : OS_ERR_NONE         if the snapshot was taken.
+*              OS_ERR_PDATA_NULL   if 'psnap' is a NULL pointer.
+*
+* Notes      : 1) The running task (or the ISR, if called from an ISR) is charged up to the time of the call,
+*                 so that the sum of the task and ISR times is OSProfileTotal.
+*              2) Interrupts are disabled while the task list is walked.
+*              3) OS_PROFILE_SNAP holds two entries per priority: with a large OS_LOWEST_PRIO, do not place it
+*                 on a small task stack.
+*********************************************************************************************************
+*/
+
+INT8U  OSProfileSnap (OS_PROFILE_SNAP *psnap)
+{
+    OS_TCB        *ptcb;
+    OS_CPU_CYCLES  now;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (psnap == (OS_PROFILE_SNAP *)0) {               /* Validate 'psnap'                             */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_MemClr((INT8U *)psnap, sizeof(OS_PROFILE_SNAP));
+    OS_ENTER_CRITICAL();
+    now  = OS_CPU_CYCLES_GET();
+    ptcb = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {
+        psnap->OSProfileTaskCycles[ptcb->OSTCBPrio]   = ptcb->OSTCBCyclesTot;
+        psnap->OSProfileTaskCtxSwCtr[ptcb->OSTCBPrio] = ptcb->OSTCBCtxSwCtr;
+        ptcb = ptcb->OSTCBNext;
+    }
+    psnap->OSProfileTotal    = now - OSProfileStart;
+    psnap->OSProfileInt      = OSProfileIntCycles;
+    psnap->OSProfileTick     = OSProfileTickCycles;
+    psnap->OSProfileSched    = OSProfileSchedCycles;
+    psnap->OSProfileIntCtr   = OSProfileIntCtr;
+    psnap->OSProfileCtxSwCtr = OSProfileCtxSwCtr;
+    if (OSIntNesting > 0) {                            /* Add the slice in progress                    */
+        psnap->OSProfileInt += now - OSProfileIntStart;
+    } else if (OSRunning == OS_TRUE) {
+        psnap->OSProfileTaskCycles[OSPrioCur] += now - OSTCBCur->OSTCBCyclesStart;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        GET THE CPU LOAD OF A TASK
+*
+* Description: This function returns the share of the CPU used by a task over one of the load windows.
+*
+* Arguments  : prio      is the priority of the task.  If you specify OS_PRIO_SELF, the load of the calling
+*                        task is returned.
+*
+*              win       is the window: OS_LOAD_WIN_100MS, OS_LOAD_WIN_1S or OS_LOAD_WIN_10S.
+*
+*              pload     is a pointer to where the load is stored, in units of 0.01 % (0 to 10000).  The load
+*                        is 0 until the first window has elapsed.
+*
+* Returns    : OS_ERR_NONE            if the load was returned.
+*              OS_ERR_PRIO_INVALID    if the priority is higher than the maximum allowed.
+*              OS_ERR_INVALID_OPT     if 'win' is not valid.
+*              OS_ERR_PDATA_NULL      if 'pload' is a NULL pointer.
+*              OS_ERR_TASK_NOT_EXIST  if the task does not exist.
+*
+* Notes      : 1) The load of the whole CPU over each window is OSCPULoad[win].
+*********************************************************************************************************
+*/
+
+#if OS_STAT_LOAD_EN > 0
+INT8U  OSTaskLoadGet (INT8U prio, INT8U win, INT16U *pload)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (win >= OS_LOAD_NWIN) {
+        return (OS_ERR_INVALID_OPT);
+    }
+    if (pload == (INT16U *)0) {                        /* Validate 'pload'                             */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if getting our own load                  */
+        prio = OSTCBCur->OSTCBPrio;
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    *pload = ptcb->OSTCBLoad.OSLoad[win];
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          OUTERMOST ISR ENTRY
+*
+* Description: This function charges the interrupted task up to now and starts timing the ISR.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Called by OSIntEnter(), with interrupts disabled, when OSIntNesting becomes 1.
+*********************************************************************************************************
+*/
+
+void  OS_ProfileIntEnter (void)
+{
+    OS_CPU_CYCLES  now;
+
+
+    now                       = OS_CPU_CYCLES_GET();
+    OSTCBCur->OSTCBCyclesTot += now - OSTCBCur->OSTCBCyclesStart;
+    OSProfileIntStart         = now;
+    OSProfileIntCtr++;
+}
+
+/*
+*********************************************************************************************************
+*                                          OUTERMOST ISR EXIT
+*
+* Description: This function charges the ISR time and resumes timing the interrupted task.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Called by OSIntExit(), with interrupts disabled, when OSIntNesting becomes 0 and before the
+*                 scheduling decision: a switch to another task is charged to the interrupted task.
+*********************************************************************************************************
+*/
+
+void  OS_ProfileIntExit (void)
+{
+    OS_CPU_CYCLES  now;
+
+
+    now                         = OS_CPU_CYCLES_GET();
+    OSProfileIntCycles         += now - OSProfileIntStart;
+    OSTCBCur->OSTCBCyclesStart  = now;
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            CONTEXT SWITCH
+*
+* Description: This function charges the task switched out up to now and starts timing OSTCBHighRdy.
+*
+* Arguments  : ts        is the value of the cycle counter when the scheduling decision started.  The time
+*                        elapsed since is added to the scheduler overhead.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Called by OS_Sched() and OSIntExit(), with interrupts disabled, just before the switch.
+*********************************************************************************************************
+*/
+
+void  OS_ProfileSw (OS_CPU_CYCLES ts)
+{
+    OS_CPU_CYCLES  now;
+
+
+    now                            = OS_CPU_CYCLES_GET();
+    OSProfileSchedCycles          += now - ts;
+    OSTCBCur->OSTCBCyclesTot      += now - OSTCBCur->OSTCBCyclesStart;
+    OSTCBHighRdy->OSTCBCyclesStart = now;
+    OSProfileCtxSwCtr++;
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           SAMPLE THE CPU LOADS
+*
+* Description: This function computes the load of every task and of the CPU over the time elapsed since the
+*              previous call, and completes the 1 second and 10 second windows.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Called by OS_TaskStat() every 1/10 second.
+*              3) Interrupts are enabled between tasks, as in OSTimeTick().  The run time of a task that runs
+*                 while the list is walked is counted in this sample or in the next one, never twice.
+*********************************************************************************************************
+*/
+
+#if OS_STAT_LOAD_EN > 0
+void  OS_LoadUpdate (void)
+{
+    OS_TCB        *ptcb;
+    OS_CPU_CYCLES  elapsed;
+    OS_CPU_CYCLES  cycles;
+    OS_CPU_CYCLES  now;
+    INT8U          i;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    now        = OS_CPU_CYCLES_GET();
+    elapsed    = now - OSLoadTime;
+    OSLoadTime = now;
+    if (OSLoadCtr >= 100u) {                           /* Start a new 10 second window                 */
+        OSLoadCtr = 0;
+    }
+    OSLoadCtr++;
+    ptcb = OSTCBList;
+    OS_EXIT_CRITICAL();
+    while (ptcb != (OS_TCB *)0) {                      /* Go through all TCBs in TCB list              */
+        OS_ENTER_CRITICAL();
+        cycles = ptcb->OSTCBCyclesTot;
+        if (ptcb == OSTCBCur) {                        /* Add the slice in progress                    */
+            cycles += OS_CPU_CYCLES_GET() - ptcb->OSTCBCyclesStart;
+        }
+        OS_LoadSample(&ptcb->OSTCBLoad, cycles - ptcb->OSTCBLoadCycles, elapsed);
+        ptcb->OSTCBLoadCycles = cycles;
+        ptcb = ptcb->OSTCBNext;
+        OS_EXIT_CRITICAL();
+    }
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBPrioTbl[OS_TASK_IDLE_PRIO];            /* The CPU is busy when the idle task is not    */
+    for (i = 0; i < OS_LOAD_NWIN; i++) {
+        if ((i == OS_LOAD_WIN_100MS) ||
+            ((i == OS_LOAD_WIN_1S)  && ((OSLoadCtr % 10u) == 0)) ||
+            ((i == OS_LOAD_WIN_10S) && (OSLoadCtr == 100u))) {
+            OSCPULoad[i] = 10000u - ptcb->OSTCBLoad.OSLoad[i];
+        }
+    }
+    OSCPUUsage = (INT8U)((OSCPULoad[OS_LOAD_WIN_100MS] + 50u) / 100u);
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       LOAD OF A TASK OVER A SAMPLE
+*
+* Description: This function returns 'cycles' as a fraction of 'elapsed', in units of 0.01 %.
+*
+* Arguments  : cycles    is the run time of the task during the sample.
+*
+*              elapsed   is the length of the sample.
+*
+* Returns    : The load, 0 to 10000.
+*
+* Notes      : 1) Both values are scaled down to 18 bits so that the product fits in 32 bits, whatever the
+*                 size of OS_CPU_CYCLES.  The result is still exact to better than 0.01 %.
+*********************************************************************************************************
+*/
+
+static  INT16U  OS_LoadCalc (OS_CPU_CYCLES cycles, OS_CPU_CYCLES elapsed)
+{
+    while (elapsed > 0x3FFFFu) {                       /* Keep cycles * 10000 within 32 bits           */
+        elapsed >>= 1;
+        cycles  >>= 1;
+    }
+    if (elapsed == 0) {
+        return (0);
+    }
+    if (cycles >= elapsed) {
+        return (10000u);
+    }
+    return ((INT16U)((INT32U)cycles * 10000uL / (INT32U)elapsed));
+}
+
+/*
+*********************************************************************************************************
+*                                      ADD A SAMPLE TO A TASK'S LOADS
+*
+* Description: This function sets the 1/10 second load of a task and, at the end of a second (of 10 seconds),
+*              its 1 second (10 second) load.
+*
+* Arguments  : pload     is a pointer to the loads of the task.
+*
+*              cycles    is the run time of the task during the sample.
+*
+*              elapsed   is the length of the sample.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_LoadSample (OS_LOAD *pload, OS_CPU_CYCLES cycles, OS_CPU_CYCLES elapsed)
+{
+    pload->OSLoad[OS_LOAD_WIN_100MS]     = OS_LoadCalc(cycles, elapsed);
+    pload->OSLoadSum[OS_LOAD_WIN_100MS] += pload->OSLoad[OS_LOAD_WIN_100MS];
+    if ((OSLoadCtr % 10u) == 0) {                      /* End of a second                              */
+        pload->OSLoad[OS_LOAD_WIN_1S]        = (INT16U)(pload->OSLoadSum[OS_LOAD_WIN_100MS] / 10u);
+        pload->OSLoadSum[OS_LOAD_WIN_100MS]  = 0;
+        pload->OSLoadSum[OS_LOAD_WIN_1S]    += pload->OSLoad[OS_LOAD_WIN_1S];
+        if (OSLoadCtr == 100u) {                       /* End of 10 seconds                            */
+            pload->OSLoad[OS_LOAD_WIN_10S]   = (INT16U)(pload->OSLoadSum[OS_LOAD_WIN_1S] / 10u);
+            pload->OSLoadSum[OS_LOAD_WIN_1S] = 0;
+        }
+    }
+}
+#endif
+#endif
@@ -0,0 +1,299 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                   LOCK-FREE SINGLE PRODUCER RINGS
+*
+* File    : OS_RING.C
+* Version : V2.86
+*
+* Note(s) : 1) A ring passes message pointers from ONE producer (typically an ISR) to ONE consumer task
+*              without disabling interrupts.  The producer only writes OSRingIn and the consumer only
+*              writes OSRingOut.  Each side reads the other side's index with acquire semantics
+*              (OS_CPU_LOAD_ACQ()) and publishes its own with release semantics (OS_CPU_STORE_REL()), so
+*              a message is stored before the consumer sees it and read before the producer reuses its
+*              entry.  The defaults of these macros are volatile accesses, which is enough on a CPU
+*              that does not reorder memory accesses; a port may use its atomics or barriers instead.
+*
+*           2) OSRingPost() and OSRingAccept() never enter a critical section.  A ring created with
+*              OS_RING_OPT_PEND also has a semaphore the consumer may wait on with OSRingPend().  The
+*              consumer only sets OSRingWait, in a critical section, when it found the ring empty; the
+*              producer posts the semaphore (and readies the consumer) only if OSRingWait is set, and
+*              clears it.  A burst of messages thus readies the consumer at most once, and messages
+*              posted while the consumer runs cost no kernel call at all.
+*
+*           3) The wake-up relies on the producer and the consumer running on the same CPU, as all of
+*              uC/OS-II does: the consumer's critical section cannot interleave with a post.
+*
+*           4) Rings are allocated by the application (they are not taken from a pool) and are meant to
+*              be created once, at initialization.  A ring holds at most 'size' messages, where 'size'
+*              is a power of 2.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_RING_EN > 0
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_RingGet(OS_RING *pring, void **pmsg);
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      ACCEPT A MESSAGE FROM A RING
+*
+* Description: This function checks the ring to see if a message is available.  Unlike OSRingPend(),
+*              OSRingAccept() does not suspend the calling task if a message is not available.
+*
+* Arguments  : pring         is a pointer to the ring.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received a message.
+*                            OS_ERR_PDATA_NULL   If 'pring' is a NULL pointer
+*                            OS_ERR_Q_EMPTY      The ring did not contain any messages
+*
+* Returns    : The message removed from the ring or a NULL pointer if the ring was empty.
+*
+* Note(s)    : 1) Only the consumer of the ring may call this function.  Interrupts are not disabled.
+*********************************************************************************************************
+*/
+
+void  *OSRingAccept (OS_RING *pring, INT8U *perr)
+{
+    void  *pmsg;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return ((void *)0);
+    }
+    if (pring == (OS_RING *)0) {                       /* Validate 'pring'                             */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (OS_RingGet(pring, &pmsg) == OS_FALSE) {
+        *perr = OS_ERR_Q_EMPTY;
+        return ((void *)0);
+    }
+    *perr = OS_ERR_NONE;
+    return (pmsg);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             CREATE A RING
+*
+* Description: This function initializes a ring provided by the application.
+*
+* Arguments  : pring         is a pointer to the ring to initialize.
+*
+*              pstart        is a pointer to the storage area of the ring: an array of 'size' (void *).
+*
+*              size          is the number of entries of the ring.  It MUST be a power of 2.
+*
+*              opt           OS_RING_OPT_NONE    The consumer only polls the ring with OSRingAccept().
+*                            OS_RING_OPT_PEND    Also create a semaphore so that the consumer may wait
+*                                                for messages with OSRingPend().
+*
+* Returns    : OS_ERR_NONE                The ring was created.
+*              OS_ERR_PDATA_NULL          If 'pring' or 'pstart' is a NULL pointer.
+*              OS_ERR_RING_INVALID_SIZE   If 'size' is 0 or not a power of 2.
+*              OS_ERR_INVALID_OPT         If 'opt' is not a valid option.
+*              OS_ERR_CREATE_ISR          If you called this function from an ISR.
+*              OS_ERR_PEVENT_NULL         If no event control block was left for the semaphore.
+*********************************************************************************************************
+*/
+
+INT8U  OSRingCreate (OS_RING *pring, void **pstart, INT32U size, INT8U opt)
+{
+#if OS_ARG_CHK_EN > 0
+    if ((pring == (OS_RING *)0) || (pstart == (void **)0)) {
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if ((size == 0) || ((size & (size - 1)) != 0)) {   /* Indices are masked with 'size - 1'           */
+        return (OS_ERR_RING_INVALID_SIZE);
+    }
+    if (OSIntNesting > 0) {                            /* See if called from ISR ...                   */
+        return (OS_ERR_CREATE_ISR);                    /* ... can't CREATE from an ISR                 */
+    }
+    pring->OSRingIn    = 0;
+    pring->OSRingOut   = 0;
+    pring->OSRingStart = pstart;
+    pring->OSRingMask  = size - 1;
+#if OS_SEM_EN > 0
+    pring->OSRingWait  = OS_FALSE;
+    pring->OSRingSem   = (OS_EVENT *)0;
+    if (opt == OS_RING_OPT_PEND) {
+        pring->OSRingSem = OSSemCreate(0);
+        if (pring->OSRingSem == (OS_EVENT *)0) {
+            return (OS_ERR_PEVENT_NULL);
+        }
+        return (OS_ERR_NONE);
+    }
+#endif
+    if (opt != OS_RING_OPT_NONE) {
+        return (OS_ERR_INVALID_OPT);
+    }
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      PEND ON A RING FOR A MESSAGE
+*
+* Description: This function waits for a message to be posted to a ring created with OS_RING_OPT_PEND.
+*
+* Arguments  : pring         is a pointer to the ring.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message to arrive at the ring up to the amount of time specified
+*                            by this argument.  If you specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received a message.
+*                            OS_ERR_TIMEOUT      A message was not received within the specified timeout.
+*                            OS_ERR_PDATA_NULL   If 'pring' is a NULL pointer.
+*                            OS_ERR_PEVENT_NULL  If the ring was not created with OS_RING_OPT_PEND.
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR.
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler locked.
+*
+* Returns    : The message removed from the ring or a NULL pointer on error.
+*
+* Note(s)    : 1) Only the consumer of the ring may call this function.
+*              2) A post that raced with an earlier timeout may leave the semaphore signaled.  The wake-up
+*                 it causes finds the ring empty and the task waits again, for a new 'timeout'.
+*********************************************************************************************************
+*/
+
+#if OS_SEM_EN > 0
+void  *OSRingPend (OS_RING *pring, INT16U timeout, INT8U *perr)
+{
+    void      *pmsg;
+    BOOLEAN    wait;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return ((void *)0);
+    }
+    if (pring == (OS_RING *)0) {                       /* Validate 'pring'                             */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pring->OSRingSem == (OS_EVENT *)0) {           /* Created without OS_RING_OPT_PEND             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+    while (OS_RingGet(pring, &pmsg) == OS_FALSE) {     /* Lock-free while messages are available       */
+        OS_ENTER_CRITICAL();
+        wait = (BOOLEAN)(pring->OSRingIn == pring->OSRingOut);
+        if (wait == OS_TRUE) {                         /* Still empty: ask the producer for a wake-up  */
+            pring->OSRingWait = OS_TRUE;
+        }
+        OS_EXIT_CRITICAL();
+        if (wait == OS_TRUE) {                         /* The wake-up may already have been posted     */
+            OSSemPend(pring->OSRingSem, timeout, perr);
+            if (*perr != OS_ERR_NONE) {
+                pring->OSRingWait = OS_FALSE;          /* No more wake-ups (see Note #2)               */
+                return ((void *)0);
+            }
+        }
+    }
+    *perr = OS_ERR_NONE;
+    return (pmsg);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         POST A MESSAGE TO A RING
+*
+* Description: This function appends a message to a ring.  If the consumer is waiting in OSRingPend(),
+*              it is made ready to run.
+*
+* Arguments  : pring         is a pointer to the ring.
+*
+*              pmsg          is the message to post.  NULL pointers may be posted.
+*
+* Returns    : OS_ERR_NONE         The message was posted.
+*              OS_ERR_Q_FULL       If the ring is full: the message was NOT posted.
+*              OS_ERR_PDATA_NULL   If 'pring' is a NULL pointer.
+*
+* Note(s)    : 1) Only the producer of the ring may call this function.  It may be called from an ISR and
+*                 only enters a critical section (through OSSemPost()) to ready a waiting consumer.
+*********************************************************************************************************
+*/
+
+INT8U  OSRingPost (OS_RING *pring, void *pmsg)
+{
+    INT32U  in;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pring == (OS_RING *)0) {                       /* Validate 'pring'                             */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    in = pring->OSRingIn;                              /* Only written by this producer                */
+    if ((in - OS_CPU_LOAD_ACQ(&pring->OSRingOut)) > pring->OSRingMask) {
+        return (OS_ERR_Q_FULL);
+    }
+    ((void * volatile *)pring->OSRingStart)[in & pring->OSRingMask] = pmsg;
+    OS_CPU_STORE_REL(&pring->OSRingIn, in + 1);        /* Publish the message                          */
+#if OS_SEM_EN > 0
+    if (pring->OSRingWait == OS_TRUE) {                /* Wake the consumer up if it waits for it      */
+        pring->OSRingWait = OS_FALSE;
+        (void)OSSemPost(pring->OSRingSem);
+    }
+#endif
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REMOVE THE OLDEST MESSAGE OF A RING
+*
+* Description: This function removes the oldest message of a ring, if any.
+*
+* Arguments  : pring         is a pointer to the ring.
+*
+*              pmsg          is a pointer to where the message is deposited.
+*
+* Returns    : OS_TRUE       if a message was removed.
+*              OS_FALSE      if the ring was empty.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_RingGet (OS_RING *pring, void **pmsg)
+{
+    INT32U  out;
+
+
+    out = pring->OSRingOut;                            /* Only written by the consumer                 */
+    if (OS_CPU_LOAD_ACQ(&pring->OSRingIn) == out) {
+        return (OS_FALSE);
+    }
+    *pmsg = ((void * volatile *)pring->OSRingStart)[out & pring->OSRingMask];
+    OS_CPU_STORE_REL(&pring->OSRingOut, out + 1);      /* Give the entry back to the producer          */
+    return (OS_TRUE);
+}
+#endif                                                 /* OS_RING_EN                                   */
@@ -0,0 +1,305 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                      ROUND-ROBIN TIME SLICING
+*
+* File    : OS_RR.C
+* Version : V2.86
+*
+* Note(s) : 1) With OS_SCHED_RR_EN, a task may be created at a priority already used by another task:
+*              the tasks created at a priority form a level, linked through OSTCBRRLevelNext, and
+*              OSTCBPrioTbl[] points to the first task of the level.  A service given a priority (for
+*              example OSTaskSuspend(prio)) acts on that first task; a task refers to itself with
+*              OS_PRIO_SELF.  OSTaskChangePrio() still needs a free priority, and no task may share the
+*              priority of the idle task, nor the priority reserved by a mutex (its PIP or ceiling).
+*
+*           2) The ready tasks of each priority wait in turn in a ring, OSRRRdyList[prio] pointing to the
+*              task whose turn it is, and the bit of the priority is set in OSRdyTbl[] while its ring is
+*              not empty: OS_SchedNew() still finds the highest priority ready with the bitmap, and the
+*              task to run is the first one of that ring.  Making a task ready or not ready and finding
+*              the task to run take constant time, whatever the number of tasks sharing the priority.
+*
+*           3) The task that runs keeps the CPU for OSRRQuantum ticks, then goes to the end of the ring
+*              and the next ready task of the same priority runs (first in, first out).  A task that
+*              blocks gives up its turn and is put at the end of the ring, with a new time slice, once
+*              it is ready again.  A task preempted by a higher priority task keeps its turn and the rest
+*              of its time slice.  With OSRRQuantum set to 0, the tasks of a priority run in turn only
+*              when the running one blocks.
+*
+*           4) A task waiting for an event is in the wait list at its priority, as usual: the bit stands
+*              for every task of that priority waiting on the event, and OS_EventTaskFind() tells which
+*              ones.  A post makes the task of that priority waiting the longest ready.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_SCHED_RR_EN > 0
+/*
+*********************************************************************************************************
+*                                         SET THE TIME SLICE
+*
+* Description: This function sets the number of ticks the tasks sharing a priority run before giving the
+*              CPU to the next ready task of the same priority.
+*
+* Arguments  : quantum       is the time slice (in clock ticks).  0 disables time slicing: a task then
+*                            gives the CPU to the other tasks of its priority only when it blocks.
+*
+* Returns    : none
+*
+* Note(s)    : 1) The new time slice is given to each task the next time its turn comes.
+*********************************************************************************************************
+*/
+
+void  OSSchedRRSet (INT16U quantum)
+{
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    OSRRQuantum = quantum;
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  SEE IF A PRIORITY CAN BE SHARED
+*
+* Description: This function is called by OSTaskCreate() and OSTaskCreateExt() when 'prio' is in use, to
+*              find out if the new task may join the tasks created at that priority.
+*
+* Arguments  : prio          is the priority of the task to create.
+*
+* Returns    : OS_TRUE       if OSTCBPrioTbl[prio] is the first task of the level of 'prio'.
+*              OS_FALSE      if 'prio' is free, reserved (by OSTaskCreate() or by a mutex), held by a task
+*                            raised above its own level or is the priority of the idle task.
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+BOOLEAN  OS_RRLevelTst (INT8U prio)
+{
+    OS_TCB  *ptcb;
+
+
+    if (prio == OS_TASK_IDLE_PRIO) {
+        return (OS_FALSE);
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        return (OS_FALSE);
+    }
+    if (ptcb->OSTCBRRLevel != prio) {            /* Mutex owner raised to 'prio'                       */
+        return (OS_FALSE);
+    }
+    return (OS_TRUE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     ADD A TASK TO ITS LEVEL
+*
+* Description: This function adds a task to the level of its priority: the task becomes the first task of
+*              the level if it is the only one, or else is added after the last one.
+*
+* Arguments  : ptcb          is a pointer to the task's OS_TCB, already at its priority.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The caller makes sure the priority is free or can be shared (see OS_RRLevelTst()).
+*********************************************************************************************************
+*/
+
+void  OS_RRLevelLink (OS_TCB *ptcb)
+{
+    OS_TCB  *pfirst;
+    INT8U    prio;
+
+
+    prio               = ptcb->OSTCBPrio;
+    ptcb->OSTCBRRLevel = prio;
+    if (OS_RRLevelTst(prio) == OS_TRUE) {        /* Join the tasks created at 'prio' ...               */
+        pfirst                    = OSTCBPrioTbl[prio];
+        ptcb->OSTCBRRLevelNext    = pfirst;
+        ptcb->OSTCBRRLevelPrev    = pfirst->OSTCBRRLevelPrev;
+        pfirst->OSTCBRRLevelPrev->OSTCBRRLevelNext = ptcb;
+        pfirst->OSTCBRRLevelPrev  = ptcb;
+    } else {                                     /* ... or be the only one                             */
+        ptcb->OSTCBRRLevelNext    = ptcb;
+        ptcb->OSTCBRRLevelPrev    = ptcb;
+        OSTCBPrioTbl[prio]        = ptcb;
+    }
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REMOVE A TASK FROM ITS LEVEL
+*
+* Description: This function removes a task from the level it was added to, when the task is deleted or
+*              changes priority.  The next task of the level becomes the first one if needed, and the
+*              priority is freed when no task is left.
+*
+* Arguments  : ptcb          is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_RRLevelUnlink (OS_TCB *ptcb)
+{
+    INT8U  level;
+
+
+    level = ptcb->OSTCBRRLevel;
+    if (ptcb->OSTCBRRLevelNext == ptcb) {        /* Last task of the level                             */
+        if (OSTCBPrioTbl[level] == ptcb) {
+            OSTCBPrioTbl[level] = (OS_TCB *)0;
+        }
+    } else {
+        ptcb->OSTCBRRLevelPrev->OSTCBRRLevelNext = ptcb->OSTCBRRLevelNext;
+        ptcb->OSTCBRRLevelNext->OSTCBRRLevelPrev = ptcb->OSTCBRRLevelPrev;
+        if (OSTCBPrioTbl[level] == ptcb) {       /* Next task becomes the first of the level           */
+            OSTCBPrioTbl[level] = ptcb->OSTCBRRLevelNext;
+        }
+    }
+    ptcb->OSTCBRRLevelNext = (OS_TCB *)0;
+    ptcb->OSTCBRRLevelPrev = (OS_TCB *)0;
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         MAKE A TASK READY
+*
+* Description: This function puts a task at the end of the ready ring of its priority, with a new time
+*              slice, and makes the priority ready if the ring was empty.  Nothing is done if the task is
+*              already ready.
+*
+* Arguments  : ptcb          is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it: use
+*                 OS_RDY_INS().
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_RRRdy (OS_TCB *ptcb)
+{
+    OS_TCB  *pfirst;
+    INT8U    prio;
+
+
+    if (ptcb->OSTCBRRNext != (OS_TCB *)0) {      /* Already ready                                      */
+        return;
+    }
+    ptcb->OSTCBRRQuantumCtr = OSRRQuantum;
+    prio                    = ptcb->OSTCBPrio;
+    pfirst                  = OSRRRdyList[prio];
+    if (pfirst == (OS_TCB *)0) {                 /* Only ready task of its priority                    */
+        ptcb->OSTCBRRNext       = ptcb;
+        ptcb->OSTCBRRPrev       = ptcb;
+        OSRRRdyList[prio]       = ptcb;
+        OSRdyGrp               |= ptcb->OSTCBBitY;
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+    } else {                                     /* Last in line                                       */
+        ptcb->OSTCBRRNext       = pfirst;
+        ptcb->OSTCBRRPrev       = pfirst->OSTCBRRPrev;
+        pfirst->OSTCBRRPrev->OSTCBRRNext = ptcb;
+        pfirst->OSTCBRRPrev     = ptcb;
+    }
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       MAKE A TASK NOT READY
+*
+* Description: This function removes a task from the ready ring of its priority, and makes the priority
+*              not ready if no task is left.  The task is stamped with OSRRSeq, so that the tasks of a
+*              priority waiting on an event are readied in the order they blocked.  Nothing is done if
+*              the task is not ready.
+*
+* Arguments  : ptcb          is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it: use
+*                 OS_RDY_DEL().
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_RRUnrdy (OS_TCB *ptcb)
+{
+    INT8U  prio;
+
+
+    if (ptcb->OSTCBRRNext == (OS_TCB *)0) {      /* Not ready                                          */
+        return;
+    }
+    prio = ptcb->OSTCBPrio;
+    if (ptcb->OSTCBRRNext == ptcb) {             /* Last ready task of its priority                    */
+        OSRRRdyList[prio] = (OS_TCB *)0;
+        OSRdyTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX;
+        if (OSRdyTbl[ptcb->OSTCBY] == 0) {
+            OSRdyGrp &= ~ptcb->OSTCBBitY;
+        }
+    } else {
+        ptcb->OSTCBRRPrev->OSTCBRRNext = ptcb->OSTCBRRNext;
+        ptcb->OSTCBRRNext->OSTCBRRPrev = ptcb->OSTCBRRPrev;
+        if (OSRRRdyList[prio] == ptcb) {         /* Its turn goes to the next task                     */
+            OSRRRdyList[prio] = ptcb->OSTCBRRNext;
+        }
+    }
+    ptcb->OSTCBRRNext = (OS_TCB *)0;
+    ptcb->OSTCBRRPrev = (OS_TCB *)0;
+    ptcb->OSTCBRRSeq  = OSRRSeq;                 /* When it started to wait, see OS_EventTaskFind()    */
+    OSRRSeq++;
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     CHARGE A TICK TO THE TIME SLICE
+*
+* Description: This function is called by OSTimeTick() to charge the tick to the time slice of the
+*              running task.  When the slice is used up, the task goes to the end of the ready ring of its
+*              priority and OSIntExit() then switches to the next one.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_RRTick (void)
+{
+    OS_TCB  *ptcb;
+
+
+    ptcb = OSTCBCur;
+    if ((OSRRQuantum == 0) || (OSRRRdyList[ptcb->OSTCBPrio] != ptcb)) {
+        return;                                  /* No time slicing, or task is no longer ready        */
+    }
+    if (ptcb->OSTCBRRQuantumCtr > 1) {
+        ptcb->OSTCBRRQuantumCtr--;
+        return;
+    }
+    ptcb->OSTCBRRQuantumCtr       = OSRRQuantum; /* Time slice used up: next task's turn               */
+    OSRRRdyList[ptcb->OSTCBPrio]  = ptcb->OSTCBRRNext;
+}
+#endif                                           /* OS_SCHED_RR_EN                                     */
@@ -0,0 +1,707 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                        ZERO-COPY SLOT QUEUES
+*
+* File    : OS_SLOTQ.C
+* Version : V2.86
+*
+* Note(s) : 1) A slot queue is a FIFO of fixed size message buffers ('slots') provided by the application.
+*              Messages are written and read in place instead of being copied in and out of the queue:
+*
+*                  Producer                              Consumer
+*                  --------                              --------
+*                  pslot = OSSlotQReserve(pevent, &err);  pslot = OSSlotQPend(pevent, timeout, &err);
+*                  ... write the message in *pslot ...   ... read the message in *pslot ...
+*                  OSSlotQCommit(pevent, pslot);          OSSlotQRelease(pevent, pslot);
+*
+*              Interrupts are only disabled to update the state of a slot and the indices of the queue.
+*
+*           2) Slots are reserved in FIFO order and given to the consumers in the same order.  A slot
+*              committed before an older one waits for it: the message of a producer preempted while
+*              writing is not overtaken.  Slots may be committed and released in any order; a slot is
+*              reserved again once the whole queue went round and it was released.
+*
+*           3) Producers do not block: OSSlotQReserve() returns OS_ERR_Q_FULL, as OSQPost() does, and may
+*              be called from an ISR, as may OSSlotQCommit(), OSSlotQAccept() and OSSlotQRelease().
+*
+*           4) Slot queues cannot be passed to OSEventPendMulti().
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_SLOTQ_EN > 0
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void   *OS_SlotQGet(OS_SLOTQ *psq);
+
+static  void   *OS_SlotQPeek(OS_SLOTQ *psq);
+
+static  INT16U  OS_SlotQIndex(OS_SLOTQ *psq, void *pslot);
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   ACCEPT A MESSAGE FROM A SLOT QUEUE
+*
+* Description: This function checks the slot queue to see if a message is available.  Unlike OSSlotQPend(),
+*              OSSlotQAccept() does not suspend the calling task if a message is not available.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the slot queue.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received a message.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a slot queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_Q_EMPTY      The queue did not contain any messages
+*
+* Returns    : != (void *)0  is a pointer to the slot holding the message.  You MUST give the slot back with
+*                            OSSlotQRelease() once the message has been read.
+*              == (void *)0  if no message was available.
+*********************************************************************************************************
+*/
+
+void  *OSSlotQAccept (OS_EVENT *pevent, INT8U *perr)
+{
+    void      *pslot;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return ((void *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SLOTQ) {  /* Validate event block type                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pslot = OS_SlotQGet((OS_SLOTQ *)pevent->OSEventPtr);
+    OS_EXIT_CRITICAL();
+    if (pslot == (void *)0) {
+        *perr = OS_ERR_Q_EMPTY;
+    } else {
+        *perr = OS_ERR_NONE;
+    }
+    return (pslot);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     COMMIT A MESSAGE TO A SLOT QUEUE
+*
+* Description: This function publishes the message written in a slot obtained from OSSlotQReserve().  If
+*              tasks are waiting and the slot is the oldest one not yet given to a consumer, the highest
+*              priority task waiting gets the slot.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the slot queue.
+*
+*              pslot         is the pointer returned by OSSlotQReserve().
+*
+* Returns    : OS_ERR_NONE                The message was committed.
+*              OS_ERR_EVENT_TYPE          You didn't pass a pointer to a slot queue.
+*              OS_ERR_PEVENT_NULL         If 'pevent' is a NULL pointer.
+*              OS_ERR_SLOTQ_INVALID_SLOT  If 'pslot' is not a slot of the queue reserved by a producer.
+*********************************************************************************************************
+*/
+
+INT8U  OSSlotQCommit (OS_EVENT *pevent, void *pslot)
+{
+    OS_SLOTQ  *psq;
+    INT16U     ix;
+    BOOLEAN    sched;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SLOTQ) {  /* Validate event block type                    */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    psq = (OS_SLOTQ *)pevent->OSEventPtr;
+    ix  = OS_SlotQIndex(psq, pslot);
+    OS_ENTER_CRITICAL();
+    if ((ix >= psq->OSSlotQSize) || (psq->OSSlotQState[ix] != OS_SLOT_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_SLOTQ_INVALID_SLOT);
+    }
+    psq->OSSlotQState[ix] = OS_SLOT_COMMITTED;
+    sched                 = OS_FALSE;
+    while (pevent->OSEventGrp != 0) {                  /* Give the messages in order to waiting tasks  */
+        pslot = OS_SlotQPeek(psq);
+        if (pslot == (void *)0) {                      /* Oldest slot not committed yet                */
+            break;
+        }
+        if (OS_EventTaskRdy(pevent, pslot, OS_STAT_SLOTQ, OS_STAT_PEND_OK) == OS_PRIO_SELF) {
+            break;                                     /* Only stale entries were left, keep the slot  */
+        }
+        (void)OS_SlotQGet(psq);                        /* The task readied now borrows the slot        */
+        sched = OS_TRUE;
+    }
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+    }
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         CREATE A SLOT QUEUE
+*
+* Description: This function creates a slot queue over storage provided by the application.
+*
+* Arguments  : pstart        is a pointer to the storage of the slots: 'nslots' contiguous blocks of
+*                            'slot_size' bytes, e.g. char Slots[nslots][slot_size].
+*
+*              nslots        is the number of slots (OS_SLOTQ_MAX_SLOTS at most).
+*
+*              slot_size     is the size of a slot (bytes).  Use a multiple of the alignment needed by the
+*                            messages.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE                The queue was created.
+*                            OS_ERR_CREATE_ISR          If you attempted to create the queue from an ISR.
+*                            OS_ERR_PDATA_NULL          If 'pstart' is a NULL pointer.
+*                            OS_ERR_PEVENT_NULL         If no event or slot queue control block is left.
+*                            OS_ERR_SLOTQ_INVALID_SIZE  If 'nslots' or 'slot_size' is invalid.
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control block allocated to the queue.
+*              == (OS_EVENT *)0  if the queue could not be created.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSSlotQCreate (void *pstart, INT16U nslots, INT16U slot_size, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+    OS_SLOTQ  *psq;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return ((OS_EVENT *)0);
+    }
+    if (pstart == (void *)0) {                         /* Validate 'pstart'                            */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if ((nslots == 0) || (nslots > OS_SLOTQ_MAX_SLOTS) || (slot_size == 0)) {
+        *perr = OS_ERR_SLOTQ_INVALID_SIZE;             /* OSSlotQState[] holds OS_SLOTQ_MAX_SLOTS slots */
+        return ((OS_EVENT *)0);
+    }
+    if (OSIntNesting > 0) {                            /* See if called from ISR ...                   */
+        *perr = OS_ERR_CREATE_ISR;                     /* ... can't CREATE from an ISR                 */
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                          /* Get next free event control block            */
+    if (OSEventFreeList != (OS_EVENT *)0) {            /* See if pool of free ECB pool was empty       */
+        OSEventFreeList = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (pevent == (OS_EVENT *)0) {
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    psq = OSSlotQFreeList;                             /* Get a free slot queue control block          */
+    if (psq == (OS_SLOTQ *)0) {                        /* Return event control block on error          */
+        pevent->OSEventPtr = (void *)OSEventFreeList;
+        OSEventFreeList    = pevent;
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((OS_EVENT *)0);
+    }
+    OSSlotQFreeList = OSSlotQFreeList->OSSlotQPtr;
+    OS_EXIT_CRITICAL();
+    psq->OSSlotQStart      = (INT8U *)pstart;          /* Initialize the queue                         */
+    psq->OSSlotQSlotSize   = slot_size;
+    psq->OSSlotQSize       = nslots;
+    psq->OSSlotQIn         = 0;
+    psq->OSSlotQOut        = 0;
+    OS_MemClr(&psq->OSSlotQState[0], sizeof(psq->OSSlotQState));   /* All slots are OS_SLOT_FREE     */
+    pevent->OSEventType    = OS_EVENT_TYPE_SLOTQ;
+    pevent->OSEventCnt     = 0;                        /* Unused                                       */
+    pevent->OSEventPtr     = psq;
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                      /* Unknown name                                 */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);                      /* Initalize the wait list                      */
+    *perr = OS_ERR_NONE;
+    return (pevent);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         DELETE A SLOT QUEUE
+*
+* Description: This function deletes a slot queue and readies all tasks pending on it.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the slot queue.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the queue ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the queue even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied
+*                                                    and get OS_ERR_PEND_ABORT.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the queue was deleted
+*                            OS_ERR_DEL_ISR          If you tried to delete the queue from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the queue
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a slot queue
+*                            OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer.
+*
+* Returns    : pevent        upon error
+*              (OS_EVENT *)0 if the queue was successfully deleted.
+*
+* Note(s)    : 1) The slots still reserved or borrowed must not be committed or released after the queue
+*                 is deleted.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSSlotQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
+{
+    OS_SLOTQ  *psq;
+    BOOLEAN    tasks_waiting;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return (pevent);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (pevent);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SLOTQ) {  /* Validate event block type                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (pevent);
+    }
+    if (OSIntNesting > 0) {                            /* See if called from ISR ...                   */
+        *perr = OS_ERR_DEL_ISR;                        /* ... can't DELETE from an ISR                 */
+        return (pevent);
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp != 0) {                     /* See if any tasks waiting on queue            */
+        tasks_waiting = OS_TRUE;                       /* Yes                                          */
+    } else {
+        tasks_waiting = OS_FALSE;                      /* No                                           */
+    }
+    switch (opt) {
+        case OS_DEL_NO_PEND:                           /* Delete queue only if no task waiting         */
+        case OS_DEL_ALWAYS:                            /* Always delete the queue                      */
+             if ((opt == OS_DEL_NO_PEND) && (tasks_waiting == OS_TRUE)) {
+                 OS_EXIT_CRITICAL();
+                 *perr = OS_ERR_TASK_WAITING;
+                 return (pevent);
+             }
+             if (tasks_waiting == OS_TRUE) {           /* Ready ALL tasks waiting for queue            */
+                 (void)OS_EventTaskRdyAll(pevent, (void *)0, OS_STAT_SLOTQ, OS_STAT_PEND_ABORT);
+             }
+#if OS_EVENT_NAME_SIZE > 1
+             pevent->OSEventName[0] = '?';             /* Unknown name                                 */
+             pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+             psq                    = (OS_SLOTQ *)pevent->OSEventPtr;  /* Return block to free list    */
+             psq->OSSlotQPtr        = OSSlotQFreeList;
+             OSSlotQFreeList        = psq;
+             pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+             pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list      */
+             pevent->OSEventCnt     = 0;
+             OSEventFreeList        = pevent;          /* Get next free event control block            */
+             OS_EXIT_CRITICAL();
+             if (tasks_waiting == OS_TRUE) {           /* Reschedule only if task(s) were waiting      */
+                 OS_Sched();                           /* Find highest priority task ready to run      */
+             }
+             *perr = OS_ERR_NONE;
+             return ((OS_EVENT *)0);                   /* Queue has been deleted                       */
+
+        default:
+             OS_EXIT_CRITICAL();
+             *perr = OS_ERR_INVALID_OPT;
+             return (pevent);
+    }
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PEND ON A SLOT QUEUE FOR A MESSAGE
+*
+* Description: This function waits for a message to be committed to a slot queue.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the slot queue.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message to arrive at the queue up to the amount of time
+*                            specified by this argument.  If you specify 0, however, your task will wait
+*                            forever at the specified queue or, until a message arrives.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received a message.
+*                            OS_ERR_TIMEOUT      A message was not received within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait on the queue was aborted (see OSSlotQDel()).
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a slot queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler is locked
+*
+* Returns    : != (void *)0  is a pointer to the slot holding the message.  You MUST give the slot back with
+*                            OSSlotQRelease() once the message has been read.
+*              == (void *)0  if no message was received.
+*********************************************************************************************************
+*/
+
+void  *OSSlotQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+{
+    void      *pslot;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return ((void *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SLOTQ) {  /* Validate event block type                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    if (OSIntNesting > 0) {                            /* See if called from ISR ...                   */
+        *perr = OS_ERR_PEND_ISR;                       /* ... can't PEND from an ISR                   */
+        return ((void *)0);
+    }
+    if (OSLockNesting > 0) {                           /* See if called with scheduler locked ...      */
+        *perr = OS_ERR_PEND_LOCKED;                    /* ... can't PEND when locked                   */
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pslot = OS_SlotQGet((OS_SLOTQ *)pevent->OSEventPtr);
+    if (pslot != (void *)0) {                          /* See if any messages in the queue             */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (pslot);
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_SLOTQ;          /* Task will have to pend for a message         */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OSTCBCur->OSTCBDly       = timeout;                /* Load timeout into TCB                        */
+    OS_EventTaskWait(pevent);                          /* Suspend task until event or timeout occurs   */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                        /* Find next highest priority task ready to run */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                 /* See if we timed-out or aborted               */
+        case OS_STAT_PEND_OK:                          /* Extract slot from TCB (Put there by Commit)  */
+             pslot =  OSTCBCur->OSTCBMsg;
+            *perr  =  OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             pslot = (void *)0;
+            *perr  =  OS_ERR_PEND_ABORT;               /* Indicate that we aborted                     */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             pslot = (void *)0;
+            *perr  =  OS_ERR_TIMEOUT;                  /* Indicate that we didn't get event within TO  */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;       /* Set   task  status to ready                  */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;   /* Clear pend  status                           */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;     /* Clear event pointers                         */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;     /* Clear  received message                      */
+    OS_EXIT_CRITICAL();
+    return (pslot);                                    /* Return received slot                         */
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  RELEASE A SLOT BACK TO A SLOT QUEUE
+*
+* Description: This function gives back a slot obtained from OSSlotQPend() or OSSlotQAccept() once its
+*              message has been read.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the slot queue.
+*
+*              pslot         is the pointer returned by OSSlotQPend() or OSSlotQAccept().
+*
+* Returns    : OS_ERR_NONE                The slot was released.
+*              OS_ERR_EVENT_TYPE          You didn't pass a pointer to a slot queue.
+*              OS_ERR_PEVENT_NULL         If 'pevent' is a NULL pointer.
+*              OS_ERR_SLOTQ_INVALID_SLOT  If 'pslot' is not a slot of the queue held by a consumer.
+*********************************************************************************************************
+*/
+
+INT8U  OSSlotQRelease (OS_EVENT *pevent, void *pslot)
+{
+    OS_SLOTQ  *psq;
+    INT16U     ix;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SLOTQ) {  /* Validate event block type                    */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    psq = (OS_SLOTQ *)pevent->OSEventPtr;
+    ix  = OS_SlotQIndex(psq, pslot);
+    OS_ENTER_CRITICAL();
+    if ((ix >= psq->OSSlotQSize) || (psq->OSSlotQState[ix] != OS_SLOT_BORROWED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_SLOTQ_INVALID_SLOT);
+    }
+    psq->OSSlotQState[ix] = OS_SLOT_FREE;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   RESERVE A SLOT OF A SLOT QUEUE
+*
+* Description: This function gives a producer the next free slot of the queue, in which it writes its
+*              message before calling OSSlotQCommit().
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the slot queue.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         A slot was reserved.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a slot queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_Q_FULL       The next slot has not been released yet
+*
+* Returns    : != (void *)0  is a pointer to the reserved slot (the size given to OSSlotQCreate()).
+*              == (void *)0  if no slot was free.
+*********************************************************************************************************
+*/
+
+void  *OSSlotQReserve (OS_EVENT *pevent, INT8U *perr)
+{
+    OS_SLOTQ  *psq;
+    INT16U     ix;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return ((void *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SLOTQ) {  /* Validate event block type                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    psq = (OS_SLOTQ *)pevent->OSEventPtr;
+    OS_ENTER_CRITICAL();
+    ix  = psq->OSSlotQIn;
+    if (psq->OSSlotQState[ix] != OS_SLOT_FREE) {       /* Queue is full                                */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_Q_FULL;
+        return ((void *)0);
+    }
+    psq->OSSlotQState[ix] = OS_SLOT_RESERVED;
+    psq->OSSlotQIn++;
+    if (psq->OSSlotQIn == psq->OSSlotQSize) {          /* Wrap IN index to the first slot              */
+        psq->OSSlotQIn = 0;
+    }
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return ((void *)(psq->OSSlotQStart + (INT32U)ix * psq->OSSlotQSlotSize));
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   INITIALIZE THE SLOT QUEUE MANAGER
+*
+* Description: This function is called by OSInit() to initialize the free list of slot queue control
+*              blocks.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_SlotQInit (void)
+{
+    INT16U     i;
+    OS_SLOTQ  *psq1;
+    OS_SLOTQ  *psq2;
+
+
+
+    OS_MemClr((INT8U *)&OSSlotQTbl[0], sizeof(OSSlotQTbl));   /* Clear the slot queue table           */
+    psq1 = &OSSlotQTbl[0];
+    psq2 = &OSSlotQTbl[1];
+    for (i = 0; i < (OS_MAX_SLOTQS - 1); i++) {        /* Init. list of free slot queue control blocks */
+        psq1->OSSlotQPtr = psq2;
+        psq1++;
+        psq2++;
+    }
+    psq1->OSSlotQPtr = (OS_SLOTQ *)0;
+    OSSlotQFreeList  = &OSSlotQTbl[0];
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   GIVE THE OLDEST MESSAGE TO A CONSUMER
+*
+* Description: This function marks the oldest slot not yet given to a consumer as borrowed, if its message
+*              was committed.
+*
+* Arguments  : psq       is a pointer to the slot queue control block.
+*
+* Returns    : A pointer to the slot, or a NULL pointer if the oldest slot is not committed (or the queue is
+*              empty).
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  *OS_SlotQGet (OS_SLOTQ *psq)
+{
+    void  *pslot;
+
+
+    pslot = OS_SlotQPeek(psq);
+    if (pslot == (void *)0) {
+        return ((void *)0);
+    }
+    psq->OSSlotQState[psq->OSSlotQOut] = OS_SLOT_BORROWED;
+    psq->OSSlotQOut++;
+    if (psq->OSSlotQOut == psq->OSSlotQSize) {         /* Wrap OUT index to the first slot             */
+        psq->OSSlotQOut = 0;
+    }
+    return (pslot);
+}
+
+/*
+*********************************************************************************************************
+*                                      LOOK AT THE OLDEST MESSAGE
+*
+* Description: This function returns the oldest slot not yet given to a consumer, if its message was
+*              committed, without giving it away.
+*
+* Arguments  : psq       is a pointer to the slot queue control block.
+*
+* Returns    : A pointer to the slot, or a NULL pointer if the oldest slot is not committed (or the queue is
+*              empty).
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  *OS_SlotQPeek (OS_SLOTQ *psq)
+{
+    INT16U  ix;
+
+
+    ix = psq->OSSlotQOut;
+    if (psq->OSSlotQState[ix] != OS_SLOT_COMMITTED) {
+        return ((void *)0);
+    }
+    return ((void *)(psq->OSSlotQStart + (INT32U)ix * psq->OSSlotQSlotSize));
+}
+
+/*
+*********************************************************************************************************
+*                                       FIND THE INDEX OF A SLOT
+*
+* Description: This function returns the index of a slot from its address.
+*
+* Arguments  : psq       is a pointer to the slot queue control block.
+*
+*              pslot     is the address of the slot.
+*
+* Returns    : The index of the slot, or OSSlotQSize if 'pslot' is not the address of a slot of the queue.
+*********************************************************************************************************
+*/
+
+static  INT16U  OS_SlotQIndex (OS_SLOTQ *psq, void *pslot)
+{
+    INT32U  ofs;
+
+
+    if ((INT8U *)pslot < psq->OSSlotQStart) {
+        return (psq->OSSlotQSize);
+    }
+    ofs = (INT32U)((INT8U *)pslot - psq->OSSlotQStart);
+    if ((ofs % psq->OSSlotQSlotSize) != 0) {           /* Must point to the start of a slot            */
+        return (psq->OSSlotQSize);
+    }
+    ofs /= psq->OSSlotQSlotSize;
+    if (ofs >= psq->OSSlotQSize) {
+        return (psq->OSSlotQSize);
+    }
+    return ((INT16U)ofs);
+}
+#endif
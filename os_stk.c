@@ -0,0 +1,304 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                        STACK HIGH-WATER MARKS
+*
+* File    : OS_STK.C
+* Version : V2.86
+*
+* Note(s) : 1) OSTCBStkWm points to the deepest entry of a task's stack known to have been used.  It moves in
+*              two ways:
+*              a) When a task is switched in, the stack pointer it was switched out with (OS_CPU_STK_PTR())
+*                 is compared with the mark.  This costs a compare per context switch and works for every
+*                 task, but misses the peaks reached between two switches.
+*              b) For the tasks created with OS_TASK_OPT_STK_CHK (and OS_TASK_OPT_STK_CLR), OS_StkWmScan()
+*                 scans the stack from the mark towards its bottom and stops after OS_STK_WM_GAP consecutive
+*                 zero entries.  The statistic task and OSTaskStkWmGet() only read the entries below the
+*                 mark, i.e. the growth since the previous scan, instead of the whole free area as
+*                 OSTaskStkChk() does.
+*
+*           2) A task overflows its stack when its mark reaches the last OS_STK_RED_SIZE entries of the stack.
+*              The overflow is reported once per task: OSTCBStkOvf is set, OSStkOvfCtr is incremented, an
+*              OS_TRACE_EVT_STK_OVF record is logged and the hook set by OSTaskStkOvfHookSet() is called.
+*              The check is done at the context switch that resumes the task, before it runs on a corrupted
+*              stack, and by each scan.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_STK_WM_EN > 0
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_StkOvf(OS_TCB *ptcb);
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      SET THE STACK OVERFLOW HOOK
+*
+* Description: This function sets the function called when a task overflows its stack.
+*
+* Arguments  : phook     is a pointer to the function called with the priority of the task, or a NULL pointer
+*                        to only count the overflows.  The hook is called with interrupts disabled, from the
+*                        context switch or from the task that scanned the stack.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSTaskStkOvfHookSet (OS_STK_OVF_HOOK phook)
+{
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    OSStkOvfHook = phook;
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     GET THE PEAK STACK USAGE OF A TASK
+*
+* Description: This function returns the number of bytes of a task's stack used so far (at the deepest) and
+*              the number of bytes that were never used.
+*
+* Arguments  : prio        is the priority of the task.  If you specify OS_PRIO_SELF, the stack of the calling
+*                          task is checked.
+*
+*              p_stk_data  is a pointer to where the result is stored (see OS_STK_DATA).
+*
+* Returns    : OS_ERR_NONE            if the usage was returned.
+*              OS_ERR_PRIO_INVALID    if the priority is higher than the maximum allowed.
+*              OS_ERR_PDATA_NULL      if 'p_stk_data' is a NULL pointer.
+*              OS_ERR_TASK_NOT_EXIST  if the task does not exist.
+*              OS_ERR_TASK_OPT        if the task was not created by OSTaskCreateExt().
+*
+* Notes      : 1) The stack is scanned from its high-water mark (see OS_StkWmScan()): the cost depends on how
+*                 much the stack grew since the previous scan, not on its size.
+*********************************************************************************************************
+*/
+
+INT8U  OSTaskStkWmGet (INT8U prio, OS_STK_DATA *p_stk_data)
+{
+    OS_TCB    *ptcb;
+    INT32U     nfree;
+    INT32U     size;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (p_stk_data == (OS_STK_DATA *)0) {              /* Validate 'p_stk_data'                        */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if checking our own stack                */
+        prio = OSTCBCur->OSTCBPrio;
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb->OSTCBStkBottom == (OS_STK *)0) {         /* Stack bottom and size must be known          */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_OPT);
+    }
+    OS_EXIT_CRITICAL();
+    OS_StkWmScan(ptcb);
+    OS_ENTER_CRITICAL();
+    nfree = 0;
+#if OS_STK_GROWTH == 1
+    if (ptcb->OSTCBStkWm > ptcb->OSTCBStkBottom) {
+        nfree = (INT32U)(ptcb->OSTCBStkWm - ptcb->OSTCBStkBottom);
+    }
+#else
+    if (ptcb->OSTCBStkWm < ptcb->OSTCBStkBottom) {
+        nfree = (INT32U)(ptcb->OSTCBStkBottom - ptcb->OSTCBStkWm);
+    }
+#endif
+    size = ptcb->OSTCBStkSize;
+    OS_EXIT_CRITICAL();
+    if (nfree > size) {
+        nfree = size;
+    }
+    p_stk_data->OSFree = nfree * sizeof(OS_STK);               /* Compute number of free bytes         */
+    p_stk_data->OSUsed = (size - nfree) * sizeof(OS_STK);      /* Compute number of bytes used         */
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     SCAN A STACK FROM ITS HIGH-WATER MARK
+*
+* Description: This function moves the high-water mark of a task to the deepest non-zero entry found below
+*              it, stopping at the bottom of the stack or after OS_STK_WM_GAP consecutive zero entries.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Only the stacks of the tasks created with OS_TASK_OPT_STK_CHK are scanned.
+*              3) The stack is read with interrupts enabled, as in OSTaskStkChk().
+*********************************************************************************************************
+*/
+
+void  OS_StkWmScan (OS_TCB *ptcb)
+{
+    OS_STK    *pbos;
+    OS_STK    *pwm;
+    OS_STK    *pstk;
+    INT16U     opt;
+    INT16U     nzero;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    pbos = ptcb->OSTCBStkBottom;
+    pwm  = ptcb->OSTCBStkWm;
+    opt  = ptcb->OSTCBOpt;
+    OS_EXIT_CRITICAL();
+    if (((opt & OS_TASK_OPT_STK_CHK) != 0) && (pbos != (OS_STK *)0)) {
+        pstk  = pwm;
+        nzero = 0;
+#if OS_STK_GROWTH == 1
+        while ((pstk > pbos) && (nzero < OS_STK_WM_GAP)) {
+            pstk--;
+#else
+        while ((pstk < pbos) && (nzero < OS_STK_WM_GAP)) {
+            pstk++;
+#endif
+            if (*pstk != (OS_STK)0) {                  /* Entry was used                               */
+                pwm   = pstk;
+                nzero = 0;
+            } else {
+                nzero++;
+            }
+        }
+    }
+    OS_ENTER_CRITICAL();
+    if (ptcb->OSTCBStkBottom == pbos) {                /* Same stack as when the scan started?         */
+#if OS_STK_GROWTH == 1
+        if (pwm < ptcb->OSTCBStkWm) {
+            ptcb->OSTCBStkWm = pwm;
+        }
+        if (ptcb->OSTCBStkWm < ptcb->OSTCBStkLimit) {
+            OS_StkOvf(ptcb);
+        }
+#else
+        if (pwm > ptcb->OSTCBStkWm) {
+            ptcb->OSTCBStkWm = pwm;
+        }
+        if ((ptcb->OSTCBStkLimit != (OS_STK *)0) && (ptcb->OSTCBStkWm > ptcb->OSTCBStkLimit)) {
+            OS_StkOvf(ptcb);
+        }
+#endif
+#if OS_TASK_PROFILE_EN > 0
+        if (pbos != (OS_STK *)0) {
+#if OS_STK_GROWTH == 1
+            ptcb->OSTCBStkBase = pbos + ptcb->OSTCBStkSize;
+            ptcb->OSTCBStkUsed = (INT32U)(ptcb->OSTCBStkBase - ptcb->OSTCBStkWm) * sizeof(OS_STK);
+#else
+            ptcb->OSTCBStkBase = pbos - ptcb->OSTCBStkSize;
+            ptcb->OSTCBStkUsed = (INT32U)(ptcb->OSTCBStkWm - ptcb->OSTCBStkBase) * sizeof(OS_STK);
+#endif
+        }
+#endif
+    }
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  CHECK THE STACK OF THE TASK SWITCHED IN
+*
+* Description: This function lowers the high-water mark of OSTCBHighRdy to the stack pointer it was switched
+*              out with, and reports an overflow if the pointer is in the red zone of the stack.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Called by OS_Sched() and OSIntExit(), with interrupts disabled, just before the switch.
+*********************************************************************************************************
+*/
+
+void  OS_StkWmSw (void)
+{
+    OS_TCB  *ptcb;
+    OS_STK  *psp;
+
+
+    ptcb = OSTCBHighRdy;
+    psp  = OS_CPU_STK_PTR(ptcb);
+#if OS_STK_GROWTH == 1
+    if (psp < ptcb->OSTCBStkWm) {                      /* Deeper than ever before?                     */
+        ptcb->OSTCBStkWm = psp;
+        if (psp < ptcb->OSTCBStkLimit) {
+            OS_StkOvf(ptcb);
+        }
+    }
+#else
+    if (psp > ptcb->OSTCBStkWm) {
+        ptcb->OSTCBStkWm = psp;
+        if ((ptcb->OSTCBStkLimit != (OS_STK *)0) && (psp > ptcb->OSTCBStkLimit)) {
+            OS_StkOvf(ptcb);
+        }
+    }
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                         REPORT A STACK OVERFLOW
+*
+* Description: This function reports the first overflow of a task's stack.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Notes      : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_StkOvf (OS_TCB *ptcb)
+{
+    if (ptcb->OSTCBStkOvf == OS_FALSE) {               /* Only report the first overflow               */
+        ptcb->OSTCBStkOvf = OS_TRUE;
+        OSStkOvfCtr++;
+#if OS_TRACE_EN > 0
+        OS_TraceRec(OS_TRACE_EVT_STK_OVF, ptcb->OSTCBPrio, OSPrioCur);
+#endif
+        if (OSStkOvfHook != (OS_STK_OVF_HOOK)0) {
+            (*OSStkOvfHook)(ptcb->OSTCBPrio);
+        }
+    }
+}
+#endif
@@ -0,0 +1,107 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                          CONTEXT SWITCH TRACE
+*
+* File    : OS_TRACE.C
+* Version : V2.86
+*
+* Note(s) : The kernel appends fixed-size binary records to a ring buffer while interrupts are already
+*           disabled.  No formatting is done in the kernel: the records are read back with OSTraceRead()
+*           by a low priority task (or dumped from memory by a debugger) and decoded there.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_TRACE_EN > 0
+/*
+*********************************************************************************************************
+*                                         READ TRACE RECORDS
+*
+* Description: This function copies the oldest unread records out of the trace ring.
+*
+* Arguments  : prec      is a pointer to an array of at least 'nrecs' records that will receive the data.
+*
+*              nrecs     is the maximum number of records to copy.
+*
+* Returns    : The number of records copied (0 if the ring is empty).
+*
+* Notes      : 1) Interrupts are only disabled while a single record is copied.
+*              2) If the kernel has wrapped around the ring since the last call, the records that were
+*                 overwritten are skipped and added to OSTraceLost.
+*********************************************************************************************************
+*/
+
+INT16U  OSTraceRead (OS_TRACE_REC *prec, INT16U nrecs)
+{
+    INT16U     nread;
+    INT32U     avail;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prec == (OS_TRACE_REC *)0) {                   /* Validate 'prec'                              */
+        return (0);
+    }
+#endif
+    nread = 0;
+    while (nread < nrecs) {
+        OS_ENTER_CRITICAL();
+        avail = OSTraceIn - OSTraceOut;
+        if (avail == 0L) {                             /* Ring is empty                                */
+            OS_EXIT_CRITICAL();
+            break;
+        }
+        if (avail > OS_TRACE_BUF_SIZE) {               /* Writer lapped the reader, skip lost records  */
+            OSTraceLost += avail - OS_TRACE_BUF_SIZE;
+            OSTraceOut   = OSTraceIn - OS_TRACE_BUF_SIZE;
+        }
+        *prec++ = OSTraceBuf[OSTraceOut & (OS_TRACE_BUF_SIZE - 1)];
+        OSTraceOut++;
+        OS_EXIT_CRITICAL();
+        nread++;
+    }
+    return (nread);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        RECORD A TRACE EVENT
+*
+* Description: This function appends a record to the trace ring.  When the ring is full the oldest record
+*              is overwritten.
+*
+* Arguments  : event     is the kind of event (see OS_TRACE_EVT_xxx).
+*
+*              from      is the priority of the task being switched out.
+*
+*              to        is the priority of the task being switched in.
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_TraceRec (INT8U event, INT8U from, INT8U to)
+{
+    OS_TRACE_REC  *prec;
+
+
+    prec               = &OSTraceBuf[OSTraceIn & (OS_TRACE_BUF_SIZE - 1)];
+    prec->OSTraceTime  = (INT32U)OS_TRACE_TS_GET();
+    prec->OSTraceEvent = event;
+    prec->OSTraceFrom  = from;
+    prec->OSTraceTo    = to;
+    OSTraceIn++;                                       /* Publish the record                           */
+}
+#endif                                                 /* OS_TRACE_EN                                  */
@@ -0,0 +1,188 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                        BROADCAST WAKE-UP BENCHMARK
+*
+* File    : BCASTBENCH.C
+* Version : V2.86
+*
+* Note(s) : 1) BENCH_WORKERS tasks wait on a semaphore, as at a barrier, and are released together, over
+*              and over.  The time spent with interrupts masked to release them is measured:
+*              - one task at a time: OS_EventTaskRdy() until the wait list is empty, which is what the
+*                OS_POST_OPT_BROADCAST and OS_PEND_OPT_BROADCAST options of the services used to do.
+*              - whole wait list: OS_EventTaskRdyAll(), which they now call, as OSSemPostN() does for a
+*                barrier release.
+*           2) Build with enough tasks:
+*                  make clean; make bcastbench CFLAGS="-O2 -DOS_MAX_TASKS=48"
+*              Only the time inside the critical section is measured, so the SIGALRM build (where each
+*              critical section costs two system calls) may be used.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+#include  "includes.h"
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  BENCH_STK_SIZE          2048u
+#define  BENCH_WORKERS             40u
+#define  BENCH_ROUNDS           20000uL
+#define  BENCH_REL_PRIO     (BENCH_WORKERS + 1u) /* Releasing task, below the workers                  */
+
+#if OS_MAX_TASKS < (BENCH_WORKERS + 2)
+#error  "Build bcastbench with CFLAGS=\"-O2 -DOS_MAX_TASKS=48\""
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK     BenchStk[BENCH_WORKERS + 1][BENCH_STK_SIZE];
+
+static  OS_EVENT  *BenchSem;
+
+static  INT32U     BenchRuns;                    /* Times the workers were released, in total          */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  double  BenchNow(void);
+static  double  BenchRelease(BOOLEAN all);
+
+static  void    BenchRel(void *p_arg);
+static  void    BenchWork(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT32U  i;
+
+
+    BenchSem = OSSemCreate(0);
+    OSTaskCreateExt(BenchRel, (void *)0, &BenchStk[0][BENCH_STK_SIZE - 1], BENCH_REL_PRIO,
+                    BENCH_REL_PRIO, &BenchStk[0][0], BENCH_STK_SIZE, (void *)0, 0);
+    for (i = 0; i < BENCH_WORKERS; i++) {
+        OSTaskCreateExt(BenchWork, (void *)0, &BenchStk[i + 1][BENCH_STK_SIZE - 1], (INT8U)(i + 1),
+                        (INT16U)(i + 1), &BenchStk[i + 1][0], BENCH_STK_SIZE, (void *)0, 0);
+    }
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                      MONOTONIC TIME IN SECONDS
+*********************************************************************************************************
+*/
+
+static  double  BenchNow (void)
+{
+    struct timespec  t;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((double)t.tv_sec + (double)t.tv_nsec / 1e9);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                   RELEASE THE WORKERS BENCH_ROUNDS TIMES, RETURN THE TIME WITH INTERRUPTS MASKED
+*********************************************************************************************************
+*/
+
+static  double  BenchRelease (BOOLEAN all)
+{
+    double     t0;
+    double     t;
+    INT32U     i;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+    t = 0.0;
+    for (i = 0; i < BENCH_ROUNDS; i++) {         /* The workers all wait at the start of a round       */
+        OS_ENTER_CRITICAL();
+        t0 = BenchNow();
+        if (all == OS_TRUE) {
+            (void)OS_EventTaskRdyAll(BenchSem, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
+        } else {
+            while (BenchSem->OSEventGrp != 0) {
+                (void)OS_EventTaskRdy(BenchSem, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
+            }
+        }
+        t += BenchNow() - t0;
+        OS_EXIT_CRITICAL();
+        OS_Sched();                              /* The workers run and wait again                     */
+    }
+    return (t);
+}
+
+/*
+*********************************************************************************************************
+*                                RELEASING TASK: TIME BOTH WAYS OF RELEASING
+*********************************************************************************************************
+*/
+
+static  void  BenchRel (void *p_arg)
+{
+    double  tone;
+    double  tall;
+
+
+    (void)p_arg;
+    tone = BenchRelease(OS_FALSE);
+    tall = BenchRelease(OS_TRUE);
+    printf("releasing %u waiting tasks, interrupts masked for\n", (unsigned)BENCH_WORKERS);
+    printf("  one task at a time  %8.3f us\n", tone / (double)BENCH_ROUNDS * 1e6);
+    printf("  whole wait list     %8.3f us   %6.1fx shorter\n", tall / (double)BENCH_ROUNDS * 1e6,
+           tone / tall);
+    if (BenchRuns != 2u * BENCH_ROUNDS * BENCH_WORKERS) {
+        printf("%u of %u releases seen by the workers\n",
+               (unsigned)BenchRuns, (unsigned)(2u * BENCH_ROUNDS * BENCH_WORKERS));
+        exit(1);
+    }
+    exit(0);
+}
+
+/*
+*********************************************************************************************************
+*                                    WORKER TASK: WAIT AT THE BARRIER
+*********************************************************************************************************
+*/
+
+static  void  BenchWork (void *p_arg)
+{
+    INT8U  err;
+
+
+    (void)p_arg;
+    for (;;) {
+        OSSemPend(BenchSem, 0, &err);
+        if (err == OS_ERR_NONE) {
+            BenchRuns++;
+        }
+    }
+}
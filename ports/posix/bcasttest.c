@@ -0,0 +1,235 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                      BROADCAST WAKE-UP SELF-TEST
+*
+* File    : BCASTTEST.C
+* Version : V2.86
+*
+* Note(s) : 1) TEST_WORKERS tasks and a task waiting in OSEventPendMulti() wait on a semaphore and are
+*              released together: by OS_EventTaskRdyAll(), by OSSemPostN() with fewer units than tasks
+*              (the highest priority ones get them, a suspended task keeps its unit until resumed) and by
+*              OSSemPendAbort() with OS_PEND_OPT_BROADCAST.  Each released task records its result and
+*              suspends itself until the next case.
+*           2) Run with 'make check'.
+*********************************************************************************************************
+*/
+
+#include  "includes.h"
+#include  "test.h"
+
+#if OS_SEM_POST_N_EN == 0
+#error  "bcasttest needs OS_SEM_POST_N_EN set to 1"
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE           2048u
+#define  TEST_WORKERS               6u           /* Tasks waiting on the semaphore, priorities 1 to 6  */
+#define  TEST_MULTI_PRIO  (TEST_WORKERS + 1u)    /* Task waiting in OSEventPendMulti()                 */
+#define  TEST_CTRL_PRIO            20u
+#define  TEST_WAITERS     (TEST_WORKERS + 1u)
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestStk[TEST_WAITERS + 1][TEST_STK_SIZE];
+
+static  OS_EVENT        *TestSem;
+static  OS_EVENT        *TestQ;
+static  void            *TestQTbl[4];
+
+static  volatile INT8U   TestGot[TEST_WAITERS + 1];  /* Times each waiting task was released, by prio  */
+static  volatile INT8U   TestErr[TEST_WAITERS + 1];  /* Error returned to it the last time             */
+static  OS_EVENT        *volatile TestMultiRdy;      /* Event returned to the OSEventPendMulti() task  */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void   TestResumeAll(void);
+static  INT8U  TestWaiting(OS_EVENT *pevent);
+
+static  void   TestCtrl(void *p_arg);
+static  void   TestMulti(void *p_arg);
+static  void   TestWorker(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT8U  prio;
+
+
+    TestSem = OSSemCreate(0);
+    TestQ   = OSQCreate(&TestQTbl[0], 4);
+    TestStart("bcasttest");
+    for (prio = 1; prio <= TEST_WORKERS; prio++) {
+        OSTaskCreateExt(TestWorker, (void *)0, &TestStk[prio][TEST_STK_SIZE - 1], prio,
+                        prio, &TestStk[prio][0], TEST_STK_SIZE, (void *)0, 0);
+    }
+    OSTaskCreateExt(TestMulti, (void *)0, &TestStk[TEST_MULTI_PRIO][TEST_STK_SIZE - 1], TEST_MULTI_PRIO,
+                    TEST_MULTI_PRIO, &TestStk[TEST_MULTI_PRIO][0], TEST_STK_SIZE, (void *)0, 0);
+    OSTaskCreateExt(TestCtrl, (void *)0, &TestStk[0][TEST_STK_SIZE - 1], TEST_CTRL_PRIO,
+                    TEST_CTRL_PRIO, &TestStk[0][0], TEST_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                  LET THE WAITING TASKS WAIT AGAIN
+*********************************************************************************************************
+*/
+
+static  void  TestResumeAll (void)
+{
+    INT8U  prio;
+
+
+    for (prio = 1; prio <= TEST_WAITERS; prio++) {
+        (void)OSTaskResume(prio);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                NUMBER OF TASKS IN AN EVENT'S WAIT LIST
+*********************************************************************************************************
+*/
+
+static  INT8U  TestWaiting (OS_EVENT *pevent)
+{
+    INT8U  prio;
+    INT8U  nbr;
+
+
+    nbr = 0;
+    for (prio = 0; prio <= OS_LOWEST_PRIO; prio++) {
+        if ((pevent->OSEventTbl[prio >> OS_PRIO_ROW_SHIFT] & OS_PRIO_BIT_X(prio & OS_PRIO_ROW_MSK)) != 0) {
+            nbr++;
+        }
+    }
+    return (nbr);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      RELEASING TASK: THE CASES
+*********************************************************************************************************
+*/
+
+static  void  TestCtrl (void *p_arg)
+{
+    INT16U     nbr;
+    INT8U      prio;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+    (void)p_arg;
+    TEST_CHECK(TestWaiting(TestSem) == TEST_WAITERS);    /* 1: whole wait list readied at once     */
+    OS_ENTER_CRITICAL();
+    nbr = OS_EventTaskRdyAll(TestSem, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
+    OS_EXIT_CRITICAL();
+    OS_Sched();
+    TEST_CHECK(nbr == TEST_WAITERS);
+    for (prio = 1; prio <= TEST_WAITERS; prio++) {
+        TEST_CHECK(TestGot[prio] == 1 && TestErr[prio] == OS_ERR_NONE);
+    }
+    TEST_CHECK(TestMultiRdy == TestSem);
+    TEST_CHECK(TestSem->OSEventGrp == 0 && TestSem->OSEventNodeList == (OS_EVENT_NODE *)0);
+    TEST_CHECK(TestQ->OSEventGrp == 0 && TestQ->OSEventNodeList == (OS_EVENT_NODE *)0);
+
+    TestResumeAll();                                     /* 2: fewer units than waiting tasks      */
+    TEST_CHECK(TestWaiting(TestSem) == TEST_WAITERS);
+    TEST_CHECK(OSTaskSuspend(3) == OS_ERR_NONE);
+    TEST_CHECK(OSSemPostN(TestSem, 5) == OS_ERR_NONE);
+    for (prio = 1; prio <= 5; prio++) {                  /* Highest priorities served              */
+        TEST_CHECK(TestGot[prio] == ((prio == 3) ? 1 : 2));
+    }
+    TEST_CHECK(TestGot[6] == 1 && TestGot[TEST_MULTI_PRIO] == 1);
+    TEST_CHECK(TestSem->OSEventCnt == 0 && TestWaiting(TestSem) == 2);
+    TEST_CHECK(OSTaskResume(3) == OS_ERR_NONE);          /* Suspended task got its unit            */
+    TEST_CHECK(TestGot[3] == 2 && TestErr[3] == OS_ERR_NONE);
+    TEST_CHECK(OSSemPostN(TestSem, 4) == OS_ERR_NONE);   /* Two left once both are served          */
+    TEST_CHECK(TestGot[6] == 2 && TestGot[TEST_MULTI_PRIO] == 2 && TestMultiRdy == TestSem);
+    TEST_CHECK(TestSem->OSEventCnt == 2 && TestSem->OSEventGrp == 0);
+    TEST_CHECK(TestQ->OSEventGrp == 0 && TestQ->OSEventNodeList == (OS_EVENT_NODE *)0);
+    OSSemSet(TestSem, 0, &err);
+    TEST_CHECK(err == OS_ERR_NONE);
+
+    TestResumeAll();                                     /* 3: broadcast abort                     */
+    TEST_CHECK(OSSemPendAbort(TestSem, OS_PEND_OPT_BROADCAST, &err) == TEST_WAITERS);
+    TEST_CHECK(err == OS_ERR_PEND_ABORT);
+    for (prio = 1; prio <= TEST_WAITERS; prio++) {
+        TEST_CHECK(TestGot[prio] == 3 && TestErr[prio] == OS_ERR_PEND_ABORT);
+    }
+    TEST_CHECK(TestMultiRdy == TestSem && TestSem->OSEventCnt == 0);
+    TEST_CHECK(TestQ->OSEventGrp == 0 && TestQ->OSEventNodeList == (OS_EVENT_NODE *)0);
+    TestEnd("bcasttest");
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      TASKS WAITING ON THE SEMAPHORE
+*********************************************************************************************************
+*/
+
+static  void  TestWorker (void *p_arg)
+{
+    INT8U  prio;
+    INT8U  err;
+
+
+    (void)p_arg;
+    prio = OSTCBCur->OSTCBPrio;
+    for (;;) {
+        OSSemPend(TestSem, 0, &err);
+        TestErr[prio] = err;
+        TestGot[prio]++;
+        (void)OSTaskSuspend(OS_PRIO_SELF);
+    }
+}
+
+static  void  TestMulti (void *p_arg)
+{
+    OS_EVENT  *pevents[3];
+    OS_EVENT  *rdy[3];
+    void      *msgs[2];
+    INT8U      err;
+
+
+    (void)p_arg;
+    pevents[0] = TestQ;
+    pevents[1] = TestSem;
+    pevents[2] = (OS_EVENT *)0;
+    for (;;) {
+        (void)OSEventPendMulti(pevents, rdy, msgs, 0, &err);
+        TestMultiRdy                 = rdy[0];
+        TestErr[TEST_MULTI_PRIO]     = err;
+        TestGot[TEST_MULTI_PRIO]++;
+        (void)OSTaskSuspend(OS_PRIO_SELF);
+    }
+}
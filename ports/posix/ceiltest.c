@@ -0,0 +1,171 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                  PRIORITY CEILING MUTEX SELF-TEST
+*
+* File    : CEILTEST.C
+* Version : V2.86
+*
+* Note(s) : 1) Checks the immediate priority ceiling mutexes (OS_CEIL.C): the owner runs at the ceiling
+*              from the moment it takes the mutex, nested mutexes restore the right priority when
+*              released, a higher priority task below the ceiling does not preempt the owner, a waiting
+*              task is handed the mutex, and the timeout and error cases.
+*           2) Run with 'make check'.
+*********************************************************************************************************
+*/
+
+#include  "includes.h"
+#include  "test.h"
+
+#if OS_MUTEX_CEIL_EN == 0
+#error  "ceiltest needs OS_MUTEX_CEIL_EN set to 1"
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE           2048u
+#define  TEST_HIGH_PRIO             8u
+#define  TEST_LOW_PRIO             20u
+#define  TEST_CEIL_A                5u           /* Ceiling of mutex A, above both tasks               */
+#define  TEST_CEIL_B                3u           /* Ceiling of mutex B, nested in A                    */
+#define  TEST_CEIL_C               12u           /* Ceiling of mutex C, below TEST_HIGH_PRIO           */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestStk[2][TEST_STK_SIZE];
+
+static  OS_EVENT        *TestA;
+static  OS_EVENT        *TestB;
+static  OS_EVENT        *TestC;
+static  OS_EVENT        *TestGo;                 /* Lets the high priority task start its next case    */
+
+static  OS_TCB          *TestLowTCB;
+static  volatile INT8U   TestStep;               /* Last case done by the high priority task           */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  TestHigh(void *p_arg);
+static  void  TestLow(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT8U  err;
+
+
+    TestGo = OSSemCreate(0);
+    TestA  = OSMutexCeilCreate(TEST_CEIL_A, &err);
+    TestB  = OSMutexCeilCreate(TEST_CEIL_B, &err);
+    TestC  = OSMutexCeilCreate(TEST_CEIL_C, &err);
+    TestStart("ceiltest");
+    OSTaskCreateExt(TestHigh, (void *)0, &TestStk[0][TEST_STK_SIZE - 1], TEST_HIGH_PRIO,
+                    TEST_HIGH_PRIO, &TestStk[0][0], TEST_STK_SIZE, (void *)0, 0);
+    OSTaskCreateExt(TestLow, (void *)0, &TestStk[1][TEST_STK_SIZE - 1], TEST_LOW_PRIO,
+                    TEST_LOW_PRIO, &TestStk[1][0], TEST_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  HIGH PRIORITY TASK, BELOW CEILING A
+*********************************************************************************************************
+*/
+
+static  void  TestHigh (void *p_arg)
+{
+    INT8U  err;
+
+
+    (void)p_arg;
+    OSSemPend(TestGo, 0, &err);                  /* 1: waits for A, handed over by TestLow             */
+    OSMutexCeilPend(TestA, 0, &err);
+    TEST_CHECK(err == OS_ERR_NONE);
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_CEIL_A && OSTCBPrioTbl[TEST_CEIL_A] == OSTCBCur);
+    TEST_CHECK(TestA->OSEventPtr == (void *)OSTCBCur);
+    TEST_CHECK(TestLowTCB->OSTCBPrio == TEST_LOW_PRIO);
+    TestStep = 1;
+    TEST_CHECK(OSMutexCeilPost(TestA) == OS_ERR_NONE);
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_HIGH_PRIO && OSTCBPrioTbl[TEST_CEIL_A] == OS_TCB_RESERVED);
+    TEST_CHECK((TestA->OSEventCnt & 0x00FF) == 0x00FF);
+
+    OSSemPend(TestGo, 0, &err);                  /* 2: A held by TestLow: time out                     */
+    OSMutexCeilPend(TestA, 1, &err);
+    TEST_CHECK(err == OS_ERR_TIMEOUT);
+    TEST_CHECK(TestA->OSEventGrp == 0 && OSTCBCur->OSTCBPrio == TEST_HIGH_PRIO);
+    TEST_CHECK(OSMutexCeilAccept(TestA, &err) == OS_FALSE && err == OS_ERR_NONE);
+    TEST_CHECK(OSMutexCeilPost(TestA) == OS_ERR_NOT_MUTEX_OWNER);
+    OSMutexCeilPend(TestC, 0, &err);             /* Ceiling below the task's priority                  */
+    TEST_CHECK(err == OS_ERR_CEIL_LOWER);
+    TestStep = 2;
+    for (;;) {
+        OSTimeDly(OS_TICKS_PER_SEC);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          LOW PRIORITY TASK
+*********************************************************************************************************
+*/
+
+static  void  TestLow (void *p_arg)
+{
+    INT8U  err;
+
+
+    (void)p_arg;
+    TestLowTCB = OSTCBCur;
+    TEST_CHECK(OSMutexCeilCreate(TEST_HIGH_PRIO, &err) == (OS_EVENT *)0 && err == OS_ERR_PRIO_EXIST);
+
+    OSMutexCeilPend(TestA, 0, &err);             /* Runs at the ceiling at once ...                    */
+    TEST_CHECK(err == OS_ERR_NONE && OSTCBCur->OSTCBPrio == TEST_CEIL_A);
+    TEST_CHECK(OSTCBPrioTbl[TEST_CEIL_A] == OSTCBCur);
+    TEST_CHECK((OSRdyTbl[OSTCBCur->OSTCBY] & OSTCBCur->OSTCBBitX) != 0);
+    OSMutexCeilPend(TestB, 0, &err);             /* ... nested, at the higher ceiling ...              */
+    TEST_CHECK(err == OS_ERR_NONE && OSTCBCur->OSTCBPrio == TEST_CEIL_B);
+    TEST_CHECK(OSMutexCeilAccept(TestC, &err) == OS_TRUE && err == OS_ERR_NONE);
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_CEIL_B);  /* ... not lowered by a lower ceiling ...        */
+    TEST_CHECK(OSMutexCeilPost(TestC) == OS_ERR_NONE && OSTCBCur->OSTCBPrio == TEST_CEIL_B);
+    TEST_CHECK(OSMutexCeilPost(TestB) == OS_ERR_NONE && OSTCBCur->OSTCBPrio == TEST_CEIL_A);
+    TEST_CHECK(OSTCBPrioTbl[TEST_CEIL_B] == OS_TCB_RESERVED);
+
+    TEST_CHECK(OSSemPost(TestGo) == OS_ERR_NONE);    /* TestHigh ready but below the ceiling ...       */
+    TEST_CHECK(TestStep == 0);                   /* ... does not run ...                               */
+    OSTimeDly(2);                                /* ... until the owner waits: it pends on A           */
+    TEST_CHECK(TestStep == 0 && TestA->OSEventGrp != 0);
+    TEST_CHECK(OSMutexCeilPost(TestA) == OS_ERR_NONE);   /* Handed over to TestHigh, which runs        */
+    TEST_CHECK(TestStep == 1);
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_LOW_PRIO && OSTCBCur->OSTCBCeilNest == 0);
+
+    OSMutexCeilPend(TestA, 0, &err);
+    TEST_CHECK(err == OS_ERR_NONE);
+    TEST_CHECK(OSSemPost(TestGo) == OS_ERR_NONE);
+    OSTimeDly(5);
+    TEST_CHECK(TestStep == 2);
+    TEST_CHECK(OSMutexCeilPost(TestA) == OS_ERR_NONE && OSTCBCur->OSTCBPrio == TEST_LOW_PRIO);
+    TestEnd("ceiltest");
+}
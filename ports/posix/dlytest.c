@@ -0,0 +1,271 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                      DELAY AND TICKLESS SELF-TEST
+*
+* File    : DLYTEST.C
+* Version : V2.86
+*
+* Note(s) : 1) TEST_WORKERS tasks wake up periodically, three with OSTimeDly() and one when OSSemPend()
+*              times out, and a task misses its deadline every TEST_DL_PERIOD ticks.  The test checks that
+*              each task wakes up at the expected tick, that the tasks woken at the same tick run in
+*              priority order, and that each miss is recorded (OS_TRACE_EVT_DEADLINE) at the tick the
+*              deadline is reached.
+*           2) At the end, the ticks left reported by OSTaskQuery() are checked and a worker is woken up early
+*              with OSTimeDlyResume().
+*           3) 'make check' runs it three times: as dlytest, ticking every tick, as dlytest-tickless, built
+*              with OS_TICKLESS_EN, and as dlytest-dlylist, built with OS_DLY_LIST_EN.  All must see the
+*              same wakeups; the tickless build must also have woken up the idle task less than once every
+*              two ticks.
+*********************************************************************************************************
+*/
+
+#include  "includes.h"
+#include  "test.h"
+
+#if (OS_DEADLINE_EN == 0) || (OS_TRACE_EN == 0)
+#error  "dlytest needs OS_DEADLINE_EN and OS_TRACE_EN set to 1"
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE           2048u
+#define  TEST_WORKERS               4u           /* Tasks waking up periodically, priorities 10 to 13  */
+#define  TEST_WORKER_PRIO          10u
+#define  TEST_DL_PRIO              20u           /* Task missing its deadlines                         */
+#define  TEST_DL_FIRST              4u           /* First deadline, then every TEST_DL_PERIOD ticks    */
+#define  TEST_DL_PERIOD            30u
+#define  TEST_CTRL_PRIO             5u
+#define  TEST_DRAIN                50u           /* Ticks between two reads of the trace               */
+#define  TEST_TICKS               300u           /* Ticks the test runs                                */
+#define  TEST_LOG_SIZE            128u
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestStk[TEST_WORKERS + 2][TEST_STK_SIZE];
+
+static  const  INT16U    TestPeriod[TEST_WORKERS] = {7, 11, 13, 17};   /* Worker 3 pends with a timeout */
+
+static  OS_EVENT        *TestSem;                /* Never posted                                       */
+
+static  volatile INT32U  TestLogTime[TEST_LOG_SIZE];   /* Tick and worker of each wakeup, in order     */
+static  volatile INT8U   TestLogIx[TEST_LOG_SIZE];
+static  volatile INT16U  TestLogN;
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void    TestLeftChk(void);
+static  void    TestLogChk(void);
+static  INT16U  TestMissChk(INT16U nbr);
+
+static  void    TestCtrl(void *p_arg);
+static  void    TestDl(void *p_arg);
+static  void    TestWorker(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT8U  ix;
+
+
+    TestSem = OSSemCreate(0);
+    TestStart("dlytest");
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        OSTaskCreateExt(TestWorker, (void *)(size_t)ix, &TestStk[ix][TEST_STK_SIZE - 1], TEST_WORKER_PRIO + ix,
+                        TEST_WORKER_PRIO + ix, &TestStk[ix][0], TEST_STK_SIZE, (void *)0, 0);
+    }
+    OSTaskCreateExt(TestDl, (void *)0, &TestStk[TEST_WORKERS][TEST_STK_SIZE - 1], TEST_DL_PRIO,
+                    TEST_DL_PRIO, &TestStk[TEST_WORKERS][0], TEST_STK_SIZE, (void *)0, 0);
+    OSTaskCreateExt(TestCtrl, (void *)0, &TestStk[TEST_WORKERS + 1][TEST_STK_SIZE - 1], TEST_CTRL_PRIO,
+                    TEST_CTRL_PRIO, &TestStk[TEST_WORKERS + 1][0], TEST_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   CHECK THE TICKS LEFT BEFORE WAKEUPS
+*
+* Description: This function checks that OSTaskQuery() reports, for each worker, the ticks left before its
+*              next wakeup, then wakes up the first worker with OSTimeDlyResume(): it must run at once, and
+*              the other workers must still wake up on schedule.
+*********************************************************************************************************
+*/
+
+static  void  TestLeftChk (void)
+{
+    OS_TCB  tcb;
+    INT32U  now;
+    INT16U  n;
+    INT8U   ix;
+
+
+    now = OSTimeGet();
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        TEST_CHECK(OSTaskQuery(TEST_WORKER_PRIO + ix, &tcb) == OS_ERR_NONE);
+        TEST_CHECK(tcb.OSTCBDly == TestPeriod[ix] - now % TestPeriod[ix]);
+    }
+    n = TestLogN;
+    TEST_CHECK(OSTimeDlyResume(TEST_WORKER_PRIO) == OS_ERR_NONE);
+    TEST_CHECK(OSTaskQuery(TEST_WORKER_PRIO, &tcb) == OS_ERR_NONE && tcb.OSTCBDly == 0);
+    OSTimeDly(1);                                /* First worker runs, the others keep their wakeups   */
+    TEST_CHECK(TestLogN > n && TestLogTime[n] == now && TestLogIx[n] == 0);
+    TEST_CHECK(OSTaskQuery(TEST_WORKER_PRIO, &tcb) == OS_ERR_NONE && tcb.OSTCBDly == TestPeriod[0] - 1);
+    for (ix = 1; ix < TEST_WORKERS; ix++) {
+        TEST_CHECK(OSTaskQuery(TEST_WORKER_PRIO + ix, &tcb) == OS_ERR_NONE);
+        TEST_CHECK(tcb.OSTCBDly == TestPeriod[ix] - (now + 1) % TestPeriod[ix]);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                  COMPARE THE WAKEUPS WITH THE SCHEDULE
+*
+* Description: This function checks the log of the wakeups against the wakeups expected before tick
+*              TEST_TICKS: tick by tick, the workers whose period divides the tick, in priority order.
+*********************************************************************************************************
+*/
+
+static  void  TestLogChk (void)
+{
+    INT32U  t;
+    INT16U  n;
+    INT8U   ix;
+
+
+    n = 0;
+    for (t = 1; t < TEST_TICKS; t++) {
+        for (ix = 0; ix < TEST_WORKERS; ix++) {
+            if ((t % TestPeriod[ix]) == 0) {
+                TEST_CHECK(n < TestLogN && TestLogTime[n] == t && TestLogIx[n] == ix);
+                n++;
+            }
+        }
+    }
+    TEST_CHECK(TestLogN == n);
+}
+
+/*
+*********************************************************************************************************
+*                                 CHECK THE DEADLINE MISSES IN THE TRACE
+*
+* Description: This function reads the trace records logged since the last call and checks that each miss
+*              of TEST_DL_PRIO was recorded at its deadline.
+*
+* Arguments  : nbr       is the number of misses found so far.
+*
+* Returns    : The number of misses found so far, including the new ones.
+*********************************************************************************************************
+*/
+
+static  INT16U  TestMissChk (INT16U nbr)
+{
+    OS_TRACE_REC  rec;
+
+
+    while (OSTraceRead(&rec, 1) == 1) {
+        if ((rec.OSTraceEvent == OS_TRACE_EVT_DEADLINE) && (rec.OSTraceFrom == TEST_DL_PRIO)) {
+            TEST_CHECK(rec.OSTraceTime == TEST_DL_FIRST + (INT32U)nbr * TEST_DL_PERIOD);
+            nbr++;
+        }
+    }
+    TEST_CHECK(OSTraceLost == 0);
+    return (nbr);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CONTROLLING TASK: READ THE RESULTS
+*********************************************************************************************************
+*/
+
+static  void  TestCtrl (void *p_arg)
+{
+    INT16U  misses;
+    INT16U  t;
+
+
+    (void)p_arg;
+    misses = 0;
+    for (t = 0; t < TEST_TICKS; t += TEST_DRAIN) {
+        OSTimeDly(TEST_DRAIN);
+        misses = TestMissChk(misses);
+    }
+    TEST_CHECK(OSTimeGet() == TEST_TICKS);
+    TEST_CHECK(misses == (TEST_TICKS - TEST_DL_FIRST + TEST_DL_PERIOD - 1) / TEST_DL_PERIOD);
+    TestLogChk();
+#if OS_TICKLESS_EN > 0
+    TEST_CHECK(OSIdleCtr < TEST_TICKS / 2);              /* Idle task woke for the expiries only   */
+#else
+    TEST_CHECK(OSIdleCtr >= TEST_TICKS / 2);             /* Idle task woke for each tick           */
+#endif
+    TestLeftChk();
+    TestEnd("dlytest");
+}
+
+/*
+*********************************************************************************************************
+*                                           PERIODIC WORKERS
+*********************************************************************************************************
+*/
+
+static  void  TestWorker (void *p_arg)
+{
+    INT8U  ix;
+    INT8U  err;
+
+
+    ix = (INT8U)(size_t)p_arg;
+    for (;;) {
+        if (ix < TEST_WORKERS - 1) {
+            OSTimeDly(TestPeriod[ix]);
+        } else {
+            OSSemPend(TestSem, TestPeriod[ix], &err);
+            TEST_CHECK(err == OS_ERR_TIMEOUT);
+        }
+        if (TestLogN < TEST_LOG_SIZE) {
+            TestLogTime[TestLogN] = OSTimeGet();
+            TestLogIx[TestLogN]   = ix;
+            TestLogN++;
+        }
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                    TASK MISSING EACH OF ITS DEADLINES
+*********************************************************************************************************
+*/
+
+static  void  TestDl (void *p_arg)
+{
+    INT8U  err;
+
+
+    (void)p_arg;
+    TEST_CHECK(OSTaskPeriodSet(OS_PRIO_SELF, TEST_DL_PERIOD, TEST_DL_FIRST) == OS_ERR_NONE);
+    OSSemPend(TestSem, 0, &err);                 /* Never completes its job                            */
+}
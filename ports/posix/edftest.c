@@ -0,0 +1,238 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                   EARLIEST DEADLINE FIRST SELF-TEST
+*
+* File    : EDFTEST.C
+* Version : V2.86
+*
+* Note(s) : 1) TEST_WORKERS tasks scheduled by deadline wait on a semaphore.  The controlling task, of higher
+*              priority, sets their deadlines, readies them (all at once with OSSemPostN() or one by one
+*              with OSSemPost()), changes a deadline or a priority or deletes a task while they are
+*              ready, then lets them run: they must run in the order of their deadlines, ties broken by
+*              priority, and the heap of ready EDF tasks must be empty once they all wait again.
+*           2) Run with 'make check', which builds it with OS_SCHED_EDF_EN set to 1.
+*********************************************************************************************************
+*/
+
+#include  "includes.h"
+#include  "test.h"
+
+#if (OS_SCHED_EDF_EN == 0) || (OS_SEM_POST_N_EN == 0)
+#error  "edftest needs OS_SCHED_EDF_EN and OS_SEM_POST_N_EN set to 1"
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE           2048u
+#define  TEST_WORKERS               4u           /* EDF tasks, priorities 10 to 13                     */
+#define  TEST_WORKER_PRIO          10u
+#define  TEST_RAISED_PRIO           9u           /* Priority a ready worker is moved to                */
+#define  TEST_CTRL_PRIO             5u
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestStk[TEST_WORKERS + 1][TEST_STK_SIZE];
+
+static  OS_EVENT        *TestSem;
+
+static  volatile INT8U   TestLog[TEST_WORKERS + 1];  /* Workers in the order they ran                  */
+static  volatile INT8U   TestLogN;
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  TestCreate(INT8U ix);
+static  void  TestDeadlines(INT32U d0, INT32U d1, INT32U d2, INT32U d3);
+static  void  TestPost(INT8U nbr);
+static  void  TestRun(const INT8U *order, INT8U nbr);
+
+static  void  TestCtrl(void *p_arg);
+static  void  TestWorker(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT8U  ix;
+
+
+    TestSem = OSSemCreate(0);
+    TestStart("edftest");
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        TestCreate(ix);
+    }
+    OSTaskCreateExt(TestCtrl, (void *)0, &TestStk[TEST_WORKERS][TEST_STK_SIZE - 1], TEST_CTRL_PRIO,
+                    TEST_CTRL_PRIO, &TestStk[TEST_WORKERS][0], TEST_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                            CREATE A WORKER
+*********************************************************************************************************
+*/
+
+static  void  TestCreate (INT8U ix)
+{
+    OSTaskCreateExt(TestWorker, (void *)(size_t)ix, &TestStk[ix][TEST_STK_SIZE - 1], TEST_WORKER_PRIO + ix,
+                    TEST_WORKER_PRIO + ix, &TestStk[ix][0], TEST_STK_SIZE, (void *)0, 0);
+}
+
+/*
+*********************************************************************************************************
+*                                     SET THE DEADLINES OF THE WORKERS
+*********************************************************************************************************
+*/
+
+static  void  TestDeadlines (INT32U d0, INT32U d1, INT32U d2, INT32U d3)
+{
+    INT32U  now;
+
+
+    now = OSTimeGet();
+    TEST_CHECK(OSTaskDeadlineSet(TEST_WORKER_PRIO + 0, now + d0) == OS_ERR_NONE);
+    TEST_CHECK(OSTaskDeadlineSet(TEST_WORKER_PRIO + 1, now + d1) == OS_ERR_NONE);
+    TEST_CHECK(OSTaskDeadlineSet(TEST_WORKER_PRIO + 2, now + d2) == OS_ERR_NONE);
+    TEST_CHECK(OSTaskDeadlineSet(TEST_WORKER_PRIO + 3, now + d3) == OS_ERR_NONE);
+}
+
+/*
+*********************************************************************************************************
+*                                      READY THE WORKERS ONE BY ONE
+*********************************************************************************************************
+*/
+
+static  void  TestPost (INT8U nbr)
+{
+    while (nbr > 0) {
+        TEST_CHECK(OSSemPost(TestSem) == OS_ERR_NONE);
+        nbr--;
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                 LET THE READY WORKERS RUN AND CHECK ORDER
+*
+* Description: This function blocks the controlling task until the ready workers have run and waited on the
+*              semaphore again, then checks the order in which they ran.
+*
+* Arguments  : order     is the expected order of the workers.
+*
+*              nbr       is the number of workers expected to run.
+*********************************************************************************************************
+*/
+
+static  void  TestRun (const INT8U *order, INT8U nbr)
+{
+    INT8U  i;
+
+
+    TestLogN = 0;
+    OSTimeDly(1);
+    TEST_CHECK(TestLogN == nbr);
+    for (i = 0; (i < nbr) && (i < TestLogN); i++) {
+        TEST_CHECK(TestLog[i] == order[i]);
+    }
+    TEST_CHECK(OSEdfHeapCtr == 0);                       /* All EDF tasks wait again               */
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CONTROLLING TASK: THE CASES
+*********************************************************************************************************
+*/
+
+static  void  TestCtrl (void *p_arg)
+{
+    static  const  INT8U  order_rev[]  = {3, 2, 1, 0};
+    static  const  INT8U  order_late[] = {2, 1, 0, 3};
+    static  const  INT8U  order_prio[] = {0, 1, 2, 3};
+    static  const  INT8U  order_del[]  = {3, 0, 1};
+    static  const  INT8U  order_new[]  = {3, 0, 1, 2};
+
+
+    (void)p_arg;
+    OSTimeDly(1);                                        /* Let the workers wait on the semaphore  */
+    TEST_CHECK(OSEdfHeapCtr == 0);
+
+    TestDeadlines(400, 300, 200, 100);                   /* 1: readied at once, by deadline        */
+    TEST_CHECK(OSSemPostN(TestSem, TEST_WORKERS) == OS_ERR_NONE);
+    TEST_CHECK(OSEdfHeapCtr == TEST_WORKERS);
+    TestRun(order_rev, TEST_WORKERS);
+
+    TestPost(TEST_WORKERS);                              /* 2: readied one by one                  */
+    TEST_CHECK(OSEdfHeapCtr == TEST_WORKERS);
+    TestRun(order_rev, TEST_WORKERS);
+
+    TestPost(TEST_WORKERS);                              /* 3: deadline moved while ready          */
+    TEST_CHECK(OSTaskDeadlineSet(TEST_WORKER_PRIO + 3, OSTimeGet() + 500) == OS_ERR_NONE);
+    TestRun(order_late, TEST_WORKERS);
+
+    TestDeadlines(600, 600, 600, 600);                   /* 4: same deadline, by priority          */
+    TestPost(TEST_WORKERS);
+    TestRun(order_prio, TEST_WORKERS);
+
+    TestDeadlines(400, 400, 200, 100);                   /* 5: priority raised while ready         */
+    TestPost(TEST_WORKERS);
+    TEST_CHECK(OSTaskChangePrio(TEST_WORKER_PRIO + 1, TEST_RAISED_PRIO) == OS_ERR_NONE);
+    TestRun(order_rev, TEST_WORKERS);
+    TEST_CHECK(OSTaskChangePrio(TEST_RAISED_PRIO, TEST_WORKER_PRIO + 1) == OS_ERR_NONE);
+
+    TestPost(TEST_WORKERS);                              /* 6: task deleted while ready            */
+    TEST_CHECK(OSTaskDel(TEST_WORKER_PRIO + 2) == OS_ERR_NONE);
+    TEST_CHECK(OSEdfHeapCtr == TEST_WORKERS - 1);
+    TestRun(order_del, TEST_WORKERS - 1);
+
+    TestCreate(2);                                       /* 7: new task at its priority is fixed   */
+    TestRun(order_del, 0);
+    TEST_CHECK(OSTCBPrioTbl[TEST_WORKER_PRIO + 2]->OSTCBEdfEn == OS_FALSE);
+    TestPost(TEST_WORKERS);
+    TestRun(order_new, TEST_WORKERS);
+    TestEnd("edftest");
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    EDF TASKS WAITING ON THE SEMAPHORE
+*********************************************************************************************************
+*/
+
+static  void  TestWorker (void *p_arg)
+{
+    INT8U  ix;
+    INT8U  err;
+
+
+    ix = (INT8U)(size_t)p_arg;
+    for (;;) {
+        OSSemPend(TestSem, 0, &err);
+        if (TestLogN < sizeof(TestLog)) {
+            TestLog[TestLogN] = ix;
+            TestLogN++;
+        }
+    }
+}
@@ -0,0 +1,25 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*
+* File    : INCLUDES.H
+* Version : V2.86
+*
+* Note(s) : Master include file of the applications (lab1.c, example.c), in place of the one generated by
+*           the Nios II HAL.
+*********************************************************************************************************
+*/
+
+#ifndef  INCLUDES_H
+#define  INCLUDES_H
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+
+#include  <ucos_ii.h>
+
+#endif
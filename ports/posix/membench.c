@@ -0,0 +1,190 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                  OS_MemClr() / OS_MemCopy() BENCHMARK
+*
+* File    : MEMBENCH.C
+* Version : V2.86
+*
+* Note(s) : 1) Times OS_MemClr() and OS_MemCopy() against the byte loops they replace, on blocks the size of
+*              OSTCBTbl[] and OSEventTbl[] for small and large OS_MAX_TASKS / OS_MAX_EVENTS, then times a
+*              whole OSInit() with the configuration of this port.
+*           2) The byte loops go through a volatile pointer so that the host compiler does not turn them into
+*              memset() or memcpy(), as a target compiler generally does not.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+#include  "includes.h"
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  BENCH_NS_MIN          200000000L        /* Run each test for at least 0.2 s                   */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  INT8U  *BenchDest;
+static  INT8U  *BenchSrc;
+static  INT32U  BenchSize;
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  double  BenchRun(void (*pfnct)(void));
+
+static  void    BenchByteClr(void);
+static  void    BenchByteCopy(void);
+static  void    BenchMemClr(void);
+static  void    BenchMemCopy(void);
+static  void    BenchOSInit(void);
+
+static  void    BenchTbl(const char *pname, INT32U size);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    printf("%-26s %9s %11s %11s %7s\n", "block", "bytes", "byte loop", "OS_MemXxx", "ratio");
+    BenchTbl("OSTCBTbl[],   64 tasks",  (  64 + OS_N_SYS_TASKS) * (INT32U)sizeof(OS_TCB));
+    BenchTbl("OSTCBTbl[],  254 tasks",  ( 254 + OS_N_SYS_TASKS) * (INT32U)sizeof(OS_TCB));
+    BenchTbl("OSEventTbl[], 100 events",  100 * (INT32U)sizeof(OS_EVENT));
+    BenchTbl("OSEventTbl[],1000 events", 1000 * (INT32U)sizeof(OS_EVENT));
+    printf("\nOSInit() (OS_MAX_TASKS %d, OS_MAX_EVENTS %d): %.2f us\n",
+           OS_MAX_TASKS, OS_MAX_EVENTS, BenchRun(BenchOSInit) / 1000.0);
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                       BENCHMARK ONE TABLE SIZE
+*********************************************************************************************************
+*/
+
+static  void  BenchTbl (const char *pname, INT32U size)
+{
+    double  tbyte;
+    double  tword;
+
+
+    BenchDest = (INT8U *)malloc(size);
+    BenchSrc  = (INT8U *)calloc(size, 1);
+    BenchSize = size;
+    if (BenchDest == (INT8U *)0 || BenchSrc == (INT8U *)0) {
+        fprintf(stderr, "membench: out of memory\n");
+        exit(1);
+    }
+    tbyte = BenchRun(BenchByteClr);
+    tword = BenchRun(BenchMemClr);
+    printf("%-26s %9u %8.2f us %8.2f us %6.1fx  clear\n",
+           pname, (unsigned)size, tbyte / 1000.0, tword / 1000.0, tbyte / tword);
+    tbyte = BenchRun(BenchByteCopy);
+    tword = BenchRun(BenchMemCopy);
+    printf("%-26s %9u %8.2f us %8.2f us %6.1fx  copy\n",
+           "", (unsigned)size, tbyte / 1000.0, tword / 1000.0, tbyte / tword);
+    free(BenchDest);
+    free(BenchSrc);
+}
+
+/*
+*********************************************************************************************************
+*                                 RUN A TEST, RETURN NS PER ITERATION
+*********************************************************************************************************
+*/
+
+static  double  BenchRun (void (*pfnct)(void))
+{
+    struct timespec  t0;
+    struct timespec  t1;
+    long             n;
+    long             i;
+    double           ns;
+
+
+    n = 1;
+    for (;;) {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (i = 0; i < n; i++) {
+            (*pfnct)();
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns = (double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec);
+        if (ns >= (double)BENCH_NS_MIN) {
+            return (ns / (double)n);
+        }
+        n *= 2;
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                               TESTS
+*********************************************************************************************************
+*/
+
+static  void  BenchByteClr (void)
+{
+    volatile INT8U  *pdest;
+    INT32U           size;
+
+
+    pdest = BenchDest;
+    for (size = BenchSize; size > 0; size--) {
+        *pdest++ = (INT8U)0;
+    }
+}
+
+
+static  void  BenchByteCopy (void)
+{
+    volatile INT8U  *pdest;
+    INT8U           *psrc;
+    INT32U           size;
+
+
+    pdest = BenchDest;
+    psrc  = BenchSrc;
+    for (size = BenchSize; size > 0; size--) {
+        *pdest++ = *psrc++;
+    }
+}
+
+
+static  void  BenchMemClr (void)
+{
+    OS_MemClr(BenchDest, BenchSize);
+}
+
+
+static  void  BenchMemCopy (void)
+{
+    OS_MemCopy(BenchDest, BenchSrc, BenchSize);
+}
+
+
+static  void  BenchOSInit (void)
+{
+    OSInit();
+}
@@ -0,0 +1,117 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*
+* File    : OS_CPU.H
+* Version : V2.86
+*
+* Note(s) : 1) Each task runs on its own ucontext_t, stored at the top of the task's stack.
+*           2) The tick is SIGALRM, raised every 1/OS_TICKS_PER_SEC second by setitimer(ITIMER_REAL).
+*           3) 'Disabling interrupts' blocks SIGALRM with sigprocmask().
+*           4) With OS_CPU_SIM_EN set to 1, there is no SIGALRM: time is virtual (see OS_CPU_C.C).
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_H
+#define  OS_CPU_H
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*                                         (Compiler Specific)
+*********************************************************************************************************
+*/
+
+typedef unsigned char  BOOLEAN;
+typedef unsigned char  INT8U;                    /* Unsigned  8 bit quantity                           */
+typedef signed   char  INT8S;                    /* Signed    8 bit quantity                           */
+typedef unsigned short INT16U;                   /* Unsigned 16 bit quantity                           */
+typedef signed   short INT16S;                   /* Signed   16 bit quantity                           */
+typedef unsigned int   INT32U;                   /* Unsigned 32 bit quantity                           */
+typedef signed   int   INT32S;                   /* Signed   32 bit quantity                           */
+typedef float          FP32;                     /* Single precision floating point                    */
+typedef double         FP64;                     /* Double precision floating point                    */
+
+typedef INT32U         OS_STK;                   /* Each stack entry is 32-bit wide                    */
+typedef INT32U         OS_CPU_SR;                /* OS_TRUE if SIGALRM was already blocked             */
+
+/*
+*********************************************************************************************************
+*                                            CRITICAL SECTIONS
+*
+* Method #3:  Save the SIGALRM mask in a local variable and block SIGALRM.  Restoring the mask only unblocks
+*             SIGALRM if it was unblocked when the critical section was entered, so critical sections may
+*             be nested and may be used from the tick handler.
+*********************************************************************************************************
+*/
+
+#define  OS_CRITICAL_METHOD    3
+
+#define  OS_ENTER_CRITICAL()  {cpu_sr = OS_CPU_SR_Save();}
+#define  OS_EXIT_CRITICAL()   {OS_CPU_SR_Restore(cpu_sr);}
+
+/*
+*********************************************************************************************************
+*                                                 MISCELLANEOUS
+*********************************************************************************************************
+*/
+
+#define  OS_STK_GROWTH        1                  /* Stack grows from HIGH to LOW memory                */
+
+#define  OS_TASK_SW()         OSCtxSw()
+
+#define  OS_CPU_CYCLES        unsigned long long /* Time stamp counter (see OS_PROFILE.C)              */
+#define  OS_CPU_CYCLES_GET()  OS_CPU_CyclesGet()
+
+#define  OS_CPU_STK_PTR(ptcb) OS_CPU_StkPtr(ptcb)    /* Stack pointer of a task switched out (OS_STK.C) */
+
+#define  OS_CPU_ADDR           __UINTPTR_TYPE__   /* Integer as wide as a pointer (OS_CORE.C, OS_MEM.C) */
+#define  OS_CPU_MEM_WORD       INT32U __attribute__((__may_alias__))  /* OS_MemClr() & OS_MemCopy() word */
+
+#define  OS_CPU_LOAD_ACQ(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)       /* Ring indices (OS_RING.C) */
+#define  OS_CPU_STORE_REL(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+#ifndef  OS_CPU_STK_SIZE
+#define  OS_CPU_STK_SIZE   8192u                 /* Stack size (bytes) of tasks made by OSTaskCreate() */
+#endif
+
+#ifndef  OS_CPU_STK_MIN
+#define  OS_CPU_STK_MIN    4096u                 /* Smallest stack (bytes) below a task's context      */
+#endif
+
+#ifndef  OS_CPU_SIM_EN
+#define  OS_CPU_SIM_EN        0                  /* Run on a virtual clock (1) or on SIGALRM (0)       */
+#endif
+
+#if      OS_CPU_SIM_EN > 0                       /* Called by busy loops that wait for the tick        */
+#define  OS_CPU_SPIN()        OS_CPU_SimTick()
+#else
+#define  OS_CPU_SPIN()
+#endif
+
+/*
+*********************************************************************************************************
+*                                              PROTOTYPES
+*********************************************************************************************************
+*/
+
+OS_CPU_SR  OS_CPU_SR_Save(void);
+void       OS_CPU_SR_Restore(OS_CPU_SR cpu_sr);
+
+unsigned long long  OS_CPU_CyclesGet(void);
+
+struct os_tcb;
+OS_STK    *OS_CPU_StkPtr(struct os_tcb *ptcb);
+
+void       OSCtxSw(void);
+void       OSIntCtxSw(void);
+void       OSStartHighRdy(void);
+
+#if      OS_CPU_SIM_EN > 0
+void       OS_CPU_SimTick(void);
+#endif
+
+#endif
@@ -0,0 +1,783 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*
+* File    : OS_CPU_C.C
+* Version : V2.86
+*
+* Note(s) : 1) The whole kernel runs in a single process and thread.  A task's context is a ucontext_t placed
+*              at the top of the task's stack by OSTaskStkInit() and OSTCBStkPtr points to it.  Context
+*              switches are done with swapcontext(), which also saves and restores the SIGALRM mask.
+*
+*           2) The tick ISR is the SIGALRM handler.  When OSIntExit() finds a higher priority task ready, the
+*              switch is done from within the handler: the preempted task resumes in the handler and returns
+*              from it, which restores its signal mask.
+*
+*           3) As the Nios II HAL does, the port calls OSInit() before main() so that applications may create
+*              tasks without calling OSInit() themselves.
+*
+*           4) If the environment variable UCOS_EXIT_TICKS is set to N > 0, the process exits after N ticks
+*              so that applications which never return can be run from scripts.  Unset or 0, the process
+*              runs until the application ends it.
+*
+*           5) With OS_CPU_SIM_EN set to 1, the port is a simulator: there is no timer and no signal, and a
+*              tick only occurs when the running task consumes it.  The idle task consumes one tick per pass
+*              (or jumps to the next delay expiration with OS_TICKLESS_EN) and a task consumes one tick each
+*              time it calls OS_CPU_SPIN() in a busy loop.  A schedule then runs as fast as the host allows
+*              and is the same from one run to the next.
+*********************************************************************************************************
+*/
+
+#define  _GNU_SOURCE
+
+#include  <signal.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <sys/time.h>
+#include  <time.h>
+#include  <ucontext.h>
+#include  <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include  <x86intrin.h>
+#endif
+
+#include  <ucos_ii.h>
+
+/*
+*********************************************************************************************************
+*                                           LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  OS_CPU_TICK_USEC  (1000000UL / OS_TICKS_PER_SEC)   /* Tick period in microseconds            */
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct os_cpu_ctx {                      /* Context of a task, at the top of its stack         */
+    ucontext_t    OSCtx;                         /* Registers and signal mask                          */
+    void        (*OSCtxTask)(void *p_arg);       /* Task code and ...                                  */
+    void         *OSCtxArg;                      /* ... its argument                                   */
+} OS_CPU_CTX;
+
+/*
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  sigset_t  OS_CPU_TickSet;                /* Set holding only SIGALRM                           */
+static  INT32U    OS_CPU_ExitTicks;              /* Exit after this many ticks, 0 to run forever       */
+
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_ExitChk(INT32U ticks);
+
+static  void  OS_CPU_Init(void) __attribute__((constructor));
+
+static  void  OS_CPU_TaskStart(void);
+
+static  void  OS_CPU_TickInit(void);
+
+#if OS_CPU_SIM_EN == 0
+static  void  OS_CPU_TickHandler(int sig);
+
+static  void  OS_CPU_TimerSet(unsigned long usec);
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       DISABLE/ENABLE INTERRUPTS
+*
+* Description: These functions block and restore SIGALRM, the only 'interrupt' of this port.
+*
+* Arguments  : cpu_sr    is the value returned by OS_CPU_SR_Save().
+*
+* Returns    : OS_CPU_SR_Save() returns OS_TRUE if SIGALRM was already blocked.
+*
+* Note(s)    : 1) In the simulator, ticks only occur where the code asks for them: there is nothing to block.
+*********************************************************************************************************
+*/
+
+OS_CPU_SR  OS_CPU_SR_Save (void)
+{
+#if OS_CPU_SIM_EN == 0
+    sigset_t  old;
+
+
+    sigprocmask(SIG_BLOCK, &OS_CPU_TickSet, &old);
+    return ((OS_CPU_SR)sigismember(&old, SIGALRM));
+#else
+    return (0);
+#endif
+}
+
+
+void  OS_CPU_SR_Restore (OS_CPU_SR cpu_sr)
+{
+#if OS_CPU_SIM_EN == 0
+    if (cpu_sr == 0) {                           /* Only unblock if we blocked SIGALRM                 */
+        sigprocmask(SIG_UNBLOCK, &OS_CPU_TickSet, (sigset_t *)0);
+    }
+#else
+    (void)cpu_sr;
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         READ THE CYCLE COUNTER
+*
+* Description: This function returns the time stamp counter of the host CPU (see OS_CPU_CYCLES_GET()).
+*
+* Arguments  : none
+*
+* Returns    : The number of cycles since an arbitrary origin.
+*
+* Note(s)    : 1) On hosts other than x86, the monotonic clock is read instead and a 'cycle' is 1 ns.
+*              2) In the simulator, the counter still runs in real time: it measures where the host spends
+*                 its time, not the virtual time.
+*********************************************************************************************************
+*/
+
+unsigned long long  OS_CPU_CyclesGet (void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (__rdtsc());
+#else
+    struct timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((unsigned long long)ts.tv_sec * 1000000000uLL + (unsigned long long)ts.tv_nsec);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  STACK POINTER OF A TASK SWITCHED OUT
+*
+* Description: This function returns the stack pointer saved in the context of a task that is not running
+*              (see OS_CPU_STK_PTR()).
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.
+*
+* Returns    : The stack pointer of the task.
+*
+* Note(s)    : 1) OSTCBStkPtr points to the context at the top of the stack, not to the registers saved in
+*                 it.  On hosts other than Linux x86-64 and AArch64, OSTCBStkPtr is returned and the stack
+*                 is only tracked by the scans of OS_StkWmScan().
+*********************************************************************************************************
+*/
+
+OS_STK  *OS_CPU_StkPtr (OS_TCB *ptcb)
+{
+    OS_CPU_CTX  *pctx;
+
+
+    pctx = (OS_CPU_CTX *)ptcb->OSTCBStkPtr;
+#if   defined(__linux__) && defined(__x86_64__)
+    return ((OS_STK *)pctx->OSCtx.uc_mcontext.gregs[REG_RSP]);
+#elif defined(__linux__) && defined(__aarch64__)
+    return ((OS_STK *)pctx->OSCtx.uc_mcontext.sp);
+#else
+    return ((OS_STK *)pctx);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       OS INITIALIZATION HOOK
+*                                            (BEGINNING)
+*
+* Description: This function is called by OSInit() at the beginning of OSInit().
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts should be disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSInitHookBegin (void)
+{
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                       OS INITIALIZATION HOOK
+*                                               (END)
+*
+* Description: This function is called by OSInit() at the end of OSInit().
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts should be disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSInitHookEnd (void)
+{
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          TASK CREATION HOOK
+*
+* Description: This function is called when a task is created.
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task being created.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSTaskCreateHook (OS_TCB *ptcb)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskCreateHook(ptcb);
+#else
+    (void)ptcb;                                  /* Prevent compiler warning                           */
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TASK DELETION HOOK
+*
+* Description: This function is called when a task is deleted.
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task being deleted.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSTaskDelHook (OS_TCB *ptcb)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskDelHook(ptcb);
+#else
+    (void)ptcb;                                  /* Prevent compiler warning                           */
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                             IDLE TASK HOOK
+*
+* Description: This function is called by the idle task.  The host CPU is given back to other processes
+*              until the next tick.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) With OS_TICKLESS_EN set to 1, the idle task sleeps in OS_CPU_TickSuppress() instead.
+*              2) In the simulator, the idle task consumes one virtual tick instead of waiting for it.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSTaskIdleHook (void)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskIdleHook();
+#endif
+#if OS_TICKLESS_EN == 0
+#if OS_CPU_SIM_EN > 0
+    OS_CPU_SimTick();                            /* Idle time passes                                   */
+#else
+    pause();                                     /* Wait for the next tick                             */
+#endif
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           STATISTIC TASK HOOK
+*
+* Description: This function is called every second by uC/OS-II's statistics task.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+
+#if OS_CPU_HOOKS_EN > 0
+void  OSTaskStatHook (void)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskStatHook();
+#endif
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        INITIALIZE A TASK'S STACK
+*
+* Description: This function is called by either OSTaskCreate() or OSTaskCreateExt() to initialize the
+*              context of a task.
+*
+* Arguments  : task          is a pointer to the task code
+*
+*              p_arg         is a pointer to a user supplied data area that will be passed to the task
+*                            when the task first executes.
+*
+*              ptos          is a pointer to the top of stack.
+*
+*              opt           specifies options that can be used to alter the behavior of OSTaskStkInit().
+*                            (see uCOS_II.H for OS_TASK_OPT_xxx).
+*
+* Returns    : Always returns the location of the task's context (an OS_CPU_CTX).
+*
+* Note(s)    : 1) The context is placed at the top of the stack and the task's stack starts right below it.
+*              2) The task starts with SIGALRM unblocked, i.e. with interrupts enabled.
+*              3) makecontext() is given a stack of OS_CPU_STK_SIZE bytes ending at the context because the
+*                 bottom of the stack is not known here.  For tasks created with OSTaskCreateExt(),
+*                 OSTCBInitHook() then gives it the task's whole stack, from 'pbos' up to the context.
+*********************************************************************************************************
+*/
+
+OS_STK  *OSTaskStkInit (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT16U opt)
+{
+    OS_CPU_CTX  *pctx;
+    char        *ptop;
+
+
+    (void)opt;                                   /* 'opt' is not used, prevent warning                 */
+    ptop  = (char *)(ptos + 1);                  /* End of the stack area                              */
+    ptop -= sizeof(OS_CPU_CTX);
+    pctx  = (OS_CPU_CTX *)((unsigned long)ptop & ~15UL);     /* Align context on a 16 byte boundary    */
+    getcontext(&pctx->OSCtx);
+    pctx->OSCtx.uc_stack.ss_sp   = (void *)((char *)pctx - OS_CPU_STK_SIZE);
+    pctx->OSCtx.uc_stack.ss_size = OS_CPU_STK_SIZE;
+    pctx->OSCtx.uc_link          = (ucontext_t *)0;
+    sigemptyset(&pctx->OSCtx.uc_sigmask);        /* Task starts with interrupts enabled                */
+    pctx->OSCtxTask              = task;
+    pctx->OSCtxArg               = p_arg;
+    makecontext(&pctx->OSCtx, OS_CPU_TaskStart, 0);
+    return ((OS_STK *)pctx);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           TASK SWITCH HOOK
+*
+* Description: This function is called when a task switch is performed.  This allows you to perform other
+*              operations during a context switch.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) It is assumed that the global pointer 'OSTCBHighRdy' points to the TCB of the task that
+*                 will be 'switched in' (i.e. the highest priority task) and, 'OSTCBCur' points to the
+*                 task being switched out (i.e. the preempted task).
+*********************************************************************************************************
+*/
+#if (OS_CPU_HOOKS_EN > 0) && (OS_TASK_SW_HOOK_EN > 0)
+void  OSTaskSwHook (void)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TaskSwHook();
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           OS_TCBInit() HOOK
+*
+* Description: This function is called by OS_TCBInit() after setting up most of the TCB.
+*
+* Arguments  : ptcb    is a pointer to the TCB of the task being created.
+*
+* Note(s)    : 1) Interrupts may or may not be ENABLED during this call.
+*              2) The task's context was set up by OSTaskStkInit() with a default stack (see its note 3).
+*                 When the bottom of the stack is known, the context is given the task's own stack instead
+*                 and a stack with less than OS_CPU_STK_MIN bytes below the context is rejected.
+*********************************************************************************************************
+*/
+#if OS_CPU_HOOKS_EN > 0
+void  OSTCBInitHook (OS_TCB *ptcb)
+{
+#if OS_TASK_CREATE_EXT_EN > 0
+    OS_CPU_CTX  *pctx;
+    char        *pbos;
+    size_t       size;
+
+
+    if (ptcb->OSTCBStkBottom != (OS_STK *)0) {   /* Stack bottom known (OSTaskCreateExt())?            */
+        pctx = (OS_CPU_CTX *)ptcb->OSTCBStkPtr;
+        pbos = (char *)ptcb->OSTCBStkBottom;
+        size = (size_t)((char *)pctx - pbos);    /* Room left below the context                        */
+        if ((char *)pctx < pbos || size < OS_CPU_STK_MIN) {
+            fprintf(stderr, "uC/OS-II: stack of task %u is too small (%lu bytes, %u needed)\n",
+                    (unsigned)ptcb->OSTCBPrio,
+                    (unsigned long)(ptcb->OSTCBStkSize * sizeof(OS_STK)),
+                    (unsigned)(OS_CPU_STK_MIN + sizeof(OS_CPU_CTX)));
+            abort();
+        }
+        pctx->OSCtx.uc_stack.ss_sp   = (void *)pbos;
+        pctx->OSCtx.uc_stack.ss_size = size;
+        makecontext(&pctx->OSCtx, OS_CPU_TaskStart, 0);
+    }
+#endif
+#if OS_APP_HOOKS_EN > 0
+    App_TCBInitHook(ptcb);
+#else
+    (void)ptcb;                                  /* Prevent compiler warning                           */
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                               TICK HOOK
+*
+* Description: This function is called every tick.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts may or may not be ENABLED during this call.
+*********************************************************************************************************
+*/
+#if (OS_CPU_HOOKS_EN > 0) && (OS_TIME_TICK_HOOK_EN > 0)
+void  OSTimeTickHook (void)
+{
+#if OS_APP_HOOKS_EN > 0
+    App_TimeTickHook();
+#endif
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    START HIGHEST PRIORITY TASK READY-TO-RUN
+*
+* Description: This function is called by OSStart() to start the highest priority task that was created by
+*              your application before calling OSStart().
+*
+* Arguments  : none
+*
+* Note(s)    : 1) OSTCBHighRdy points to the OS_TCB of the task to start.
+*              2) The tick is started here, just before the first task runs.
+*********************************************************************************************************
+*/
+
+void  OSStartHighRdy (void)
+{
+#if OS_TASK_SW_HOOK_EN > 0
+    OSTaskSwHook();                              /* Call user definable hook                           */
+#endif
+    OSRunning = OS_TRUE;
+    OS_CPU_TickInit();
+    setcontext(&((OS_CPU_CTX *)OSTCBHighRdy->OSTCBStkPtr)->OSCtx);
+    perror("OSStartHighRdy");                    /* setcontext() only returns on error                 */
+    exit(1);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      TASK LEVEL CONTEXT SWITCH
+*
+* Description: This function is called by OS_Sched() (through OS_TASK_SW()) to switch to the highest
+*              priority task ready-to-run.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts (SIGALRM) are blocked when this function is called.  The mask is saved with the
+*                 context of the task being switched out and restored when it resumes.
+*********************************************************************************************************
+*/
+
+void  OSCtxSw (void)
+{
+    OS_CPU_CTX  *pold;
+
+
+#if OS_TASK_SW_HOOK_EN > 0
+    OSTaskSwHook();                              /* Call user definable hook                           */
+#endif
+    pold      = (OS_CPU_CTX *)OSTCBCur->OSTCBStkPtr;
+    OSTCBCur  = OSTCBHighRdy;
+    OSPrioCur = OSPrioHighRdy;
+    swapcontext(&pold->OSCtx, &((OS_CPU_CTX *)OSTCBHighRdy->OSTCBStkPtr)->OSCtx);
+}
+
+/*
+*********************************************************************************************************
+*                                   INTERRUPT LEVEL CONTEXT SWITCH
+*
+* Description: This function is called by OSIntExit() to switch to the highest priority task ready-to-run
+*              at the end of the tick handler.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) The preempted task is saved while it is in the signal handler.  When it resumes, it
+*                 returns from the handler to the code that was interrupted.
+*********************************************************************************************************
+*/
+
+void  OSIntCtxSw (void)
+{
+    OSCtxSw();
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        SUPPRESS TICKS WHILE IDLE
+*
+* Description: This function is called by the idle task, with interrupts disabled, when no other task is
+*              ready.  The periodic timer is reprogrammed to skip the next 'ticks' - 1 ticks and the
+*              process sleeps in sigwait() until the tick 'ticks' ticks from now.
+*
+* Arguments  : ticks     is the number of ticks until the next delay expires, 0 if no task is delayed.
+*
+* Returns    : The number of ticks that elapsed while asleep.
+*
+* Note(s)    : 1) The SIGALRM is consumed with sigwait() so that the tick handler does not run: the ticks
+*                 are accounted for by the caller.
+*              2) The first expiry is the time left until the next tick, read with getitimer(), plus
+*                 'ticks' - 1 periods: the ticks keep their phase, whatever the time the idle task took
+*                 to get here.
+*              3) If no task is delayed, the process still sleeps, until the next tick.
+*              4) A tick that occurred before the timer was reprogrammed is still pending.  If it is seen
+*                 before, the process only waits for it; if it occurred while reprogramming, it is the
+*                 first of the 'ticks' ticks.
+*              5) In the simulator, the virtual clock jumps to the next delay expiration.  If no task is
+*                 delayed, it advances by one tick, as it does without OS_TICKLESS_EN: the simulation
+*                 only ends after UCOS_EXIT_TICKS ticks, and runs forever if it is not set.
+*********************************************************************************************************
+*/
+#if OS_TICKLESS_EN > 0
+INT16U  OS_CPU_TickSuppress (INT16U ticks)
+{
+#if OS_CPU_SIM_EN == 0
+    struct itimerval  tmr;
+    sigset_t          pend;
+    int               sig;
+    unsigned long     usec;
+
+
+#else
+    if (ticks == 0) {                            /* Nothing delayed, one tick of idle time passes      */
+        ticks = 1;
+    }
+#endif
+    if (OS_CPU_ExitTicks > 0 && ticks > OS_CPU_ExitTicks) {
+        ticks = (INT16U)OS_CPU_ExitTicks;        /* Do not sleep past UCOS_EXIT_TICKS                  */
+    }
+#if OS_CPU_SIM_EN == 0
+    getitimer(ITIMER_REAL, &tmr);                /* Time left until the next tick, see Note #2         */
+    sigpending(&pend);
+    if ((ticks > 1) && (sigismember(&pend, SIGALRM) == 0)) {
+        usec  = (unsigned long)tmr.it_value.tv_sec * 1000000UL + (unsigned long)tmr.it_value.tv_usec;
+        usec += (unsigned long)(ticks - 1) * OS_CPU_TICK_USEC;
+        OS_CPU_TimerSet(usec);                   /* Skip the next 'ticks' - 1 ticks                    */
+        sigpending(&pend);
+        if (sigismember(&pend, SIGALRM)) {       /* First tick occurred while reprogramming, Note #4   */
+            sigwait(&OS_CPU_TickSet, &sig);
+        }
+    } else {                                     /* Sleep until the next tick only, Note #3 and #4     */
+        ticks = 1;
+    }
+    sigwait(&OS_CPU_TickSet, &sig);
+#endif
+    OS_CPU_ExitChk(ticks);
+    return (ticks);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           CONSUME A VIRTUAL TICK
+*
+* Description: This function is the tick 'ISR' of the simulator.  It is called by the idle task and, through
+*              OS_CPU_SPIN(), by tasks that busy wait for the tick (e.g. to use up their computation time).
+*
+* Arguments  : none
+*
+* Note(s)    : 1) If OSIntExit() finds a higher priority task ready, the caller is preempted here, exactly
+*                 where SIGALRM would have interrupted it.
+*********************************************************************************************************
+*/
+#if OS_CPU_SIM_EN > 0
+void  OS_CPU_SimTick (void)
+{
+    OSIntEnter();
+    OSTimeTick();
+    OS_CPU_ExitChk(1);
+    OSIntExit();                                 /* May switch to another task                         */
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     EXIT AFTER UCOS_EXIT_TICKS TICKS
+*
+* Description: This function counts the ticks that elapsed and ends the process once UCOS_EXIT_TICKS ticks
+*              have elapsed.
+*
+* Arguments  : ticks     is the number of ticks that just elapsed.
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_ExitChk (INT32U ticks)
+{
+    if (OS_CPU_ExitTicks > 0) {
+        if (OS_CPU_ExitTicks <= ticks) {
+            exit(0);
+        }
+        OS_CPU_ExitTicks -= ticks;
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                           PORT INITIALIZATION
+*
+* Description: This function is called before main() to set up the port and initialize uC/OS-II.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_Init (void)
+{
+    sigemptyset(&OS_CPU_TickSet);
+    sigaddset(&OS_CPU_TickSet, SIGALRM);
+    setvbuf(stdout, (char *)0, _IOLBF, 0);       /* Keep the output ordered when piped                 */
+    OSInit();
+}
+
+/*
+*********************************************************************************************************
+*                                          START OF EVERY TASK
+*
+* Description: This function is the entry point of every task context.  It calls the task code with its
+*              argument.  Should the task code return, the task is deleted.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_TaskStart (void)
+{
+    OS_CPU_CTX  *pctx;
+
+
+    pctx = (OS_CPU_CTX *)OSTCBCur->OSTCBStkPtr;
+    (*pctx->OSCtxTask)(pctx->OSCtxArg);
+#if OS_TASK_DEL_EN > 0
+    OSTaskDel(OS_PRIO_SELF);                     /* Task returned, delete it                           */
+#endif
+    for (;;) {
+        OSTimeDly(OS_TICKS_PER_SEC);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                              TICK ISR
+*
+* Description: This function is the SIGALRM handler.  SIGALRM is blocked while it runs.
+*
+* Arguments  : sig       is the signal number (not used).
+*********************************************************************************************************
+*/
+#if OS_CPU_SIM_EN == 0
+static  void  OS_CPU_TickHandler (int sig)
+{
+    (void)sig;
+    OSIntEnter();
+    OSTimeTick();
+    OS_CPU_ExitChk(1);
+    OSIntExit();                                 /* May switch to another task                         */
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         START THE TICK TIMER
+*
+* Description: This function installs the SIGALRM handler and starts the periodic timer.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) In the simulator, only UCOS_EXIT_TICKS is read.
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_TickInit (void)
+{
+#if OS_CPU_SIM_EN == 0
+    struct sigaction  act;
+#endif
+    char             *penv;
+
+
+    penv = getenv("UCOS_EXIT_TICKS");
+    if (penv != (char *)0) {
+        OS_CPU_ExitTicks = (INT32U)strtoul(penv, (char **)0, 10);
+    }
+#if OS_CPU_SIM_EN == 0
+    act.sa_handler = OS_CPU_TickHandler;
+    act.sa_flags   = SA_RESTART;                 /* Don't fail the system calls of tasks               */
+    sigemptyset(&act.sa_mask);                   /* SIGALRM itself is blocked in the handler           */
+    sigaction(SIGALRM, &act, (struct sigaction *)0);
+    OS_CPU_TimerSet(OS_CPU_TICK_USEC);
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                        PROGRAM THE TICK TIMER
+*
+* Description: This function programs ITIMER_REAL to fire after 'usec' microseconds, then every tick.
+*
+* Arguments  : usec      is the time until the next SIGALRM, in microseconds.
+*********************************************************************************************************
+*/
+#if OS_CPU_SIM_EN == 0
+static  void  OS_CPU_TimerSet (unsigned long usec)
+{
+    struct itimerval  tmr;
+
+
+    if (usec == 0) {                             /* 0 would stop the timer                             */
+        usec = 1;
+    }
+    tmr.it_interval.tv_sec  = (long)(OS_CPU_TICK_USEC / 1000000UL);  /* Tick period                    */
+    tmr.it_interval.tv_usec = (long)(OS_CPU_TICK_USEC % 1000000UL);
+    tmr.it_value.tv_sec     = (long)(usec / 1000000UL);
+    tmr.it_value.tv_usec    = (long)(usec % 1000000UL);
+    setitimer(ITIMER_REAL, &tmr, (struct itimerval *)0);
+}
+#endif
@@ -0,0 +1,420 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                         MULTI-PEND SELF-TEST
+*
+* File    : PENDTEST.C
+* Version : V2.86
+*
+* Note(s) : 1) Checks OSEventPendMulti() and OSEventPendMultiExt() on queues, semaphores, a mutex and an
+*              event flag group: a post, a timeout, events already available, an abort, the mutex priority
+*              inheritance, the flags consumed, the argument checks and the deletion of a waiting task.
+*              After each case, no task may be left in a wait list and all the nodes must be free.
+*           2) A task readied by one event must leave the wait lists of the others at once: a priority
+*              change right after the post must not put it back in them, a later post of an other event
+*              must neither end a delay of the task nor be lost, and of two events posted before the
+*              task runs, only the first is returned.
+*           3) A mutex owner that timed out in OSEventPendMulti() but has not run yet is still in the wait
+*              lists: when a higher priority task waits on the mutex, the owner is raised to the PIP and
+*              must be moved in those wait lists too.
+*           4) Run with 'make check'.
+*********************************************************************************************************
+*/
+
+#include  "includes.h"
+#include  "test.h"
+
+#if OS_EVENT_MULTI_EN == 0
+#error  "pendtest needs OS_EVENT_MULTI_EN set to 1"
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE           2048u
+#define  TEST_WAIT_PRIO             5u           /* Task waiting on the events                         */
+#define  TEST_DEL_PRIO              7u           /* Task deleted while it waits                        */
+#define  TEST_CTRL_PRIO            10u           /* Task posting to the events                         */
+#define  TEST_INH_PRIO              8u           /* Task raising the mutex owner, see Note #3          */
+#define  TEST_CHG_PRIO             12u           /* Task moved after it is readied, see Note #2        */
+#define  TEST_PIP                   2u           /* Priority inheritance priority of the mutex         */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK        TestStk[5][TEST_STK_SIZE];
+
+static  OS_EVENT     *TestQ[2];
+static  void         *TestQTbl[2][4];
+static  OS_EVENT     *TestSem[3];
+static  OS_EVENT     *TestMutex;
+static  OS_FLAG_GRP  *TestFlags;
+static  OS_EVENT     *TestGo;                    /* Lets the waiting task start its next case          */
+
+static  OS_EVENT     *TestEvents[6];             /* Queues and semaphores, NULL terminated             */
+
+static  volatile INT8U  TestStep;                /* Case the waiting task is pending in                */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void    TestClean(const char *which);
+static  INT16U  TestNodesFree(void);
+static  void    TestWaitFor(INT8U step);
+
+static  void    TestChg(void *p_arg);
+static  void    TestCtrl(void *p_arg);
+static  void    TestDel(void *p_arg);
+static  void    TestInh(void *p_arg);
+static  void    TestWait(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT8U  err;
+
+
+    TestQ[0]      = OSQCreate(&TestQTbl[0][0], 4);
+    TestQ[1]      = OSQCreate(&TestQTbl[1][0], 4);
+    TestSem[0]    = OSSemCreate(0);
+    TestSem[1]    = OSSemCreate(0);
+    TestSem[2]    = OSSemCreate(0);
+    TestMutex     = OSMutexCreate(TEST_PIP, &err);
+    TestFlags     = OSFlagCreate(0, &err);
+    TestGo        = OSSemCreate(0);
+    TestEvents[0] = TestQ[0];
+    TestEvents[1] = TestQ[1];
+    TestEvents[2] = TestSem[0];
+    TestEvents[3] = TestSem[1];
+    TestEvents[4] = TestSem[2];
+    TestEvents[5] = (OS_EVENT *)0;
+    TestStart("pendtest");
+    OSTaskCreateExt(TestWait, (void *)0, &TestStk[0][TEST_STK_SIZE - 1], TEST_WAIT_PRIO,
+                    TEST_WAIT_PRIO, &TestStk[0][0], TEST_STK_SIZE, (void *)0, 0);
+    OSTaskCreateExt(TestCtrl, (void *)0, &TestStk[1][TEST_STK_SIZE - 1], TEST_CTRL_PRIO,
+                    TEST_CTRL_PRIO, &TestStk[1][0], TEST_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                 CHECK THAT NO TASK WAITS ON THE EVENTS
+*********************************************************************************************************
+*/
+
+static  void  TestClean (const char *which)
+{
+    INT8U  i;
+
+
+    for (i = 0; TestEvents[i] != (OS_EVENT *)0; i++) {
+        if ((TestEvents[i]->OSEventGrp != 0) || (TestEvents[i]->OSEventNodeList != (OS_EVENT_NODE *)0)) {
+            printf("after %s: a task is left waiting on event %u\n", which, (unsigned)i);
+            TestFails++;
+        }
+    }
+    TEST_CHECK(TestMutex->OSEventGrp == 0);
+    TEST_CHECK(TestFlags->OSFlagWaitList == (void *)0);
+    TEST_CHECK(TestNodesFree() == OS_MAX_EVENT_NODES);
+}
+
+static  INT16U  TestNodesFree (void)
+{
+    OS_EVENT_NODE  *pnode;
+    INT16U          nbr;
+
+
+    nbr   = 0;
+    pnode = OSEventNodeFreeList;
+    while (pnode != (OS_EVENT_NODE *)0) {
+        nbr++;
+        pnode = pnode->OSEventNodeNext;
+    }
+    return (nbr);
+}
+
+/*
+*********************************************************************************************************
+*                          WAIT UNTIL THE WAITING TASK PENDS IN THE GIVEN CASE
+*********************************************************************************************************
+*/
+
+static  void  TestWaitFor (INT8U step)
+{
+    while (TestStep != step) {
+        OSTimeDly(1);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      WAITING TASK: THE CASES
+*********************************************************************************************************
+*/
+
+static  void  TestWait (void *p_arg)
+{
+    OS_EVENT  *pevents[4];
+    OS_EVENT  *rdy[6];
+    void      *msgs[5];
+    INT16U     nbr;
+    INT8U      err;
+
+
+    (void)p_arg;
+    TestStep = 1;                                                /* 1: one message posted              */
+    nbr = OSEventPendMulti(TestEvents, rdy, msgs, 0, &err);
+    TEST_CHECK(nbr == 1 && err == OS_ERR_NONE);
+    TEST_CHECK(rdy[0] == TestQ[1] && msgs[0] == (void *)'A' && rdy[1] == (OS_EVENT *)0);
+    TestClean("post");
+
+    TestStep = 2;                                                /* 2: nothing posted                  */
+    nbr = OSEventPendMulti(TestEvents, rdy, msgs, 3, &err);
+    TEST_CHECK(nbr == 0 && err == OS_ERR_TIMEOUT && rdy[0] == (OS_EVENT *)0);
+    TestClean("timeout");
+
+    OSSemPend(TestGo, 0, &err);                                  /* 3: events already available        */
+    nbr = OSEventPendMulti(TestEvents, rdy, msgs, 0, &err);
+    TEST_CHECK(nbr == 2 && err == OS_ERR_NONE);
+    TEST_CHECK(rdy[0] == TestQ[1] && msgs[0] == (void *)'B' && rdy[1] == TestSem[2] && rdy[2] == (OS_EVENT *)0);
+    nbr = OSEventPendMulti(TestEvents, rdy, msgs, 0, &err);
+    TEST_CHECK(nbr == 1 && err == OS_ERR_NONE && rdy[0] == TestSem[2]);
+    TestClean("available");
+
+    TestStep = 4;                                                /* 4: pend aborted                    */
+    nbr = OSEventPendMulti(TestEvents, rdy, msgs, 0, &err);
+    TEST_CHECK(nbr == 1 && err == OS_ERR_PEND_ABORT && rdy[0] == TestQ[0] && rdy[1] == (OS_EVENT *)0);
+    TestClean("abort");
+
+    OSSemPend(TestGo, 0, &err);                                  /* 5: mutex owned by TestCtrl         */
+    pevents[0] = TestQ[0];
+    pevents[1] = TestMutex;
+    pevents[2] = (OS_EVENT *)TestFlags;
+    pevents[3] = (OS_EVENT *)0;
+    TestStep   = 5;
+    nbr = OSEventPendMultiExt(pevents, rdy, msgs, 0x3, OS_FLAG_WAIT_SET_ANY | OS_FLAG_CONSUME, 0, &err);
+    TEST_CHECK(nbr == 1 && err == OS_ERR_NONE && rdy[0] == TestMutex && rdy[1] == (OS_EVENT *)0);
+    TEST_CHECK(TestMutex->OSEventPtr == (void *)OSTCBCur);
+    TEST_CHECK((TestMutex->OSEventCnt & 0x00FF) == TEST_WAIT_PRIO);
+    TestClean("mutex");
+    TEST_CHECK(OSMutexPost(TestMutex) == OS_ERR_NONE);
+
+    pevents[1] = (OS_EVENT *)TestFlags;                          /* 6: flags set, then consumed        */
+    pevents[2] = (OS_EVENT *)0;
+    TestStep   = 6;
+    nbr = OSEventPendMultiExt(pevents, rdy, msgs, 0x3, OS_FLAG_WAIT_SET_ANY | OS_FLAG_CONSUME, 0, &err);
+    TEST_CHECK(nbr == 1 && err == OS_ERR_NONE && rdy[0] == (OS_EVENT *)TestFlags);
+    TEST_CHECK(OSFlagPendGetFlagsRdy() == 0x1 && TestFlags->OSFlagFlags == 0x4);
+    TestClean("flags");
+
+    nbr = OSEventPendMultiExt(pevents, rdy, msgs, 0x3, OS_FLAG_WAIT_SET_ALL, 2, &err);
+    TEST_CHECK(nbr == 0 && err == OS_ERR_TIMEOUT);               /* 7: not ALL the flags set           */
+    TestClean("flags timeout");
+
+    pevents[0] = (OS_EVENT *)TestFlags;                          /* 8: argument checks                 */
+    (void)OSEventPendMultiExt(pevents, rdy, msgs, 0x1, OS_FLAG_WAIT_SET_ANY, 0, &err);
+    TEST_CHECK(err == OS_ERR_EVENT_TYPE);                        /* Two flag groups                    */
+    (void)OSEventPendMulti(pevents, rdy, msgs, 0, &err);
+    TEST_CHECK(err == OS_ERR_EVENT_TYPE);                        /* Flag group without flags           */
+    pevents[0] = TestQ[0];
+    (void)OSEventPendMultiExt(pevents, rdy, msgs, 0x1, 9, 0, &err);
+    TEST_CHECK(err == OS_ERR_FLAG_WAIT_TYPE);
+    TestClean("argument checks");
+
+    TestStep = 9;
+    for (;;) {
+        OSTimeDly(OS_TICKS_PER_SEC);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 POSTING TASK: DRIVE THE WAITING TASK
+*********************************************************************************************************
+*/
+
+static  void  TestCtrl (void *p_arg)
+{
+    INT8U  err;
+
+
+    (void)p_arg;
+    TestWaitFor(1);
+    TEST_CHECK(TestNodesFree() == OS_MAX_EVENT_NODES - 5);
+    TEST_CHECK(OSQPost(TestQ[1], (void *)'A') == OS_ERR_NONE);
+
+    TestWaitFor(2);
+    OSTimeDly(5);                                                /* Let it time out                    */
+    TEST_CHECK(OSQPost(TestQ[1], (void *)'B') == OS_ERR_NONE);
+    TEST_CHECK(OSSemPost(TestSem[2]) == OS_ERR_NONE);
+    TEST_CHECK(OSSemPost(TestSem[2]) == OS_ERR_NONE);
+    TEST_CHECK(OSSemPost(TestGo) == OS_ERR_NONE);
+
+    TestWaitFor(4);
+    TEST_CHECK(OSQPendAbort(TestQ[0], OS_PEND_OPT_NONE, &err) == 1 && err == OS_ERR_PEND_ABORT);
+
+    OSMutexPend(TestMutex, 0, &err);                             /* Own the mutex before it pends      */
+    TEST_CHECK(err == OS_ERR_NONE);
+    TEST_CHECK(OSSemPost(TestGo) == OS_ERR_NONE);
+    TestWaitFor(5);
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_PIP);                 /* Inherited from the waiting task    */
+    TEST_CHECK(OSMutexPost(TestMutex) == OS_ERR_NONE);
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_CTRL_PRIO);
+
+    TestWaitFor(6);
+    (void)OSFlagPost(TestFlags, 0x5, OS_FLAG_SET, &err);
+
+    TestWaitFor(9);
+    OSTaskCreateExt(TestDel, (void *)0, &TestStk[2][TEST_STK_SIZE - 1], TEST_DEL_PRIO,
+                    TEST_DEL_PRIO, &TestStk[2][0], TEST_STK_SIZE, (void *)0, 0);
+    TEST_CHECK(TestSem[1]->OSEventGrp != 0);                     /* It waits ...                       */
+    TEST_CHECK(OSTaskDel(TEST_DEL_PRIO) == OS_ERR_NONE);         /* ... and is deleted                 */
+    TestClean("delete");
+
+    OSTaskCreateExt(TestChg, (void *)0, &TestStk[3][TEST_STK_SIZE - 1], TEST_CHG_PRIO,
+                    TEST_CHG_PRIO, &TestStk[3][0], TEST_STK_SIZE, (void *)0, 0);
+    TestWaitFor(10);                                             /* 10: readied, then moved            */
+    TEST_CHECK(OSSemPost(TestSem[1]) == OS_ERR_NONE);
+    TEST_CHECK(OSTaskChangePrio(TEST_CHG_PRIO, TEST_CHG_PRIO + 2) == OS_ERR_NONE);
+    TEST_CHECK(TestSem[0]->OSEventGrp == 0 && TestSem[0]->OSEventNodeList == (OS_EVENT_NODE *)0);
+    TEST_CHECK(TestSem[1]->OSEventGrp == 0 && TestSem[1]->OSEventNodeList == (OS_EVENT_NODE *)0);
+    TEST_CHECK(TestNodesFree() == OS_MAX_EVENT_NODES - 1);       /* Only the node posted to is held    */
+
+    TestWaitFor(11);                                             /* 11: delayed, posted again          */
+    TEST_CHECK(OSSemPost(TestSem[1]) == OS_ERR_NONE);
+    TEST_CHECK(TestSem[1]->OSEventCnt == 1);                     /* Unit kept ...                      */
+    TEST_CHECK(TestStep == 11 && OSTCBPrioTbl[TEST_CHG_PRIO + 2]->OSTCBDly != 0);  /* ... still delayed */
+    TEST_CHECK(OSSemAccept(TestSem[1]) == 1);
+    TestClean("post and priority change");
+
+    TestWaitFor(12);                                             /* 12: two posts before it runs       */
+    TEST_CHECK(OSSemPost(TestSem[0]) == OS_ERR_NONE);
+    TEST_CHECK(OSSemPost(TestSem[1]) == OS_ERR_NONE);
+    TEST_CHECK(OSSemAccept(TestSem[1]) == 1);                    /* Unit of the second one kept        */
+    TestWaitFor(13);
+    TestClean("two posts");
+    TEST_CHECK(OSSemPost(TestGo) == OS_ERR_NONE);
+
+    TestWaitFor(14);                                             /* 14: owner timed out, not run yet   */
+    TEST_CHECK(OSTimeDlyResume(TEST_CHG_PRIO + 2) == OS_ERR_NONE);
+    OSTaskCreateExt(TestInh, (void *)0, &TestStk[4][TEST_STK_SIZE - 1], TEST_INH_PRIO,
+                    TEST_INH_PRIO, &TestStk[4][0], TEST_STK_SIZE, (void *)0, 0);
+    TestWaitFor(15);
+    TestClean("owner raised after a timeout");
+    TEST_CHECK(OSTaskDel(TEST_INH_PRIO) == OS_ERR_NONE);
+    TEST_CHECK(OSTaskDel(TEST_CHG_PRIO + 2) == OS_ERR_NONE);
+    TestEnd("pendtest");
+}
+
+/*
+*********************************************************************************************************
+*                               TASK READIED BY ONE OF TWO SEMAPHORES
+*********************************************************************************************************
+*/
+
+static  void  TestChg (void *p_arg)
+{
+    OS_EVENT  *pevents[3];
+    OS_EVENT  *rdy[3];
+    void      *msgs[2];
+    INT16U     nbr;
+    INT8U      err;
+
+
+    (void)p_arg;
+    pevents[0] = TestSem[0];
+    pevents[1] = TestSem[1];
+    pevents[2] = (OS_EVENT *)0;
+    TestStep   = 10;
+    nbr = OSEventPendMulti(pevents, rdy, msgs, 0, &err);
+    TEST_CHECK(nbr == 1 && err == OS_ERR_NONE && rdy[0] == TestSem[1] && rdy[1] == (OS_EVENT *)0);
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_CHG_PRIO + 2);
+    TestStep   = 11;
+    OSTimeDly(50);                                               /* Not ended by the next post         */
+    TestStep   = 12;
+    nbr = OSEventPendMulti(pevents, rdy, msgs, 0, &err);
+    TEST_CHECK(nbr == 1 && err == OS_ERR_NONE && rdy[0] == TestSem[0] && rdy[1] == (OS_EVENT *)0);
+    TestStep   = 13;
+    OSSemPend(TestGo, 0, &err);
+    OSMutexPend(TestMutex, 0, &err);
+    TEST_CHECK(err == OS_ERR_NONE);
+    TestStep   = 14;                                             /* Resumed, then raised to the PIP    */
+    nbr = OSEventPendMulti(pevents, rdy, msgs, OS_TICKS_PER_SEC, &err);
+    TEST_CHECK(nbr == 0 && err == OS_ERR_TIMEOUT && rdy[0] == (OS_EVENT *)0);
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_PIP);
+    TEST_CHECK(TestSem[0]->OSEventGrp == 0 && TestSem[1]->OSEventGrp == 0);
+    TEST_CHECK(OSMutexPost(TestMutex) == OS_ERR_NONE);          /* Handed over to TestInh             */
+    TEST_CHECK(OSTCBCur->OSTCBPrio == TEST_CHG_PRIO + 2);
+    TestStep   = 15;
+    for (;;) {
+        OSTimeDly(OS_TICKS_PER_SEC);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                             TASK WAITING ON THE MUTEX OWNED BY TestChg()
+*********************************************************************************************************
+*/
+
+static  void  TestInh (void *p_arg)
+{
+    OS_EVENT  *pevents[2];
+    OS_EVENT  *rdy[2];
+    void      *msgs[1];
+    INT16U     nbr;
+    INT8U      err;
+
+
+    (void)p_arg;
+    pevents[0] = TestMutex;
+    pevents[1] = (OS_EVENT *)0;
+    nbr = OSEventPendMulti(pevents, rdy, msgs, 0, &err);
+    TEST_CHECK(nbr == 1 && err == OS_ERR_NONE && rdy[0] == TestMutex);
+    TEST_CHECK(OSMutexPost(TestMutex) == OS_ERR_NONE);
+    for (;;) {
+        OSTimeDly(OS_TICKS_PER_SEC);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                          TASK DELETED WHILE IT WAITS ON THE SEMAPHORES
+*********************************************************************************************************
+*/
+
+static  void  TestDel (void *p_arg)
+{
+    OS_EVENT  *rdy[6];
+    void      *msgs[5];
+    INT8U      err;
+
+
+    (void)p_arg;
+    (void)OSEventPendMulti(&TestEvents[2], rdy, msgs, 0, &err);
+    TEST_CHECK(0);                                               /* Never readied                      */
+    for (;;) {
+        OSTimeDly(OS_TICKS_PER_SEC);
+    }
+}
@@ -0,0 +1,181 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                      PRIORITY RESOLUTION BENCHMARK
+*
+* File    : PRIOBENCH.C
+* Version : V2.86
+*
+* Note(s) : 1) A task at priority OS_LOWEST_PRIO - 2, the highest ready one, times the two lookups of the
+*              priority bitmaps (see PRIORITY BITMAPS in UCOS_II.H) where they cost the most, in the last
+*              row:
+*              - ready list: OS_Sched() finds the task itself as the highest priority ready task.
+*              - wait list:  the task puts itself in the wait list of an event with OS_EventTaskWait()
+*                            and OS_EventTaskRdy() finds it there and makes it ready again.
+*           2) Compare the layouts of the 256 priority build, on the virtual clock so that a critical
+*              section costs no system call:
+*                  make clean; make SIM=1 priobench CFLAGS="-O2 -DOS_LOWEST_PRIO=254"
+*              then with -DOS_CTZ_EN=1, then with -DOS_CTZ_EN=1 -DOS_PRIO_MAP64_EN=1.
+*           3) With up to 64 priorities the rows stay 8 bits wide and only OS_CTZ_EN changes the lookups:
+*                  make clean; make SIM=1 priobench CFLAGS="-O2"
+*              then with -DOS_CTZ_EN=1, times OSUnMapTbl[] against one count trailing zeros per level at
+*              priority 61 of the stock 64 priority build.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+#include  "includes.h"
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  BENCH_STK_SIZE          2048u
+#define  BENCH_ROUNDS             200uL
+#define  BENCH_LOOPS            10000uL          /* Lookups per round, in one critical section         */
+#define  BENCH_PRIO        (OS_LOWEST_PRIO - 2u)
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK     BenchStk[BENCH_STK_SIZE];
+
+static  OS_EVENT  *BenchSem;
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  double  BenchNow(void);
+static  double  BenchRdyList(void);
+static  double  BenchWaitList(void);
+
+static  void    BenchTask(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    BenchSem = OSSemCreate(0);
+    OSTaskCreateExt(BenchTask, (void *)0, &BenchStk[BENCH_STK_SIZE - 1], BENCH_PRIO,
+                    BENCH_PRIO, &BenchStk[0], BENCH_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                      MONOTONIC TIME IN SECONDS
+*********************************************************************************************************
+*/
+
+static  double  BenchNow (void)
+{
+    struct timespec  t;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((double)t.tv_sec + (double)t.tv_nsec / 1e9);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              TIME THE LOOKUP OF THE READY LIST (OS_Sched())
+*********************************************************************************************************
+*/
+
+static  double  BenchRdyList (void)
+{
+    double  t0;
+    double  t;
+    INT32U  i;
+    INT32U  j;
+
+
+    t = 0.0;
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        t0 = BenchNow();
+        for (j = 0; j < BENCH_LOOPS; j++) {
+            OS_Sched();                          /* Task itself is the highest priority: no switch     */
+        }
+        t += BenchNow() - t0;
+    }
+    return (t);
+}
+
+/*
+*********************************************************************************************************
+*                     TIME THE LOOKUP OF A WAIT LIST (OS_EventTaskWait() + OS_EventTaskRdy())
+*********************************************************************************************************
+*/
+
+static  double  BenchWaitList (void)
+{
+    double     t0;
+    double     t;
+    INT32U     i;
+    INT32U     j;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+    t = 0.0;
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        OS_ENTER_CRITICAL();
+        t0 = BenchNow();
+        for (j = 0; j < BENCH_LOOPS; j++) {
+            OS_EventTaskWait(BenchSem);
+            (void)OS_EventTaskRdy(BenchSem, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
+        }
+        t += BenchNow() - t0;
+        OSTCBCur->OSTCBEventPtr = (OS_EVENT *)0;
+        OS_EXIT_CRITICAL();
+    }
+    return (t);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    BENCHMARK TASK: TIME BOTH LOOKUPS
+*********************************************************************************************************
+*/
+
+static  void  BenchTask (void *p_arg)
+{
+    double  trdy;
+    double  twait;
+
+
+    (void)p_arg;
+    trdy  = BenchRdyList();
+    twait = BenchWaitList();
+    printf("priority %u of %u, rows of %u priorities, %s\n", (unsigned)BENCH_PRIO,
+           (unsigned)OS_LOWEST_PRIO, (unsigned)(1u << OS_PRIO_ROW_SHIFT),
+           (OS_CTZ_EN > 0) ? "count trailing zeros" : "OSUnMapTbl[]");
+    printf("  ready list, OS_Sched()                              %7.2f ns\n",
+           trdy  / (double)(BENCH_ROUNDS * BENCH_LOOPS) * 1e9);
+    printf("  wait list,  OS_EventTaskWait() + OS_EventTaskRdy() %7.2f ns\n",
+           twait / (double)(BENCH_ROUNDS * BENCH_LOOPS) * 1e9);
+    exit(0);
+}
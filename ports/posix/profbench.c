@@ -0,0 +1,159 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                           CPU PROFILE DEMO
+*
+* File    : PROFBENCH.C
+* Version : V2.86
+*
+* Note(s) : 1) Runs three tasks that busy wait for 1, 2 and 3 ticks out of every 10 ticks, then prints the
+*              CPU profile returned by OSProfileSnap(): run time of each task, ISR time and kernel overhead.
+*           2) Build with the profiler enabled:
+*                  make clean; make profbench CFLAGS="-O2 -DOS_PROFILE_EN=1"
+*              Add -DOS_TASK_STAT_EN=1 -DOS_STAT_LOAD_EN=1 to also print the loads computed by the statistic
+*              task (see OSTaskLoadGet()).
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+
+#include  "includes.h"
+
+#if OS_PROFILE_EN == 0
+#error  "Build profbench with CFLAGS=\"-O2 -DOS_PROFILE_EN=1\""
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  BENCH_STK_SIZE          2048u
+#define  BENCH_PERIOD              10u           /* Period of the busy tasks (ticks)                   */
+#define  BENCH_TICKS              300u           /* Length of the profile (ticks)                      */
+#define  BENCH_REPORT_PRIO          1u
+#define  BENCH_BUSY_PRIO            2u           /* Busy tasks use BENCH_BUSY_PRIO + 0..2              */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           BenchStk[4][BENCH_STK_SIZE];
+
+static  OS_PROFILE_SNAP  BenchSnap;              /* Too large for a task stack with many priorities    */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  BenchBusy(void *p_arg);
+static  void  BenchReport(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT8U  i;
+
+
+    OSTaskCreateExt(BenchReport, (void *)0, &BenchStk[0][BENCH_STK_SIZE - 1], BENCH_REPORT_PRIO,
+                    BENCH_REPORT_PRIO, &BenchStk[0][0], BENCH_STK_SIZE, (void *)0, 0);
+    for (i = 0; i < 3; i++) {
+        OSTaskCreateExt(BenchBusy, (void *)(long)(i + 1), &BenchStk[i + 1][BENCH_STK_SIZE - 1],
+                        BENCH_BUSY_PRIO + i, BENCH_BUSY_PRIO + i, &BenchStk[i + 1][0], BENCH_STK_SIZE,
+                        (void *)0, 0);
+    }
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                 BUSY TASK: RUN 'p_arg' TICKS OUT OF BENCH_PERIOD
+*********************************************************************************************************
+*/
+
+static  void  BenchBusy (void *p_arg)
+{
+    INT32U  load;
+    INT32U  t0;
+
+
+    load = (INT32U)(long)p_arg;
+    for (;;) {
+        t0 = OSTimeGet();
+        while (OSTimeGet() - t0 < load) {
+            OS_CPU_SPIN();
+        }
+        OSTimeDly((INT16U)(BENCH_PERIOD - load));
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     REPORT TASK: PRINT THE PROFILE
+*********************************************************************************************************
+*/
+
+static  void  BenchReport (void *p_arg)
+{
+    double  total;
+    INT8U   prio;
+#if OS_STAT_LOAD_EN > 0
+    INT16U  load[2];
+#endif
+
+
+    (void)p_arg;
+    OSProfileReset();
+    OSTimeDly(BENCH_TICKS);
+    OSProfileSnap(&BenchSnap);
+    total = (double)BenchSnap.OSProfileTotal;
+    printf("profile of %u ticks: %llu cycles, %u context switches, %u ISRs\n\n",
+           BENCH_TICKS, (unsigned long long)BenchSnap.OSProfileTotal,
+           (unsigned)BenchSnap.OSProfileCtxSwCtr, (unsigned)BenchSnap.OSProfileIntCtr);
+    printf("  prio  switches          cycles      cpu\n");
+    for (prio = 0; prio <= OS_LOWEST_PRIO; prio++) {
+        if (OSTCBPrioTbl[prio] != (OS_TCB *)0 && OSTCBPrioTbl[prio] != OS_TCB_RESERVED) {
+            printf("%6u %9u %15llu %7.2f%%\n", (unsigned)prio,
+                   (unsigned)BenchSnap.OSProfileTaskCtxSwCtr[prio],
+                   (unsigned long long)BenchSnap.OSProfileTaskCycles[prio],
+                   100.0 * (double)BenchSnap.OSProfileTaskCycles[prio] / total);
+        }
+    }
+    printf("   ISR %9s %15llu %7.2f%%\n", "",
+           (unsigned long long)BenchSnap.OSProfileInt, 100.0 * (double)BenchSnap.OSProfileInt / total);
+    printf("\nOSTimeTick()  %8.0f cycles/tick\n",
+           (double)BenchSnap.OSProfileTick / (double)BenchSnap.OSProfileIntCtr);
+    printf("OS_Sched()    %8.0f cycles/switch\n",
+           (double)BenchSnap.OSProfileSched / (double)BenchSnap.OSProfileCtxSwCtr);
+#if OS_STAT_LOAD_EN > 0
+    printf("\n  prio  load 100ms  load 1s\n");
+    for (prio = 0; prio <= OS_LOWEST_PRIO; prio++) {
+        if (OSTaskLoadGet(prio, OS_LOAD_WIN_100MS, &load[0]) == OS_ERR_NONE) {
+            OSTaskLoadGet(prio, OS_LOAD_WIN_1S, &load[1]);
+            printf("%6u %7u.%02u%% %5u.%02u%%\n", (unsigned)prio,
+                   load[0] / 100u, load[0] % 100u, load[1] / 100u, load[1] % 100u);
+        }
+    }
+    printf("   CPU %7u.%02u%% %5u.%02u%%\n",
+           OSCPULoad[OS_LOAD_WIN_100MS] / 100u, OSCPULoad[OS_LOAD_WIN_100MS] % 100u,
+           OSCPULoad[OS_LOAD_WIN_1S]    / 100u, OSCPULoad[OS_LOAD_WIN_1S]    % 100u);
+#endif
+    exit(0);
+}
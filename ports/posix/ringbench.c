@@ -0,0 +1,241 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                         LOCK-FREE RING BENCHMARK
+*
+* File    : RINGBENCH.C
+* Version : V2.86
+*
+* Note(s) : 1) Times message hand-off through a ring (OS_RING.C):
+*              - polled: OSRingPost() of a burst of messages followed by OSRingAccept() of the burst, with
+*                no critical section, then the same calls each wrapped in OS_ENTER_CRITICAL() and
+*                OS_EXIT_CRITICAL(), which is what a post costs when it locks interrupts.
+*              - blocking: a producer task posts bursts with the scheduler locked, as an ISR posts with
+*                the switch deferred to OSIntExit(), to a higher priority consumer waiting in
+*                OSRingPend().  The consumer is readied once per burst, not once per message.
+*           2) Build with the rings enabled:
+*                  make clean; make ringbench CFLAGS="-O2 -DOS_RING_EN=1"
+*              In the SIGALRM build each critical section costs two system calls; add SIM=1 to compare
+*              with critical sections that only mask a flag.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+#include  "includes.h"
+
+#if OS_RING_EN == 0
+#error  "Build ringbench with CFLAGS=\"-O2 -DOS_RING_EN=1\""
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  BENCH_STK_SIZE          2048u
+#define  BENCH_RING_SIZE          256u
+#define  BENCH_POLL_MSGS     20000000uL          /* Messages of each polled run                        */
+#define  BENCH_PEND_MSGS       200000uL          /* Messages of each blocking run                      */
+#define  BENCH_CONS_PRIO            1u
+#define  BENCH_PROD_PRIO            2u
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK   BenchStk[2][BENCH_STK_SIZE];
+
+static  OS_RING  BenchRing;
+static  void    *BenchRingTbl[BENCH_RING_SIZE];
+
+static  INT32U   BenchRcvd;                      /* Messages received by the consumer task             */
+static  INT32U   BenchErr;                       /* Messages received out of order                     */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  double  BenchNow(void);
+static  double  BenchPoll(INT32U burst, BOOLEAN lock);
+
+static  void    BenchCons(void *p_arg);
+static  void    BenchProd(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    double  tfree;
+    double  tlock;
+
+
+    OSRingCreate(&BenchRing, &BenchRingTbl[0], BENCH_RING_SIZE, OS_RING_OPT_NONE);
+    tfree = BenchPoll(BENCH_RING_SIZE / 4u, OS_FALSE);
+    tlock = BenchPoll(BENCH_RING_SIZE / 4u, OS_TRUE);
+    printf("polled, bursts of %u messages\n", BENCH_RING_SIZE / 4u);
+    printf("  lock-free          %8.2f M messages/s\n", (double)BENCH_POLL_MSGS / tfree / 1e6);
+    printf("  interrupts locked  %8.2f M messages/s   %6.1fx slower\n",
+           (double)BENCH_POLL_MSGS / tlock / 1e6, tlock / tfree);
+    if (BenchErr != 0) {
+        printf("%u messages received out of order\n", (unsigned)BenchErr);
+        return (1);
+    }
+
+    OSRingCreate(&BenchRing, &BenchRingTbl[0], BENCH_RING_SIZE, OS_RING_OPT_PEND);
+    OSTaskCreateExt(BenchCons, (void *)0, &BenchStk[0][BENCH_STK_SIZE - 1], BENCH_CONS_PRIO,
+                    BENCH_CONS_PRIO, &BenchStk[0][0], BENCH_STK_SIZE, (void *)0, 0);
+    OSTaskCreateExt(BenchProd, (void *)0, &BenchStk[1][BENCH_STK_SIZE - 1], BENCH_PROD_PRIO,
+                    BENCH_PROD_PRIO, &BenchStk[1][0], BENCH_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                      MONOTONIC TIME IN SECONDS
+*********************************************************************************************************
+*/
+
+static  double  BenchNow (void)
+{
+    struct timespec  t;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((double)t.tv_sec + (double)t.tv_nsec / 1e9);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                 PASS BENCH_POLL_MSGS MESSAGES IN BURSTS, WITH OR WITHOUT LOCKING INTERRUPTS
+*********************************************************************************************************
+*/
+
+static  double  BenchPoll (INT32U burst, BOOLEAN lock)
+{
+    double     t0;
+    INT32U     sent;
+    INT32U     rcvd;
+    INT32U     i;
+    INT8U      err;
+    void      *pmsg;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+    sent = 0;
+    rcvd = 0;
+    t0   = BenchNow();
+    while (sent < BENCH_POLL_MSGS) {
+        for (i = 0; i < burst; i++) {
+            if (lock == OS_TRUE) {
+                OS_ENTER_CRITICAL();
+                OSRingPost(&BenchRing, (void *)(long)sent);
+                OS_EXIT_CRITICAL();
+            } else {
+                OSRingPost(&BenchRing, (void *)(long)sent);
+            }
+            sent++;
+        }
+        for (i = 0; i < burst; i++) {
+            if (lock == OS_TRUE) {
+                OS_ENTER_CRITICAL();
+                pmsg = OSRingAccept(&BenchRing, &err);
+                OS_EXIT_CRITICAL();
+            } else {
+                pmsg = OSRingAccept(&BenchRing, &err);
+            }
+            if (pmsg != (void *)(long)rcvd) {
+                BenchErr++;
+            }
+            rcvd++;
+        }
+    }
+    return (BenchNow() - t0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              CONSUMER TASK: WAIT FOR MESSAGES IN OSRingPend()
+*********************************************************************************************************
+*/
+
+static  void  BenchCons (void *p_arg)
+{
+    void   *pmsg;
+    INT8U   err;
+
+
+    (void)p_arg;
+    for (;;) {
+        pmsg = OSRingPend(&BenchRing, 0, &err);
+        if (pmsg != (void *)(long)BenchRcvd) {
+            BenchErr++;
+        }
+        BenchRcvd++;
+    }
+}
+
+/*
+*********************************************************************************************************
+*                      PRODUCER TASK: POST BENCH_PEND_MSGS MESSAGES FOR EACH BURST SIZE
+*********************************************************************************************************
+*/
+
+static  void  BenchProd (void *p_arg)
+{
+    static  const  INT32U  bursts[] = {1u, 16u, BENCH_RING_SIZE / 4u};
+    double  t0;
+    double  t;
+    INT32U  sent;
+    INT32U  sw;
+    INT32U  i;
+    INT32U  b;
+
+
+    (void)p_arg;
+    printf("\nblocking consumer (OSRingPend())\n");
+    sent = 0;
+    for (b = 0; b < sizeof(bursts) / sizeof(bursts[0]); b++) {
+        sw = OSCtxSwCtr;
+        t0 = BenchNow();
+        for (i = 0; i < BENCH_PEND_MSGS; i += bursts[b]) {
+            OSSchedLock();                       /* Post the burst as an ISR would ...                 */
+            while (sent < (BENCH_PEND_MSGS * b) + i + bursts[b]) {
+                OSRingPost(&BenchRing, (void *)(long)sent);
+                sent++;
+            }
+            OSSchedUnlock();                     /* ... and let the consumer run once                  */
+        }
+        t  = BenchNow() - t0;
+        sw = OSCtxSwCtr - sw;
+        printf("  bursts of %3u      %8.2f M messages/s   %6.3f context switches/message\n",
+               (unsigned)bursts[b], (double)BENCH_PEND_MSGS / t / 1e6,
+               (double)sw / (double)BENCH_PEND_MSGS);
+    }
+    if (BenchRcvd != sent || BenchErr != 0) {
+        printf("%u messages sent, %u received, %u out of order\n",
+               (unsigned)sent, (unsigned)BenchRcvd, (unsigned)BenchErr);
+        exit(1);
+    }
+    exit(0);
+}
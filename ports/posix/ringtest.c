@@ -0,0 +1,169 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                            RING SELF-TEST
+*
+* File    : RINGTEST.C
+* Version : V2.86
+*
+* Note(s) : 1) Checks the lock-free rings (OS_RING.C): the size and option checks, FIFO order, a full and
+*              an empty ring, the wrap around of the indices, and a consumer waiting in OSRingPend() that
+*              times out, then gets each burst of messages, posted with the scheduler locked, in order.
+*           2) Run with 'make check'.
+*********************************************************************************************************
+*/
+
+#include  "includes.h"
+#include  "test.h"
+
+#if OS_RING_EN == 0
+#error  "ringtest needs OS_RING_EN set to 1"
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE           2048u
+#define  TEST_RING_SIZE             8u
+#define  TEST_BURST                 6u           /* Messages posted at once to the waiting consumer    */
+#define  TEST_BURSTS               10u
+#define  TEST_CONS_PRIO             5u           /* Consumer, above the producer                       */
+#define  TEST_PROD_PRIO            10u
+
+#define  TEST_MSG(n)     ((void *)(size_t)(n))   /* Message number 'n', 1 for the first one            */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestStk[2][TEST_STK_SIZE];
+
+static  OS_RING          TestRing;
+static  void            *TestRingTbl[TEST_RING_SIZE];
+
+static  volatile INT32U  TestRcvd;               /* Messages received by the consumer                  */
+static  volatile INT32U  TestWakes;              /* Times the consumer returned from a wait            */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  TestCons(void *p_arg);
+static  void  TestProd(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT32U  i;
+    INT32U  n;
+    INT8U   err;
+
+
+    TEST_CHECK(OSRingCreate(&TestRing, TestRingTbl, 6, OS_RING_OPT_NONE) == OS_ERR_RING_INVALID_SIZE);
+    TEST_CHECK(OSRingCreate(&TestRing, TestRingTbl, 0, OS_RING_OPT_NONE) == OS_ERR_RING_INVALID_SIZE);
+    TEST_CHECK(OSRingCreate(&TestRing, TestRingTbl, TEST_RING_SIZE, 7) == OS_ERR_INVALID_OPT);
+    TEST_CHECK(OSRingCreate(&TestRing, TestRingTbl, TEST_RING_SIZE, OS_RING_OPT_NONE) == OS_ERR_NONE);
+    TEST_CHECK(OSRingPend(&TestRing, 0, &err) == (void *)0 && err == OS_ERR_PEVENT_NULL);
+    TEST_CHECK(OSRingAccept(&TestRing, &err) == (void *)0 && err == OS_ERR_Q_EMPTY);
+
+    n = 0;
+    for (i = 0; i < 3 * TEST_RING_SIZE; i++) {   /* Keep the ring nearly full while indices wrap       */
+        if (i == 0) {
+            while (OSRingPost(&TestRing, TEST_MSG(n + 1)) == OS_ERR_NONE) {
+                n++;
+            }
+            TEST_CHECK(n == TEST_RING_SIZE);
+        } else {
+            TEST_CHECK(OSRingPost(&TestRing, TEST_MSG(n + 1)) == OS_ERR_NONE);
+            n++;
+            TEST_CHECK(OSRingPost(&TestRing, TEST_MSG(n + 1)) == OS_ERR_Q_FULL);
+        }
+        TEST_CHECK(OSRingAccept(&TestRing, &err) == TEST_MSG(n - TEST_RING_SIZE + 1) && err == OS_ERR_NONE);
+    }
+    for (i = TEST_RING_SIZE - 1; i > 0; i--) {
+        TEST_CHECK(OSRingAccept(&TestRing, &err) == TEST_MSG(n - i + 1) && err == OS_ERR_NONE);
+    }
+    TEST_CHECK(OSRingAccept(&TestRing, &err) == (void *)0 && err == OS_ERR_Q_EMPTY);
+
+    TEST_CHECK(OSRingCreate(&TestRing, TestRingTbl, TEST_RING_SIZE, OS_RING_OPT_PEND) == OS_ERR_NONE);
+    TestStart("ringtest");
+    OSTaskCreateExt(TestCons, (void *)0, &TestStk[0][TEST_STK_SIZE - 1], TEST_CONS_PRIO,
+                    TEST_CONS_PRIO, &TestStk[0][0], TEST_STK_SIZE, (void *)0, 0);
+    OSTaskCreateExt(TestProd, (void *)0, &TestStk[1][TEST_STK_SIZE - 1], TEST_PROD_PRIO,
+                    TEST_PROD_PRIO, &TestStk[1][0], TEST_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 CONSUMER: WAIT FOR THE MESSAGES IN ORDER
+*********************************************************************************************************
+*/
+
+static  void  TestCons (void *p_arg)
+{
+    void   *pmsg;
+    INT8U   err;
+
+
+    (void)p_arg;
+    pmsg = OSRingPend(&TestRing, 3, &err);       /* Nothing posted yet                                 */
+    TEST_CHECK(pmsg == (void *)0 && err == OS_ERR_TIMEOUT);
+    for (;;) {
+        pmsg = OSRingPend(&TestRing, 0, &err);
+        TestWakes++;
+        TEST_CHECK(err == OS_ERR_NONE && pmsg == TEST_MSG(TestRcvd + 1));
+        TestRcvd++;
+        while ((pmsg = OSRingAccept(&TestRing, &err)) != (void *)0) {
+            TEST_CHECK(pmsg == TEST_MSG(TestRcvd + 1));  /* Rest of the burst, without waiting         */
+            TestRcvd++;
+        }
+    }
+}
+
+/*
+*********************************************************************************************************
+*                               PRODUCER: POST BURSTS WITH THE SCHEDULER LOCKED
+*********************************************************************************************************
+*/
+
+static  void  TestProd (void *p_arg)
+{
+    INT32U  n;
+    INT32U  i;
+    INT32U  j;
+
+
+    (void)p_arg;
+    OSTimeDly(5);                                /* Let the consumer time out                          */
+    n = 0;
+    for (i = 0; i < TEST_BURSTS; i++) {
+        OSSchedLock();                           /* As an ISR would: the switch is deferred            */
+        for (j = 0; j < TEST_BURST; j++) {
+            n++;
+            TEST_CHECK(OSRingPost(&TestRing, TEST_MSG(n)) == OS_ERR_NONE);
+        }
+        OSSchedUnlock();
+        TEST_CHECK(TestRcvd == n);               /* The consumer took the whole burst ...              */
+        TEST_CHECK(TestWakes == i + 1);          /* ... and was readied once                           */
+    }
+    TestEnd("ringtest");
+}
@@ -0,0 +1,164 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                     ROUND-ROBIN TIME SLICING DEMO
+*
+* File    : RRBENCH.C
+* Version : V2.86
+*
+* Note(s) : 1) Creates as many busy worker tasks as OS_MAX_TASKS allows, all at priority BENCH_WORK_PRIO,
+*              then counts the ticks each worker ran: first without time slicing, where the first worker
+*              keeps the CPU since it never blocks, then with a time slice of BENCH_QUANTUM ticks (see
+*              OSSchedRRSet()), where each worker should run BENCH_QUANTUM ticks per round.
+*           2) Build with round-robin enabled, on the virtual clock so that the rounds take milliseconds:
+*                  make clean; make SIM=1 rrbench CFLAGS="-O2 -DOS_SCHED_RR_EN=1 -DOS_MAX_TASKS=250"
+*              In the SIGALRM build (without SIM=1) the workers count loop iterations instead of ticks.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+
+#include  "includes.h"
+
+#if OS_SCHED_RR_EN == 0
+#error  "Build rrbench with CFLAGS=\"-O2 -DOS_SCHED_RR_EN=1\""
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  BENCH_STK_SIZE          2048u
+#define  BENCH_QUANTUM              2u           /* Time slice of the workers (ticks)                  */
+#define  BENCH_ROUNDS               4u           /* Rounds of the workers per measurement              */
+#define  BENCH_REPORT_PRIO          0u
+#define  BENCH_WORK_PRIO            1u           /* Priority shared by all the workers                 */
+#define  BENCH_WORKERS            (OS_MAX_TASKS - 1)
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           BenchStk[BENCH_WORKERS + 1][BENCH_STK_SIZE];
+
+static  volatile INT32U  BenchCnt[BENCH_WORKERS];
+static  INT32U           BenchRan[BENCH_WORKERS];     /* Count of each worker in a measurement    */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  BenchMeasure(const char *title);
+
+static  void  BenchReport(void *p_arg);
+static  void  BenchWork(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT32U  i;
+
+
+    OSSchedRRSet(0);                             /* First measurement without time slicing             */
+    OSTaskCreateExt(BenchReport, (void *)0, &BenchStk[0][BENCH_STK_SIZE - 1], BENCH_REPORT_PRIO,
+                    BENCH_REPORT_PRIO, &BenchStk[0][0], BENCH_STK_SIZE, (void *)0, 0);
+    for (i = 0; i < BENCH_WORKERS; i++) {
+        OSTaskCreateExt(BenchWork, (void *)(long)i, &BenchStk[i + 1][BENCH_STK_SIZE - 1], BENCH_WORK_PRIO,
+                        (INT16U)(i + 1), &BenchStk[i + 1][0], BENCH_STK_SIZE, (void *)0, 0);
+    }
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                           RUN THE WORKERS FOR BENCH_ROUNDS ROUNDS AND PRINT THEIR SHARES
+*********************************************************************************************************
+*/
+
+static  void  BenchMeasure (const char *title)
+{
+    INT32U  min;
+    INT32U  max;
+    INT32U  ran;
+    INT32U  sw;
+    INT32U  i;
+
+
+    for (i = 0; i < BENCH_WORKERS; i++) {       /* Counts are not reset: a worker may be ...       */
+        BenchRan[i] = BenchCnt[i];               /* ... preempted in the middle of an increment   */
+    }
+    sw = OSCtxSwCtr;
+    OSTimeDly((INT16U)(BENCH_WORKERS * BENCH_QUANTUM * BENCH_ROUNDS));
+    sw  = OSCtxSwCtr - sw;
+    min = 0xFFFFFFFFuL;
+    max = 0;
+    ran = 0;
+    for (i = 0; i < BENCH_WORKERS; i++) {
+        BenchRan[i] = BenchCnt[i] - BenchRan[i];
+        if (BenchRan[i] < min) {
+            min = BenchRan[i];
+        }
+        if (BenchRan[i] > max) {
+            max = BenchRan[i];
+        }
+        if (BenchRan[i] != 0) {
+            ran++;
+        }
+    }
+    printf("%-24s %3u of %3u workers ran, %8u to %8u each, %6u context switches\n",
+           title, (unsigned)ran, (unsigned)BENCH_WORKERS, (unsigned)min, (unsigned)max, (unsigned)sw);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                           REPORT TASK: MEASURE WITHOUT, THEN WITH TIME SLICING
+*********************************************************************************************************
+*/
+
+static  void  BenchReport (void *p_arg)
+{
+    (void)p_arg;
+    printf("%u ticks per measurement (%u rounds of %u workers x %u ticks)\n",
+           (unsigned)(BENCH_WORKERS * BENCH_QUANTUM * BENCH_ROUNDS), (unsigned)BENCH_ROUNDS,
+           (unsigned)BENCH_WORKERS, (unsigned)BENCH_QUANTUM);
+    BenchMeasure("first in, first out:");
+    OSSchedRRSet(BENCH_QUANTUM);
+    BenchMeasure("time sliced:");
+    exit(0);
+}
+
+/*
+*********************************************************************************************************
+*                                  WORKER TASK: COUNT THE TIME IT RUNS
+*********************************************************************************************************
+*/
+
+static  void  BenchWork (void *p_arg)
+{
+    INT32U  i;
+
+
+    i = (INT32U)(long)p_arg;
+    for (;;) {
+        BenchCnt[i]++;
+        OS_CPU_SPIN();                           /* A tick of virtual time passes (SIM=1)              */
+    }
+}
@@ -0,0 +1,318 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                       ROUND-ROBIN SELF-TEST
+*
+* File    : RRTEST.C
+* Version : V2.86
+*
+* Note(s) : 1) TEST_WORKERS tasks are created at one priority (OS_RR.C) and wait on a semaphore.  The test
+*              checks that they first run in the order they were created, that posts wake them first in,
+*              first out, that busy workers run in turn for OSRRQuantum ticks each and that the first one
+*              keeps the CPU when the quantum is 0.  It then deletes the first task of the priority,
+*              creates a new one at it, and lets a task that is not the first one use OS_PRIO_SELF.
+*           2) Run with 'make check', which builds it with OS_SCHED_RR_EN set to 1.
+*********************************************************************************************************
+*/
+
+#include  "includes.h"
+#include  "test.h"
+
+#if OS_SCHED_RR_EN == 0
+#error  "rrtest needs OS_SCHED_RR_EN set to 1"
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE           2048u
+#define  TEST_WORKERS               4u           /* Tasks sharing TEST_PRIO                            */
+#define  TEST_PRIO                 10u
+#define  TEST_PIP                   4u           /* Priority reserved by the mutex                     */
+#define  TEST_CTRL_PRIO             5u
+#define  TEST_QUANTUM               2u           /* Time slice of the busy workers (ticks)             */
+#define  TEST_ROUNDS                3u
+#define  TEST_LOG_SIZE             64u
+#define  TEST_NONE               0xFFu
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestStk[TEST_WORKERS + 2][TEST_STK_SIZE];  /* Workers, the one created later and ctrl */
+
+static  OS_EVENT        *TestSem;
+static  OS_EVENT        *TestMutex;
+
+static  OS_TCB          *TestTCB[TEST_WORKERS + 1];  /* TCB of each worker                             */
+static  volatile INT32U  TestRan[TEST_WORKERS + 1];  /* Ticks each worker spun                         */
+static  volatile INT8U   TestLog[TEST_LOG_SIZE];     /* Workers in the order they got the CPU          */
+static  volatile INT8U   TestLogN;
+static  volatile INT8U   TestLast;                   /* Worker that got the CPU last                   */
+static  volatile BOOLEAN TestSpin;                   /* Workers spin once readied instead of waiting   */
+static  volatile INT8U   TestSelfIx;                 /* Worker that deletes itself with OS_PRIO_SELF   */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void     TestCreate(INT8U ix);
+static  void     TestLogReset(void);
+static  void     TestRun(INT8U ix);
+static  BOOLEAN  TestLogIs(const INT8U *pix, INT8U n);
+static  void     TestPost(INT8U n);
+
+static  void     TestCtrl(void *p_arg);
+static  void     TestWorker(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    INT8U  ix;
+    INT8U  err;
+
+
+    TestSem    = OSSemCreate(0);
+    TestMutex  = OSMutexCreate(TEST_PIP, &err);
+    TEST_CHECK(TestMutex != (OS_EVENT *)0 && err == OS_ERR_NONE);
+    TestSelfIx = TEST_NONE;
+    TestLogReset();
+    TestStart("rrtest");
+    OSSchedRRSet(0);
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        TestCreate(ix);
+    }
+    OSTaskCreateExt(TestCtrl, (void *)0, &TestStk[TEST_WORKERS + 1][TEST_STK_SIZE - 1], TEST_CTRL_PRIO,
+                    TEST_CTRL_PRIO, &TestStk[TEST_WORKERS + 1][0], TEST_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                        CREATE A WORKER AT TEST_PRIO
+*********************************************************************************************************
+*/
+
+static  void  TestCreate (INT8U ix)
+{
+    INT8U  err;
+
+
+    err = OSTaskCreateExt(TestWorker, (void *)(size_t)ix, &TestStk[ix][TEST_STK_SIZE - 1], TEST_PRIO,
+                          ix, &TestStk[ix][0], TEST_STK_SIZE, (void *)0, 0);
+    TEST_CHECK(err == OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     ORDER IN WHICH THE WORKERS RAN
+*********************************************************************************************************
+*/
+
+static  void  TestLogReset (void)
+{
+    TestLogN = 0;
+    TestLast = TEST_NONE;
+}
+
+static  void  TestRun (INT8U ix)
+{
+    if (TestLast != ix) {                        /* Log each turn once                                 */
+        TestLast = ix;
+        if (TestLogN < TEST_LOG_SIZE) {
+            TestLog[TestLogN] = ix;
+            TestLogN++;
+        }
+    }
+}
+
+static  BOOLEAN  TestLogIs (const INT8U *pix, INT8U n)
+{
+    INT8U  i;
+
+
+    if (TestLogN != n) {
+        return (OS_FALSE);
+    }
+    for (i = 0; i < n; i++) {
+        if (TestLog[i] != pix[i]) {
+            return (OS_FALSE);
+        }
+    }
+    return (OS_TRUE);
+}
+
+/*
+*********************************************************************************************************
+*                                  POST 'n' UNITS, THEN LET THE WORKERS RUN
+*********************************************************************************************************
+*/
+
+static  void  TestPost (INT8U n)
+{
+    TestLogReset();
+    while (n > 0) {                              /* Readies one worker per post, they run once ...     */
+        TEST_CHECK(OSSemPost(TestSem) == OS_ERR_NONE);
+        n--;
+    }
+    OSTimeDly(1);                                /* ... the controlling task blocks                    */
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CONTROLLING TASK: THE CASES
+*********************************************************************************************************
+*/
+
+static  void  TestCtrl (void *p_arg)
+{
+    static  const  INT8U  created[]  = {0, 1, 2, 3};
+    static  const  INT8U  first2[]   = {0, 1};
+    static  const  INT8U  last2[]    = {2, 3};
+    static  const  INT8U  joined[]   = {1, 2, 3, 4};
+    static  const  INT8U  left[]     = {1, 2, 4};
+    OS_TCB                *ptcb;
+    INT32U                 ran[TEST_WORKERS];
+    INT32U                 total;
+    INT8U                  ix;
+    INT8U                  i;
+
+
+    (void)p_arg;
+    OSTimeDly(1);                                        /* 1: first run in order of creation      */
+    TEST_CHECK(TestLogIs(created, TEST_WORKERS));
+    TEST_CHECK(OSTCBPrioTbl[TEST_PRIO] == TestTCB[0]);
+    TEST_CHECK(OSTaskCreateExt(TestWorker, (void *)0, &TestStk[TEST_WORKERS][TEST_STK_SIZE - 1], TEST_PIP,
+                               0, &TestStk[TEST_WORKERS][0], TEST_STK_SIZE, (void *)0, 0) == OS_ERR_PRIO_EXIST);
+    TEST_CHECK(OSTaskCreateExt(TestWorker, (void *)0, &TestStk[TEST_WORKERS][TEST_STK_SIZE - 1],
+                               OS_TASK_IDLE_PRIO, 0, &TestStk[TEST_WORKERS][0], TEST_STK_SIZE, (void *)0,
+                               0) == OS_ERR_PRIO_EXIST);
+    TEST_CHECK(OSTaskChangePrio(OS_PRIO_SELF, TEST_PRIO) == OS_ERR_PRIO_EXIST);
+
+    TestPost(2);                                         /* 2: posts wake the workers in order     */
+    TEST_CHECK(TestLogIs(first2, 2));
+    TEST_CHECK(TestSem->OSEventGrp != 0);                /* Others of the priority still wait      */
+    TestPost(2);                                         /* Not 0 and 1, which waited again later  */
+    TEST_CHECK(TestLogIs(last2, 2));
+    TEST_CHECK(TestSem->OSEventCnt == 0);                /* Each one got a unit                    */
+
+    OSSchedRRSet(TEST_QUANTUM);                          /* 3: busy workers run in turn            */
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        ran[ix] = TestRan[ix];
+    }
+    TestSpin = OS_TRUE;
+    TestLogReset();
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        TEST_CHECK(OSSemPost(TestSem) == OS_ERR_NONE);
+    }
+    OSTimeDly(TEST_WORKERS * TEST_QUANTUM * TEST_ROUNDS);
+    TEST_CHECK(TestLogN >= TEST_WORKERS * TEST_ROUNDS);
+    for (i = 0; i < TestLogN; i++) {
+        TEST_CHECK(TestLog[i] == i % TEST_WORKERS);
+    }
+    total = 0;
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        ran[ix] = TestRan[ix] - ran[ix];
+        total  += ran[ix];
+        TEST_CHECK(ran[ix] >= TEST_QUANTUM * (TEST_ROUNDS - 1) && ran[ix] <= TEST_QUANTUM * (TEST_ROUNDS + 1));
+    }
+    TEST_CHECK(total >= TEST_WORKERS * TEST_QUANTUM * TEST_ROUNDS - 1);
+    TestSpin = OS_FALSE;
+    OSTimeDly(1);
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        TEST_CHECK(TestTCB[ix]->OSTCBStat == OS_STAT_SEM);
+    }
+
+    OSSchedRRSet(0);                                     /* 4: without time slice, first one runs  */
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        ran[ix] = TestRan[ix];
+    }
+    TestSpin = OS_TRUE;
+    TestLogReset();
+    for (ix = 0; ix < TEST_WORKERS; ix++) {
+        TEST_CHECK(OSSemPost(TestSem) == OS_ERR_NONE);
+    }
+    OSTimeDly(TEST_WORKERS * TEST_QUANTUM * TEST_ROUNDS);
+    TEST_CHECK(TestLogIs(created, 1));
+    for (ix = 1; ix < TEST_WORKERS; ix++) {
+        TEST_CHECK(TestRan[ix] == ran[ix]);
+    }
+    TestSpin = OS_FALSE;
+    OSTimeDly(1);
+    TEST_CHECK(TestSem->OSEventCnt == 0);
+
+    TEST_CHECK(OSTaskDel(TEST_PRIO) == OS_ERR_NONE);     /* 5: delete the first task, add one      */
+    TEST_CHECK(OSTCBPrioTbl[TEST_PRIO] == TestTCB[1]);
+    TEST_CHECK(TestSem->OSEventGrp != 0);
+    TestCreate(TEST_WORKERS);
+    OSTimeDly(1);
+    TEST_CHECK(TestTCB[TEST_WORKERS] != (OS_TCB *)0);
+    TestPost(TEST_WORKERS);
+    TEST_CHECK(TestLogIs(joined, TEST_WORKERS));
+
+    TestSelfIx = 3;                                      /* 6: OS_PRIO_SELF from a later task      */
+    TestPost(TEST_WORKERS);
+    TEST_CHECK(TestLogIs(joined, TEST_WORKERS));
+    ptcb = OSTCBPrioTbl[TEST_PRIO];
+    for (i = 0; i < sizeof(left); i++) {                 /* Task left its priority, others remain  */
+        TEST_CHECK(ptcb == TestTCB[left[i]]);
+        ptcb = ptcb->OSTCBRRLevelNext;
+    }
+    TEST_CHECK(ptcb == OSTCBPrioTbl[TEST_PRIO]);
+    TestPost(sizeof(left));
+    TEST_CHECK(TestLogIs(left, sizeof(left)));
+    TEST_CHECK(TestSem->OSEventCnt == 0);
+    TestEnd("rrtest");
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    TASKS SHARING THE PRIORITY
+*********************************************************************************************************
+*/
+
+static  void  TestWorker (void *p_arg)
+{
+    OS_TCB  data;
+    INT8U   ix;
+    INT8U   err;
+
+
+    ix          = (INT8U)(size_t)p_arg;
+    TestTCB[ix] = OSTCBCur;
+    TestRun(ix);
+    for (;;) {
+        OSSemPend(TestSem, 0, &err);
+        TEST_CHECK(err == OS_ERR_NONE);
+        TestRun(ix);
+        while (TestSpin == OS_TRUE) {
+            TestRun(ix);
+            TestRan[ix]++;
+            OS_CPU_SPIN();                       /* A tick of virtual time passes                      */
+        }
+        if (ix == TestSelfIx) {                  /* Not the first task of the priority                 */
+            TEST_CHECK(OSTaskQuery(OS_PRIO_SELF, &data) == OS_ERR_NONE && data.OSTCBId == ix);
+            TEST_CHECK(OSTaskDel(OS_PRIO_SELF) == OS_ERR_NONE);
+        }
+    }
+}
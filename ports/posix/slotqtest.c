@@ -0,0 +1,183 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                         SLOT QUEUE SELF-TEST
+*
+* File    : SLOTQTEST.C
+* Version : V2.86
+*
+* Note(s) : 1) Checks the zero-copy slot queues (OS_SLOTQ.C): slots are reserved and handed out in FIFO
+*              order, a slot committed early waits for the older ones, a full queue and the invalid slots
+*              are reported, the queue wraps around once the slots are released, and a consumer waiting
+*              in OSSlotQPend() gets the slot committed or times out.
+*           2) Run with 'make check'.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+
+#include  "includes.h"
+#include  "test.h"
+
+#if OS_SLOTQ_EN == 0
+#error  "slotqtest needs OS_SLOTQ_EN set to 1"
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE           2048u
+#define  TEST_NSLOTS                4u
+#define  TEST_SLOT_SIZE            16u
+#define  TEST_CONS_PRIO             5u           /* Consumer, above the producer                       */
+#define  TEST_PROD_PRIO            10u
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK           TestStk[2][TEST_STK_SIZE];
+
+static  char             TestSlots[TEST_NSLOTS][TEST_SLOT_SIZE];
+static  OS_EVENT        *TestSQ;
+
+static  volatile INT8U   TestRcvd;               /* Messages read by the consumer                      */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  TestCons(void *p_arg);
+static  void  TestProd(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    char   bad[TEST_SLOT_SIZE];
+    char  *pslot[TEST_NSLOTS];
+    void  *p;
+    INT8U  err;
+    INT8U  i;
+
+
+    TEST_CHECK(OSSlotQCreate(TestSlots, 0, TEST_SLOT_SIZE, &err) == (OS_EVENT *)0);
+    TEST_CHECK(err == OS_ERR_SLOTQ_INVALID_SIZE);
+    TEST_CHECK(OSSlotQCreate(TestSlots, OS_SLOTQ_MAX_SLOTS + 1, TEST_SLOT_SIZE, &err) == (OS_EVENT *)0);
+    TEST_CHECK(err == OS_ERR_SLOTQ_INVALID_SIZE);
+    TestSQ = OSSlotQCreate(TestSlots, TEST_NSLOTS, TEST_SLOT_SIZE, &err);
+    TEST_CHECK(TestSQ != (OS_EVENT *)0 && err == OS_ERR_NONE);
+
+    for (i = 0; i < TEST_NSLOTS; i++) {          /* Slots reserved in order, until full                */
+        pslot[i] = (char *)OSSlotQReserve(TestSQ, &err);
+        TEST_CHECK(pslot[i] == TestSlots[i] && err == OS_ERR_NONE);
+    }
+    TEST_CHECK(OSSlotQReserve(TestSQ, &err) == (void *)0 && err == OS_ERR_Q_FULL);
+    TEST_CHECK(OSSlotQCommit(TestSQ, bad) == OS_ERR_SLOTQ_INVALID_SLOT);
+    TEST_CHECK(OSSlotQCommit(TestSQ, pslot[0] + 1) == OS_ERR_SLOTQ_INVALID_SLOT);
+
+    TEST_CHECK(OSSlotQCommit(TestSQ, pslot[1]) == OS_ERR_NONE);  /* Newer slot committed first ...    */
+    TEST_CHECK(OSSlotQAccept(TestSQ, &err) == (void *)0 && err == OS_ERR_Q_EMPTY);  /* ... waits     */
+    TEST_CHECK(OSSlotQCommit(TestSQ, pslot[1]) == OS_ERR_SLOTQ_INVALID_SLOT);
+    TEST_CHECK(OSSlotQCommit(TestSQ, pslot[0]) == OS_ERR_NONE);
+    TEST_CHECK(OSSlotQAccept(TestSQ, &err) == (void *)pslot[0] && err == OS_ERR_NONE);
+    TEST_CHECK(OSSlotQAccept(TestSQ, &err) == (void *)pslot[1] && err == OS_ERR_NONE);
+    TEST_CHECK(OSSlotQAccept(TestSQ, &err) == (void *)0 && err == OS_ERR_Q_EMPTY);
+    TEST_CHECK(OSSlotQRelease(TestSQ, pslot[2]) == OS_ERR_SLOTQ_INVALID_SLOT);  /* Not borrowed     */
+
+    TEST_CHECK(OSSlotQRelease(TestSQ, pslot[1]) == OS_ERR_NONE);  /* Released out of order ...       */
+    TEST_CHECK(OSSlotQReserve(TestSQ, &err) == (void *)0 && err == OS_ERR_Q_FULL);  /* ... slot 0 next */
+    TEST_CHECK(OSSlotQRelease(TestSQ, pslot[0]) == OS_ERR_NONE);
+    p = OSSlotQReserve(TestSQ, &err);            /* Wrapped around to slot 0                           */
+    TEST_CHECK(p == (void *)pslot[0] && err == OS_ERR_NONE);
+    TEST_CHECK(OSSlotQCommit(TestSQ, pslot[2]) == OS_ERR_NONE);
+    TEST_CHECK(OSSlotQCommit(TestSQ, pslot[3]) == OS_ERR_NONE);
+    TEST_CHECK(OSSlotQCommit(TestSQ, p) == OS_ERR_NONE);
+    for (i = 0; i < 3; i++) {                    /* Slots 2, 3 then 0                                  */
+        p = OSSlotQAccept(TestSQ, &err);
+        TEST_CHECK(p == (void *)pslot[(i + 2) % TEST_NSLOTS] && err == OS_ERR_NONE);
+        TEST_CHECK(OSSlotQRelease(TestSQ, p) == OS_ERR_NONE);
+    }
+
+    TestStart("slotqtest");
+    OSTaskCreateExt(TestCons, (void *)0, &TestStk[0][TEST_STK_SIZE - 1], TEST_CONS_PRIO,
+                    TEST_CONS_PRIO, &TestStk[0][0], TEST_STK_SIZE, (void *)0, 0);
+    OSTaskCreateExt(TestProd, (void *)0, &TestStk[1][TEST_STK_SIZE - 1], TEST_PROD_PRIO,
+                    TEST_PROD_PRIO, &TestStk[1][0], TEST_STK_SIZE, (void *)0, 0);
+    OSStart();
+    return (0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CONSUMER: READ THE MESSAGES IN PLACE
+*********************************************************************************************************
+*/
+
+static  void  TestCons (void *p_arg)
+{
+    char   expect[TEST_SLOT_SIZE];
+    char  *pslot;
+    INT8U  err;
+
+
+    (void)p_arg;
+    pslot = (char *)OSSlotQPend(TestSQ, 3, &err);    /* Nothing committed                              */
+    TEST_CHECK(pslot == (char *)0 && err == OS_ERR_TIMEOUT);
+    TEST_CHECK(TestSQ->OSEventGrp == 0);
+    for (;;) {
+        pslot = (char *)OSSlotQPend(TestSQ, 0, &err);
+        TEST_CHECK(pslot != (char *)0 && err == OS_ERR_NONE);
+        if (pslot != (char *)0) {
+            snprintf(expect, sizeof(expect), "message %u", (unsigned)TestRcvd);
+            TEST_CHECK(strcmp(pslot, expect) == 0);
+            TEST_CHECK(OSSlotQRelease(TestSQ, pslot) == OS_ERR_NONE);
+        }
+        TestRcvd++;
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                 PRODUCER: WRITE THE MESSAGES IN PLACE
+*********************************************************************************************************
+*/
+
+static  void  TestProd (void *p_arg)
+{
+    char   *pslot;
+    INT8U   err;
+    INT8U   i;
+
+
+    (void)p_arg;
+    OSTimeDly(5);                                /* Let the consumer time out                          */
+    for (i = 0; i < 3 * TEST_NSLOTS; i++) {      /* The consumer reads each one at once                */
+        pslot = (char *)OSSlotQReserve(TestSQ, &err);
+        TEST_CHECK(pslot != (char *)0 && err == OS_ERR_NONE);
+        if (pslot == (char *)0) {
+            break;
+        }
+        snprintf(pslot, TEST_SLOT_SIZE, "message %u", (unsigned)i);
+        TEST_CHECK(OSSlotQCommit(TestSQ, pslot) == OS_ERR_NONE);
+        TEST_CHECK(TestRcvd == i + 1);
+    }
+    TEST_CHECK(OSSlotQDel(TestSQ, OS_DEL_NO_PEND, &err) == TestSQ && err == OS_ERR_TASK_WAITING);
+    TestEnd("slotqtest");
+}
@@ -0,0 +1,190 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                     STACK HIGH-WATER MARK BENCHMARK
+*
+* File    : STKBENCH.C
+* Version : V2.86
+*
+* Note(s) : 1) Creates OS_MAX_TASKS tasks with 4096 entry cleared stacks (as in lab1), marks a different depth
+*              of each stack as used, then times one pass of the statistic task over all the stacks: the
+*              full scans of OSTaskStkChk() against the scans from the high-water marks of OSTaskStkWmGet().
+*              The first call of OSTaskStkWmGet() scans the stack, the following ones only check the entries
+*              below the mark.  The results of both functions are compared.
+*           2) Then makes a stack grow into its red zone and shows the overflow reported to the hook.
+*           3) Build with the high-water marks enabled:
+*                  make clean; make stkbench CFLAGS="-O2 -DOS_STK_WM_EN=1 -DOS_TASK_STAT_STK_CHK_EN=1"
+*              Add SIM=1 to time the scans alone: in the SIGALRM build, each critical section costs two system
+*              calls, which is more than reading the few entries below a high-water mark.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+#include  "includes.h"
+
+#if (OS_STK_WM_EN == 0) || (OS_TASK_STAT_STK_CHK_EN == 0)
+#error  "Build stkbench with CFLAGS=\"-O2 -DOS_STK_WM_EN=1 -DOS_TASK_STAT_STK_CHK_EN=1\""
+#endif
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  BENCH_STK_SIZE          4096u
+#define  BENCH_RUNS                50u
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK  BenchStk[OS_MAX_TASKS][BENCH_STK_SIZE];
+
+static  INT8U   BenchOvfPrio;
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  double  BenchPass(INT8U (*pfnct)(INT8U prio, OS_STK_DATA *p_stk_data), INT8U ntasks);
+
+static  void    BenchOvf(INT8U prio);
+static  void    BenchTask(void *p_arg);
+static  void    BenchUse(INT8U prio, INT32U depth);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    OS_STK_DATA  full;
+    OS_STK_DATA  wm;
+    double       tfull;
+    double       tfirst;
+    double       twm;
+    INT32U       i;
+    INT8U        prio;
+
+
+    for (prio = 0; prio < OS_MAX_TASKS && prio < OS_TASK_IDLE_PRIO - 1; prio++) {
+        OSTaskCreateExt(BenchTask, (void *)0, &BenchStk[prio][BENCH_STK_SIZE - 1], prio, prio,
+                        &BenchStk[prio][0], BENCH_STK_SIZE, (void *)0,
+                        OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+        BenchUse(prio, 256u + (INT32U)prio * (BENCH_STK_SIZE / 2u) / OS_MAX_TASKS);
+    }
+    OSTCBCur = OSTCBPrioTbl[OS_TASK_IDLE_PRIO];
+
+    tfull  = BenchPass(OSTaskStkChk,   prio);
+    tfirst = BenchPass(OSTaskStkWmGet, prio);
+    twm    = tfirst;
+    for (i = 1; i < BENCH_RUNS; i++) {
+        twm = BenchPass(OSTaskStkWmGet, prio);
+    }
+    for (i = 0; i < prio; i++) {
+        OSTaskStkChk((INT8U)i, &full);
+        OSTaskStkWmGet((INT8U)i, &wm);
+        if (full.OSUsed != wm.OSUsed) {
+            printf("prio %u: OSTaskStkChk() %u bytes used, OSTaskStkWmGet() %u bytes used\n",
+                   (unsigned)i, (unsigned)full.OSUsed, (unsigned)wm.OSUsed);
+            return (1);
+        }
+    }
+    printf("%u tasks, %u entry stacks: same usage from both functions\n",
+           (unsigned)prio, (unsigned)BENCH_STK_SIZE);
+    printf("OSTaskStkChk()   all tasks        %10.2f us\n", tfull  / 1000.0);
+    printf("OSTaskStkWmGet() all tasks, first %10.2f us\n", tfirst / 1000.0);
+    printf("OSTaskStkWmGet() all tasks, next  %10.2f us   %6.1fx\n", twm / 1000.0, tfull / twm);
+
+    OSTaskStkOvfHookSet(BenchOvf);
+    BenchOvfPrio = OS_PRIO_SELF;
+    BenchUse(0, BENCH_STK_SIZE - OS_STK_RED_SIZE + 1u);  /* Task 0 grows into its red zone         */
+    OSTaskStkWmGet(0, &wm);
+    printf("overflow of prio %u reported, %u overflow(s), %u bytes free\n",
+           (unsigned)BenchOvfPrio, (unsigned)OSStkOvfCtr, (unsigned)wm.OSFree);
+    return ((BenchOvfPrio == 0 && OSStkOvfCtr == 1) ? 0 : 1);
+}
+
+/*
+*********************************************************************************************************
+*                               TIME ONE CALL OF 'pfnct' FOR EACH TASK (NS)
+*********************************************************************************************************
+*/
+
+static  double  BenchPass (INT8U (*pfnct)(INT8U prio, OS_STK_DATA *p_stk_data), INT8U ntasks)
+{
+    struct timespec  t0;
+    struct timespec  t1;
+    OS_STK_DATA      stk_data;
+    INT8U            prio;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (prio = 0; prio < ntasks; prio++) {
+        (*pfnct)(prio, &stk_data);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec));
+}
+
+/*
+*********************************************************************************************************
+*                        MARK THE TOP 'depth' ENTRIES OF A STACK AS USED BY THE TASK
+*
+* Note(s) : 1) Every fourth entry is written, from the context saved at the top of the stack down to the
+*              deepest entry, which leaves holes of three zero entries as local arrays do.
+*********************************************************************************************************
+*/
+
+static  void  BenchUse (INT8U prio, INT32U depth)
+{
+    OS_STK  *pstk;
+    OS_STK  *pend;
+
+
+    pend = &BenchStk[prio][BENCH_STK_SIZE - depth];
+    for (pstk = OSTCBPrioTbl[prio]->OSTCBStkPtr - 4; pstk > pend; pstk -= 4) {
+        *pstk = (OS_STK)1;
+    }
+    *pend = (OS_STK)1;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          STACK OVERFLOW HOOK
+*********************************************************************************************************
+*/
+
+static  void  BenchOvf (INT8U prio)
+{
+    BenchOvfPrio = prio;
+}
+
+/*
+*********************************************************************************************************
+*                                              DUMMY TASK
+*********************************************************************************************************
+*/
+
+static  void  BenchTask (void *p_arg)
+{
+    (void)p_arg;
+    for (;;) {
+        OSTimeDly(1);
+    }
+}
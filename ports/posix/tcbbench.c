@@ -0,0 +1,198 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                        OS_TCB LAYOUT BENCHMARK
+*
+* File    : TCBBENCH.C
+* Version : V2.86
+*
+* Note(s) : 1) Counts the cache lines of OSTCBTbl[] that the tick (scan of OSTCBList) and a context switch
+*              touch per TCB, where OSTCBTbl[] is in this build and averaged over all the placements of
+*              OSTCBTbl[] relative to a cache line, then times OSTimeTick() with a cold cache while
+*              OS_MAX_TASKS tasks are delayed.
+*           2) Build with a large table to see the effect, e.g.
+*                  make clean; make tcbbench CFLAGS="-O2 -DOS_LOWEST_PRIO=254 -DOS_MAX_TASKS=250"
+*              The tick scan is only done with OS_DLY_LIST_EN set to 0.
+*********************************************************************************************************
+*/
+
+#include  <stddef.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+#include  "includes.h"
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  BENCH_LINE_SIZE           64u           /* Cache line size (bytes)                            */
+#define  BENCH_FLUSH_SIZE    (16u * 1024u * 1024u)   /* Larger than the last level cache               */
+#define  BENCH_RUNS               200u
+#define  BENCH_STK_SIZE          2048u
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK  BenchStk[OS_MAX_TASKS][BENCH_STK_SIZE];
+
+static  size_t  BenchTickOfs[] = {               /* Fields read by the OSTCBList scan of OSTimeTick()  */
+    offsetof(OS_TCB, OSTCBPrio),
+    offsetof(OS_TCB, OSTCBDly),
+    offsetof(OS_TCB, OSTCBNext)
+};
+
+static  size_t  BenchSwOfs[] = {                 /* Fields used by OS_Sched() and OSCtxSw()            */
+    offsetof(OS_TCB, OSTCBStkPtr),
+    offsetof(OS_TCB, OSTCBPrio),
+#if OS_TASK_PROFILE_EN > 0
+    offsetof(OS_TCB, OSTCBCtxSwCtr),
+#endif
+#if OS_DLY_LIST_EN > 0
+    offsetof(OS_TCB, OSTCBDlyLinked),
+#endif
+    offsetof(OS_TCB, compTime)
+};
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  double  BenchLines(const size_t *pofs, INT32U nofs, BOOLEAN any);
+
+static  void    BenchTask(void *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                                 MAIN
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    struct timespec   t0;
+    struct timespec   t1;
+    volatile INT8U   *pflush;
+    OS_TCB           *ptcb;
+    double            ns;
+    INT32U            i;
+    INT32U            j;
+    INT8U             prio;
+
+
+    for (prio = 0; prio < OS_MAX_TASKS && prio < OS_TASK_IDLE_PRIO - 1; prio++) {
+        OSTaskCreateExt(BenchTask, (void *)0, &BenchStk[prio][BENCH_STK_SIZE - 1], prio, prio,
+                        &BenchStk[prio][0], BENCH_STK_SIZE, (void *)0, 0);
+    }
+    printf("sizeof(OS_TCB)                   %u bytes\n", (unsigned)sizeof(OS_TCB));
+    printf("lines touched/TCB                this build   any placement\n");
+    printf("tick scan                        %10.2f %15.2f\n",
+           BenchLines(BenchTickOfs, sizeof(BenchTickOfs) / sizeof(BenchTickOfs[0]), OS_FALSE),
+           BenchLines(BenchTickOfs, sizeof(BenchTickOfs) / sizeof(BenchTickOfs[0]), OS_TRUE));
+    printf("ctx switch                       %10.2f %15.2f\n",
+           BenchLines(BenchSwOfs,   sizeof(BenchSwOfs)   / sizeof(BenchSwOfs[0]),   OS_FALSE),
+           BenchLines(BenchSwOfs,   sizeof(BenchSwOfs)   / sizeof(BenchSwOfs[0]),   OS_TRUE));
+
+    for (ptcb = OSTCBList; ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO; ptcb = ptcb->OSTCBNext) {
+        ptcb->OSTCBDly = 60000u;                 /* Every task is delayed: all TCBs are updated        */
+    }
+    OSTCBCur  = OSTCBPrioTbl[OS_TASK_IDLE_PRIO];
+    OSRunning = OS_TRUE;
+    pflush    = (volatile INT8U *)malloc(BENCH_FLUSH_SIZE);
+    if (pflush == (volatile INT8U *)0) {
+        return (1);
+    }
+    ns = 0.0;
+    for (i = 0; i < BENCH_RUNS; i++) {
+        for (j = 0; j < BENCH_FLUSH_SIZE; j += BENCH_LINE_SIZE) {
+            pflush[j]++;                         /* Evict OSTCBTbl[] from the caches                   */
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        OSTimeTick();
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns += (double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec);
+    }
+    printf("OSTimeTick(), %3d tasks, cold    %.2f us\n", (int)prio, ns / BENCH_RUNS / 1000.0);
+    return (0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   AVERAGE CACHE LINES TOUCHED PER TCB
+*
+* Description: This function returns the number of distinct cache lines holding the given fields, averaged
+*              over all the entries of OSTCBTbl[].
+*
+* Arguments  : pofs      is a table of field offsets.
+*
+*              nofs      is the number of offsets (8 at most).
+*
+*              any       is OS_FALSE to use the address of OSTCBTbl[] in this build, OS_TRUE to average over
+*                        all the 8-byte aligned placements of OSTCBTbl[] in a cache line.
+*********************************************************************************************************
+*/
+
+static  double  BenchLines (const size_t *pofs, INT32U nofs, BOOLEAN any)
+{
+    unsigned long  base;
+    unsigned long  line[8];
+    unsigned long  total;
+    unsigned long  nplace;
+    INT32U         i;
+    INT32U         j;
+    INT32U         k;
+
+
+    total  = 0;
+    nplace = 0;
+    for (base = 0; base < BENCH_LINE_SIZE; base += 8) {
+        if (any == OS_FALSE) {
+            base = (unsigned long)&OSTCBTbl[0];
+        }
+        for (i = 0; i < OS_MAX_TASKS + OS_N_SYS_TASKS; i++) {
+            for (j = 0; j < nofs && j < 8; j++) {
+                line[j] = (base + i * sizeof(OS_TCB) + pofs[j]) / BENCH_LINE_SIZE;
+                for (k = 0; k < j; k++) {
+                    if (line[k] == line[j]) {    /* Line already counted                               */
+                        break;
+                    }
+                }
+                if (k == j) {
+                    total++;
+                }
+            }
+        }
+        nplace++;
+        if (any == OS_FALSE) {
+            break;
+        }
+    }
+    return ((double)total / (double)(nplace * (OS_MAX_TASKS + OS_N_SYS_TASKS)));
+}
+
+/*
+*********************************************************************************************************
+*                                              DUMMY TASK
+*********************************************************************************************************
+*/
+
+static  void  BenchTask (void *p_arg)
+{
+    (void)p_arg;
+    for (;;) {
+        OSTimeDly(1);
+    }
+}
@@ -0,0 +1,88 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                                            POSIX HOST PORT
+*                                          SELF-CHECKING TESTS
+*
+* File    : TEST.H
+* Version : V2.86
+*
+* Note(s) : 1) Each xxxtest.c of this directory checks the kernel with TEST_CHECK() and ends with TestEnd(),
+*              which exits with status 1 if a check failed.  'make check' builds and runs them all.
+*
+*           2) TestStart() creates a watchdog task at the lowest priority an application task may use:
+*              a test whose tasks all stay blocked fails after TEST_TICKS_MAX ticks instead of idling
+*              forever.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+
+#ifndef  TEST_TICKS_MAX
+#define  TEST_TICKS_MAX        2000u             /* Ticks after which a test is considered stuck       */
+#endif
+
+#define  TEST_WDOG_PRIO  (OS_LOWEST_PRIO - 2u)   /* Above the idle and statistic tasks                 */
+#define  TEST_WDOG_STK_SIZE    2048u
+
+#define  TEST_CHECK(cond)                                                                   \
+             do {                                                                           \
+                 if (!(cond)) {                                                             \
+                     printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);        \
+                     TestFails++;                                                           \
+                 }                                                                          \
+             } while (0)
+
+static  INT32U  TestFails;                       /* Number of checks that failed                       */
+static  OS_STK  TestWdogStk[TEST_WDOG_STK_SIZE];
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          END OF A TEST PROGRAM
+*
+* Description: This function reports the result of the test and ends the process with status 0 if all the
+*              checks passed, 1 if not.
+*
+* Arguments  : name      is the name of the test.
+*********************************************************************************************************
+*/
+
+static  void  TestEnd (const char *name)
+{
+    printf("%s: %s (%u failed checks)\n", name, (TestFails == 0) ? "PASSED" : "FAILED", (unsigned)TestFails);
+    exit((TestFails == 0) ? 0 : 1);
+}
+
+/*
+*********************************************************************************************************
+*                                            WATCHDOG TASK
+*********************************************************************************************************
+*/
+
+static  void  TestWdog (void *p_arg)
+{
+    OSTimeDly(TEST_TICKS_MAX);
+    printf("%s: no progress after %u ticks\n", (char *)p_arg, (unsigned)TEST_TICKS_MAX);
+    TestFails++;
+    TestEnd((char *)p_arg);
+}
+
+/*
+*********************************************************************************************************
+*                                        START OF A TEST PROGRAM
+*
+* Description: This function creates the watchdog task of the test (see Note #2).
+*
+* Arguments  : name      is the name of the test.
+*********************************************************************************************************
+*/
+
+static  void  TestStart (const char *name)
+{
+    OSTaskCreateExt(TestWdog, (void *)name, &TestWdogStk[TEST_WDOG_STK_SIZE - 1], TEST_WDOG_PRIO,
+                    TEST_WDOG_PRIO, &TestWdogStk[0], TEST_WDOG_STK_SIZE, (void *)0, 0);
+}
@@ -0,0 +1,291 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                       OFFLINE SCHEDULABILITY CHECK
+*
+* File    : MAIN.C
+* Version : V2.86
+*
+* Note(s) : 1) Usage: schedchk [-p rm|edf] [-q] [file ...]
+*
+*              A file ending in .c or .h is scanned for TASK_PARAM initializers, e.g. the line
+*                  TASK_PARAM Task1Param = {1, 3};
+*              of lab1.c gives a task with C = 1 and T = 3 (lines commented out with // are skipped).
+*              Any other file (or stdin) holds one task per line: C T [D].  '#' starts a comment line.
+*
+*           2) The exit status is 0 if the task set is schedulable under the policy given by -p (RM by
+*              default), 1 if it is not and 2 on error, so that a build can reject a task set.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+
+#include  "schedchk.h"
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  SCHED_POLICY_RM               0u
+#define  SCHED_POLICY_EDF              1u
+
+#define  SCHED_LINE_SIZE            1024u
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  SCHED_TASK  *SchedTbl;                   /* Task set read from all the files                   */
+static  uint32_t     SchedTblLen;
+static  uint32_t     SchedTblSize;
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  int   SchedRead(FILE *fp, const char *pname, int csrc);
+
+static  int   SchedAdd(uint32_t c, uint32_t t, uint32_t d);
+
+static  void  SchedUsage(void);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                               MAIN
+*********************************************************************************************************
+*/
+
+int  main (int argc, char *argv[])
+{
+    FILE      *fp;
+    const char *pext;
+    uint8_t    policy;
+    uint8_t    quiet;
+    uint8_t    feasible;
+    uint8_t    err;
+    uint32_t   miss;
+    uint64_t   tfail;
+    double     u;
+    double     bound;
+    double     hyp;
+    int        i;
+    int        nfiles;
+    SCHED_TASK *ptask;
+
+
+    policy = SCHED_POLICY_RM;
+    quiet  = 0;
+    nfiles = 0;
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            quiet = 1;
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "rm") == 0) {
+                policy = SCHED_POLICY_RM;
+            } else if (strcmp(argv[i], "edf") == 0) {
+                policy = SCHED_POLICY_EDF;
+            } else {
+                SchedUsage();
+                return (2);
+            }
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            SchedUsage();
+            return (2);
+        } else {
+            nfiles++;
+            if (strcmp(argv[i], "-") == 0) {
+                fp = stdin;
+            } else if ((fp = fopen(argv[i], "r")) == (FILE *)0) {
+                perror(argv[i]);
+                return (2);
+            }
+            pext = strrchr(argv[i], '.');
+            if (SchedRead(fp, argv[i], pext != (char *)0 && (strcmp(pext, ".c") == 0 ||
+                                                             strcmp(pext, ".h") == 0)) != 0) {
+                return (2);
+            }
+            if (fp != stdin) {
+                fclose(fp);
+            }
+        }
+    }
+    if (nfiles == 0 && SchedRead(stdin, "<stdin>", 0) != 0) {
+        return (2);
+    }
+
+    err = SchedRTA(SchedTbl, SchedTblLen, &miss);
+    if (err == SCHED_ERR_NONE) {
+        err = SchedEDF(SchedTbl, SchedTblLen, &feasible, &tfail);
+    }
+    switch (err) {
+        case SCHED_ERR_NONE:
+             break;
+
+        case SCHED_ERR_PERIOD:
+             fprintf(stderr, "schedchk: a task has a period of 0\n");
+             return (2);
+
+        case SCHED_ERR_DEADLINE:
+             fprintf(stderr, "schedchk: a task has a deadline larger than its period\n");
+             return (2);
+
+        default:
+             fprintf(stderr, "schedchk: out of memory\n");
+             return (2);
+    }
+
+    u     = SchedUtil(SchedTbl, SchedTblLen);
+    bound = SchedBoundLL(SchedTblLen);
+    hyp   = SchedBoundHyp(SchedTbl, SchedTblLen);
+    printf("tasks                %u\n", (unsigned)SchedTblLen);
+    printf("utilization          %.4f\n", u);
+    printf("Liu & Layland bound  %.4f  %s\n", bound, (u   <= bound) ? "pass" : "fail");
+    printf("hyperbolic bound     %.4f  %s\n", hyp,   (hyp <= 2.0)   ? "pass" : "fail");
+    printf("RM response times    %s (%u of %u tasks can miss their deadline)\n",
+           (miss == 0) ? "pass" : "fail", (unsigned)miss, (unsigned)SchedTblLen);
+    if (feasible != 0) {
+        printf("EDF processor demand pass\n");
+    } else if (tfail == 0) {
+        printf("EDF processor demand fail (utilization > 1)\n");
+    } else {
+        printf("EDF processor demand fail (demand exceeds %llu ticks)\n", (unsigned long long)tfail);
+    }
+    if (quiet == 0) {
+        printf("\n  task  prio         C         T         D         R\n");
+        for (i = 0; i < (int)SchedTblLen; i++) {
+            ptask = &SchedTbl[i];
+            printf("%6d %5u %9u %9u %9u %9llu%s\n",
+                   i + 1, (unsigned)ptask->SchedPrio,
+                   (unsigned)ptask->SchedC, (unsigned)ptask->SchedT, (unsigned)ptask->SchedD,
+                   (unsigned long long)ptask->SchedResp,
+                   (ptask->SchedMiss != 0) ? "  miss" : "");
+        }
+    }
+    free(SchedTbl);
+    if (policy == SCHED_POLICY_EDF) {
+        return ((feasible != 0) ? 0 : 1);
+    }
+    return ((miss == 0) ? 0 : 1);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            READ A TASK SET
+*
+* Description: This function appends the tasks described in a file to SchedTbl.
+*
+* Arguments  : fp        is the file to read.
+*
+*              pname     is the name of the file, for error messages.
+*
+*              csrc      is 1 to scan C source for TASK_PARAM initializers, 0 to read 'C T [D]' lines.
+*
+* Returns    : 0 on success, -1 on error.
+*********************************************************************************************************
+*/
+
+static  int  SchedRead (FILE *fp, const char *pname, int csrc)
+{
+    char           line[SCHED_LINE_SIZE];
+    char          *ps;
+    char          *pend;
+    unsigned long  val[3];
+    int            nval;
+    int            lineno;
+
+
+    lineno = 0;
+    while (fgets(line, sizeof(line), fp) != (char *)0) {
+        lineno++;
+        ps = line + strspn(line, " \t");
+        if (csrc != 0) {
+            if (strncmp(ps, "//", 2) == 0 || strstr(ps, "TASK_PARAM") == (char *)0) {
+                continue;
+            }
+            ps = strchr(ps, '{');
+            if (ps == (char *)0) {               /* e.g. the 'typedef' of TASK_PARAM                   */
+                continue;
+            }
+            ps++;
+        } else if (*ps == '#' || *ps == '\n' || *ps == '\0') {
+            continue;
+        }
+        nval = 0;
+        while (nval < 3) {
+            ps += strspn(ps, " \t,");
+            val[nval] = strtoul(ps, &pend, 0);
+            if (pend == ps) {
+                break;
+            }
+            ps = pend;
+            nval++;
+        }
+        if (nval < 2) {
+            if (csrc != 0) {                     /* Not an initializer                                 */
+                continue;
+            }
+            fprintf(stderr, "%s:%d: expected 'C T [D]'\n", pname, lineno);
+            return (-1);
+        }
+        if (SchedAdd((uint32_t)val[0], (uint32_t)val[1], (nval == 3) ? (uint32_t)val[2] : 0u) != 0) {
+            fprintf(stderr, "schedchk: out of memory\n");
+            return (-1);
+        }
+    }
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                          ADD A TASK TO THE SET
+*********************************************************************************************************
+*/
+
+static  int  SchedAdd (uint32_t c, uint32_t t, uint32_t d)
+{
+    SCHED_TASK  *ptbl;
+    uint32_t     size;
+
+
+    if (SchedTblLen == SchedTblSize) {           /* Grow the table                                     */
+        size = (SchedTblSize == 0) ? 64u : SchedTblSize * 2u;
+        ptbl = (SCHED_TASK *)realloc(SchedTbl, size * sizeof(SCHED_TASK));
+        if (ptbl == (SCHED_TASK *)0) {
+            return (-1);
+        }
+        SchedTbl     = ptbl;
+        SchedTblSize = size;
+    }
+    memset(&SchedTbl[SchedTblLen], 0, sizeof(SCHED_TASK));
+    SchedTbl[SchedTblLen].SchedC = c;
+    SchedTbl[SchedTblLen].SchedT = t;
+    SchedTbl[SchedTblLen].SchedD = d;
+    SchedTblLen++;
+    return (0);
+}
+
+/*
+*********************************************************************************************************
+*                                                 USAGE
+*********************************************************************************************************
+*/
+
+static  void  SchedUsage (void)
+{
+    fprintf(stderr, "usage: schedchk [-p rm|edf] [-q] [file ...]\n"
+                    "  file.c, file.h  TASK_PARAM {C, T} initializers (e.g. lab1.c)\n"
+                    "  other, stdin    one task per line: C T [D]\n"
+                    "exit status: 0 schedulable, 1 not schedulable, 2 error\n");
+}
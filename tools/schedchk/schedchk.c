@@ -0,0 +1,460 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                       OFFLINE SCHEDULABILITY CHECK
+*
+* File    : SCHEDCHK.C
+* Version : V2.86
+*
+* Note(s) : 1) Utilization based tests (Liu & Layland, hyperbolic bound) are sufficient only.  The response
+*              time analysis (fixed priorities, RM order) and the processor demand test (EDF) are exact.
+*           2) All time computations are done on 64-bit integers: they are exact for any set of 32-bit
+*              parameters.  Only the utilization is a floating point value.
+*********************************************************************************************************
+*/
+
+#include  <math.h>
+#include  <stdlib.h>
+
+#include  "schedchk.h"
+
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  SCHED_U_EPS           1e-9              /* Tolerance on the utilization compared to 1         */
+#define  SCHED_BUSY_MAX        ((uint64_t)1 << 53)   /* Give up on longer busy periods                 */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  const SCHED_TASK  *SchedSortTbl;         /* Task table seen by SchedRMCmp()                    */
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  int       SchedRMCmp(const void *pa, const void *pb);
+
+static  uint64_t  SchedBusyPeriod(const SCHED_TASK *ptasks, uint32_t ntasks);
+
+static  uint64_t  SchedDemand(const SCHED_TASK *ptasks, uint32_t ntasks, uint64_t t);
+
+static  uint64_t  SchedDeadlineBefore(const SCHED_TASK *ptasks, uint32_t ntasks, uint64_t t);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         VALIDATE A TASK SET
+*
+* Description: This function checks the parameters of a task set and sets the deadlines that were left to 0
+*              to the period of their task.
+*
+* Arguments  : ptasks    is a pointer to the task table.
+*
+*              ntasks    is the number of tasks in the table.
+*
+* Returns    : SCHED_ERR_NONE        if the task set is valid.
+*              SCHED_ERR_PERIOD      if a period is 0.
+*              SCHED_ERR_DEADLINE    if a deadline is larger than its period.
+*********************************************************************************************************
+*/
+
+uint8_t  SchedCheck (SCHED_TASK *ptasks, uint32_t ntasks)
+{
+    uint32_t  i;
+
+
+    for (i = 0; i < ntasks; i++) {
+        if (ptasks[i].SchedT == 0) {
+            return (SCHED_ERR_PERIOD);
+        }
+        if (ptasks[i].SchedD == 0) {             /* D = T by default                                   */
+            ptasks[i].SchedD = ptasks[i].SchedT;
+        }
+        if (ptasks[i].SchedD > ptasks[i].SchedT) {
+            return (SCHED_ERR_DEADLINE);
+        }
+    }
+    return (SCHED_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         UTILIZATION AND BOUNDS
+*
+* Description: SchedUtil()     returns the total utilization, the sum of C/T.
+*              SchedBoundLL()  returns the Liu & Layland bound n(2^(1/n) - 1): a set of n tasks with D = T
+*                              is schedulable under RM if its utilization does not exceed it.
+*              SchedBoundHyp() returns the product of (C/T + 1): a set with D = T is schedulable under RM if
+*                              it does not exceed 2 (hyperbolic bound, Bini & Buttazzo).
+*
+* Arguments  : ptasks    is a pointer to the task table.
+*
+*              ntasks    is the number of tasks in the table.
+*********************************************************************************************************
+*/
+
+double  SchedUtil (const SCHED_TASK *ptasks, uint32_t ntasks)
+{
+    double    u;
+    uint32_t  i;
+
+
+    u = 0.0;
+    for (i = 0; i < ntasks; i++) {
+        u += (double)ptasks[i].SchedC / (double)ptasks[i].SchedT;
+    }
+    return (u);
+}
+
+
+double  SchedBoundLL (uint32_t ntasks)
+{
+    if (ntasks == 0) {
+        return (1.0);
+    }
+    return ((double)ntasks * (pow(2.0, 1.0 / (double)ntasks) - 1.0));
+}
+
+
+double  SchedBoundHyp (const SCHED_TASK *ptasks, uint32_t ntasks)
+{
+    double    p;
+    uint32_t  i;
+
+
+    p = 1.0;
+    for (i = 0; i < ntasks; i++) {
+        p *= (double)ptasks[i].SchedC / (double)ptasks[i].SchedT + 1.0;
+    }
+    return (p);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     RATE MONOTONIC RESPONSE TIMES
+*
+* Description: This function assigns rate monotonic priorities (shorter period = higher priority, ties
+*              broken by deadline then by position in the table) and computes the worst case response time
+*              of every task:
+*
+*                  R = C(i) + sum over higher priority tasks j of ceil(R / T(j)) * C(j)
+*
+* Arguments  : ptasks    is a pointer to the task table.  SchedPrio, SchedResp and SchedMiss are filled in.
+*
+*              ntasks    is the number of tasks in the table.
+*
+*              pmiss     is a pointer to where the number of tasks that can miss their deadline is stored.
+*
+* Returns    : SCHED_ERR_NONE, or the error returned by SchedCheck(), or SCHED_ERR_MEM.
+*
+* Note(s)    : 1) The iteration of task i starts from R(i-1) + C(i), a lower bound of R(i), instead of C(i).
+*                 It is stopped as soon as it exceeds the deadline.
+*********************************************************************************************************
+*/
+
+uint8_t  SchedRTA (SCHED_TASK *ptasks, uint32_t ntasks, uint32_t *pmiss)
+{
+    uint32_t  *pidx;
+    uint64_t  *pc;                               /* C and T in priority order, for the inner loop      */
+    uint64_t  *pt;
+    uint64_t   r;
+    uint64_t   rnext;
+    uint64_t   rprev;
+    uint32_t   i;
+    uint32_t   j;
+    uint8_t    err;
+    SCHED_TASK *ptask;
+
+
+    *pmiss = 0;
+    err    = SchedCheck(ptasks, ntasks);
+    if (err != SCHED_ERR_NONE) {
+        return (err);
+    }
+    pidx = (uint32_t *)malloc((ntasks + 1) * sizeof(uint32_t));
+    pc   = (uint64_t *)malloc((ntasks + 1) * sizeof(uint64_t));
+    pt   = (uint64_t *)malloc((ntasks + 1) * sizeof(uint64_t));
+    if (pidx == (uint32_t *)0 || pc == (uint64_t *)0 || pt == (uint64_t *)0) {
+        free(pidx);
+        free(pc);
+        free(pt);
+        return (SCHED_ERR_MEM);
+    }
+    for (i = 0; i < ntasks; i++) {
+        pidx[i] = i;
+    }
+    SchedSortTbl = ptasks;
+    qsort(pidx, ntasks, sizeof(uint32_t), SchedRMCmp);
+    rprev = 0;
+    for (i = 0; i < ntasks; i++) {
+        ptask            = &ptasks[pidx[i]];
+        ptask->SchedPrio = i;
+        pc[i]            = ptask->SchedC;
+        pt[i]            = ptask->SchedT;
+        r                = rprev + pc[i];
+        for (;;) {
+            if (r > ptask->SchedD) {             /* Deadline can be missed                             */
+                break;
+            }
+            rnext = pc[i];
+            for (j = 0; j < i; j++) {
+                rnext += ((r + pt[j] - 1) / pt[j]) * pc[j];
+            }
+            if (rnext == r) {                    /* Fixed point reached                                */
+                break;
+            }
+            r = rnext;
+        }
+        ptask->SchedResp = r;
+        ptask->SchedMiss = (uint8_t)(r > ptask->SchedD);
+        if (ptask->SchedMiss != 0) {
+            (*pmiss)++;
+        }
+        rprev = r;
+    }
+    free(pidx);
+    free(pc);
+    free(pt);
+    return (SCHED_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      EDF PROCESSOR DEMAND TEST
+*
+* Description: This function checks whether a task set is feasible under EDF.  With D = T for all tasks,
+*              the set is feasible if and only if its utilization does not exceed 1.  Otherwise, the demand
+*              h(t) of every absolute deadline t up to a bound L must not exceed t.  The deadlines are
+*              visited with Quick Processor-demand Analysis (Zhang & Burns), which jumps from t to h(t)
+*              instead of checking every deadline.
+*
+* Arguments  : ptasks     is a pointer to the task table.
+*
+*              ntasks     is the number of tasks in the table.
+*
+*              pfeasible  is a pointer to where 1 (feasible) or 0 (not feasible) is stored.
+*
+*              pt         is a pointer to where the time at which the demand exceeds the available time is
+*                         stored, 0 if the set is not feasible because its utilization exceeds 1.
+*
+* Returns    : SCHED_ERR_NONE or the error returned by SchedCheck().
+*
+* Note(s)    : 1) L is the shortest of the synchronous busy period and, if U < 1, of
+*                 max(D(i), sum of (T(i) - D(i)) * U(i) / (1 - U)).
+*              2) A busy period longer than SCHED_BUSY_MAX ticks (U within rounding of 1) is reported as not
+*                 feasible.
+*********************************************************************************************************
+*/
+
+uint8_t  SchedEDF (const SCHED_TASK *ptasks, uint32_t ntasks, uint8_t *pfeasible, uint64_t *pt)
+{
+    double    u;
+    double    la;
+    uint64_t  l;
+    uint64_t  t;
+    uint64_t  h;
+    uint64_t  dmin;
+    uint64_t  dmax;
+    uint32_t  i;
+    uint8_t   implicit;
+
+
+    *pfeasible = 0;
+    *pt        = 0;
+    for (i = 0; i < ntasks; i++) {
+        if (ptasks[i].SchedT == 0) {
+            return (SCHED_ERR_PERIOD);
+        }
+        if (ptasks[i].SchedD > ptasks[i].SchedT) {
+            return (SCHED_ERR_DEADLINE);
+        }
+    }
+    if (ntasks == 0) {
+        *pfeasible = 1;
+        return (SCHED_ERR_NONE);
+    }
+    u = SchedUtil(ptasks, ntasks);
+    if (u > 1.0 + SCHED_U_EPS) {                 /* Overloaded                                         */
+        return (SCHED_ERR_NONE);
+    }
+    implicit = 1;
+    dmin     = UINT64_MAX;
+    dmax     = 0;
+    la       = 0.0;
+    for (i = 0; i < ntasks; i++) {
+        if (ptasks[i].SchedD != 0 && ptasks[i].SchedD != ptasks[i].SchedT) {
+            implicit = 0;
+        }
+        t = (ptasks[i].SchedD != 0) ? ptasks[i].SchedD : ptasks[i].SchedT;
+        if (t < dmin) {
+            dmin = t;
+        }
+        if (t > dmax) {
+            dmax = t;
+        }
+        la += (double)(ptasks[i].SchedT - t) * (double)ptasks[i].SchedC / (double)ptasks[i].SchedT;
+    }
+    if (implicit != 0) {                         /* D = T: U <= 1 is exact                             */
+        *pfeasible = 1;
+        return (SCHED_ERR_NONE);
+    }
+    l = SchedBusyPeriod(ptasks, ntasks);
+    if (u < 1.0 - SCHED_U_EPS) {
+        la /= 1.0 - u;
+        if (la < (double)dmax) {
+            la = (double)dmax;
+        }
+        if (la < (double)l) {
+            l = (uint64_t)ceil(la);
+        }
+    }
+    if (l == UINT64_MAX) {                       /* See Note #2                                        */
+        return (SCHED_ERR_NONE);
+    }
+    t = SchedDeadlineBefore(ptasks, ntasks, l + 1);  /* Last deadline not after L                      */
+    h = SchedDemand(ptasks, ntasks, t);
+    while (h <= t && h > dmin) {
+        if (h < t) {
+            t = h;
+        } else {
+            t = SchedDeadlineBefore(ptasks, ntasks, t);
+        }
+        h = SchedDemand(ptasks, ntasks, t);
+    }
+    if (h <= dmin) {
+        *pfeasible = 1;
+    } else {
+        *pt        = t;
+    }
+    return (SCHED_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       COMPARE TWO TASKS (RM ORDER)
+*
+* Description: qsort() callback ordering task indexes by period, then deadline, then index.
+*********************************************************************************************************
+*/
+
+static  int  SchedRMCmp (const void *pa, const void *pb)
+{
+    uint32_t           ia;
+    uint32_t           ib;
+    const SCHED_TASK  *pta;
+    const SCHED_TASK  *ptb;
+
+
+    ia  = *(const uint32_t *)pa;
+    ib  = *(const uint32_t *)pb;
+    pta = &SchedSortTbl[ia];
+    ptb = &SchedSortTbl[ib];
+    if (pta->SchedT != ptb->SchedT) {
+        return ((pta->SchedT < ptb->SchedT) ? -1 : 1);
+    }
+    if (pta->SchedD != ptb->SchedD) {
+        return ((pta->SchedD < ptb->SchedD) ? -1 : 1);
+    }
+    return ((ia < ib) ? -1 : 1);
+}
+
+/*
+*********************************************************************************************************
+*                                        SYNCHRONOUS BUSY PERIOD
+*
+* Description: This function returns the length of the busy period that starts when all tasks are released
+*              together, or UINT64_MAX if it exceeds SCHED_BUSY_MAX.
+*********************************************************************************************************
+*/
+
+static  uint64_t  SchedBusyPeriod (const SCHED_TASK *ptasks, uint32_t ntasks)
+{
+    uint64_t  w;
+    uint64_t  wnext;
+    uint32_t  i;
+
+
+    wnext = 0;
+    for (i = 0; i < ntasks; i++) {
+        wnext += ptasks[i].SchedC;
+    }
+    do {
+        w     = wnext;
+        wnext = 0;
+        for (i = 0; i < ntasks; i++) {
+            wnext += ((w + ptasks[i].SchedT - 1) / ptasks[i].SchedT) * ptasks[i].SchedC;
+        }
+        if (wnext > SCHED_BUSY_MAX) {
+            return (UINT64_MAX);
+        }
+    } while (wnext != w);
+    return (w);
+}
+
+/*
+*********************************************************************************************************
+*                                            PROCESSOR DEMAND
+*
+* Description: This function returns h(t), the execution time of the jobs released at or after 0 with an
+*              absolute deadline at or before t, all tasks being released at 0.
+*********************************************************************************************************
+*/
+
+static  uint64_t  SchedDemand (const SCHED_TASK *ptasks, uint32_t ntasks, uint64_t t)
+{
+    uint64_t  h;
+    uint64_t  d;
+    uint32_t  i;
+
+
+    h = 0;
+    for (i = 0; i < ntasks; i++) {
+        d = (ptasks[i].SchedD != 0) ? ptasks[i].SchedD : ptasks[i].SchedT;
+        if (t >= d) {
+            h += ((t - d) / ptasks[i].SchedT + 1) * ptasks[i].SchedC;
+        }
+    }
+    return (h);
+}
+
+/*
+*********************************************************************************************************
+*                                       LAST DEADLINE BEFORE A TIME
+*
+* Description: This function returns the latest absolute deadline strictly before t, or 0 if there is none.
+*********************************************************************************************************
+*/
+
+static  uint64_t  SchedDeadlineBefore (const SCHED_TASK *ptasks, uint32_t ntasks, uint64_t t)
+{
+    uint64_t  dlast;
+    uint64_t  d;
+    uint32_t  i;
+
+
+    dlast = 0;
+    for (i = 0; i < ntasks; i++) {
+        d = (ptasks[i].SchedD != 0) ? ptasks[i].SchedD : ptasks[i].SchedT;
+        if (d < t) {
+            d += ((t - d - 1) / ptasks[i].SchedT) * ptasks[i].SchedT;
+            if (d > dlast) {
+                dlast = d;
+            }
+        }
+    }
+    return (dlast);
+}
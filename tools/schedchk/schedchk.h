@@ -0,0 +1,63 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                       OFFLINE SCHEDULABILITY CHECK
+*
+* File    : SCHEDCHK.H
+* Version : V2.86
+*
+* Note(s) : 1) Host library: it does not depend on the kernel and is not linked into a target image.
+*           2) Times are in ticks, as in the TASK_PARAM {c, p} structures of lab1.c.  The relative deadline
+*              of a task defaults to its period and must not exceed it.
+*********************************************************************************************************
+*/
+
+#ifndef  SCHEDCHK_H
+#define  SCHEDCHK_H
+
+#include  <stdint.h>
+
+/*
+*********************************************************************************************************
+*                                            TASK DESCRIPTION
+*********************************************************************************************************
+*/
+
+typedef  struct  sched_task {
+    uint32_t  SchedC;                            /* Worst case computation time (ticks)                */
+    uint32_t  SchedT;                            /* Period (ticks)                                     */
+    uint32_t  SchedD;                            /* Relative deadline (ticks), 0 <= D <= T, 0 means T  */
+    uint32_t  SchedPrio;                         /* Out: RM priority, 0 is the highest                 */
+    uint64_t  SchedResp;                         /* Out: worst case response time under RM, or the     */
+                                                 /*      first iterate that exceeded the deadline      */
+    uint8_t   SchedMiss;                         /* Out: 1 if the task can miss its deadline under RM  */
+} SCHED_TASK;
+
+/*
+*********************************************************************************************************
+*                                              ERROR CODES
+*********************************************************************************************************
+*/
+
+#define  SCHED_ERR_NONE                0u
+#define  SCHED_ERR_PERIOD              1u        /* A period is 0                                      */
+#define  SCHED_ERR_DEADLINE            2u        /* A deadline is larger than its period               */
+#define  SCHED_ERR_MEM                 3u        /* Out of memory                                      */
+
+/*
+*********************************************************************************************************
+*                                              PROTOTYPES
+*********************************************************************************************************
+*/
+
+uint8_t   SchedCheck     (SCHED_TASK *ptasks, uint32_t ntasks);
+
+double    SchedUtil      (const SCHED_TASK *ptasks, uint32_t ntasks);
+double    SchedBoundLL   (uint32_t ntasks);
+double    SchedBoundHyp  (const SCHED_TASK *ptasks, uint32_t ntasks);
+
+uint8_t   SchedRTA       (SCHED_TASK *ptasks, uint32_t ntasks, uint32_t *pmiss);
+uint8_t   SchedEDF       (const SCHED_TASK *ptasks, uint32_t ntasks, uint8_t *pfeasible, uint64_t *pt);
+
+#endif
@@ -78,22 +78,282 @@ extern "C" {
 #define  OS_TASK_STAT_PRIO  (OS_LOWEST_PRIO - 1)        /* Statistic task priority                     */
 #define  OS_TASK_IDLE_PRIO  (OS_LOWEST_PRIO)            /* IDLE      task priority                     */
 
-#if OS_LOWEST_PRIO <= 63
-#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of event table                         */
-#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of ready table                         */
-#else
-#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 16 + 1)  /* Size of event table                         */
-#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 16 + 1)  /* Size of ready table                         */
-#endif
-
 #define  OS_TASK_IDLE_ID          65535u                /* ID numbers for Idle, Stat and Timer tasks   */
 #define  OS_TASK_STAT_ID          65534u
 #define  OS_TASK_TMR_ID           65533u
 
-#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0))
+#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0) \
+                               || (OS_SLOTQ_EN > 0) || (OS_MUTEX_CEIL_EN > 0))
 
 #define  OS_TCB_RESERVED        ((OS_TCB *)1)
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  DEFAULTS FOR OPTIONAL CONFIGURATION
+*
+* Note(s): The following #defines are not part of the stock OS_CFG.H.  Define them in OS_CFG.H (or in OS_CPU.H
+*          for the port specific macros) to override these defaults.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CTZ_EN
+#define  OS_CTZ_EN                    0u    /* Resolve priorities with count trailing zeros (1) or     */
+#endif                                      /* ... with the OSUnMapTbl[] lookup table (0)              */
+
+#if OS_CTZ_EN > 0
+#ifndef  OS_CPU_CTZ                         /* Bit position of lowest bit set in a non-zero word       */
+#define  OS_CPU_CTZ(x)               ((INT8U)__builtin_ctz((unsigned int)(x)))
+#endif
+#endif
+
+#ifndef  OS_PRIO_MAP64_EN
+#define  OS_PRIO_MAP64_EN             0u    /* Above 64 priorities, rows of 64 (1) or of 16 (0) prios  */
+#endif                                      /* ... in the ready list and wait lists (see below)        */
+
+#if OS_PRIO_MAP64_EN > 0
+#ifndef  OS_CPU_INT64U                      /* Unsigned 64 bit quantity                                */
+#define  OS_CPU_INT64U               unsigned long long
+#endif
+#ifndef  OS_CPU_CTZ64                       /* Bit position of lowest bit set in a non-zero 64 bit wd. */
+#define  OS_CPU_CTZ64(x)             ((INT8U)__builtin_ctzll((OS_CPU_INT64U)(x)))
+#endif
+#endif
+
+#ifndef  OS_CPU_ADDR                        /* Unsigned integer as wide as a pointer, to test the      */
+#define  OS_CPU_ADDR                 unsigned long   /* ... alignment of an address                */
+#endif
+
+#ifndef  OS_CPU_MEM_WORD                    /* Word moved by OS_MemClr() and OS_MemCopy(), which must  */
+#define  OS_CPU_MEM_WORD             INT8U  /* ... be allowed to alias any type: bytes unless the port */
+#endif                                      /* ... provides a wider type its compiler treats that way  */
+
+#ifndef  OS_DLY_LIST_EN
+#define  OS_DLY_LIST_EN               0u    /* Keep delayed tasks in a delta list (1) or scan all (0)  */
+#endif
+
+#ifndef  OS_TICKLESS_EN
+#define  OS_TICKLESS_EN               0u    /* Suppress ticks while only the idle task is ready        */
+#endif
+
+#ifndef  OS_DEADLINE_EN
+#define  OS_DEADLINE_EN               0u    /* Enable (1) or Disable (0) the deadline miss monitor     */
+#endif
+
+#ifndef  OS_SCHED_EDF_EN
+#define  OS_SCHED_EDF_EN              0u    /* Enable (1) or Disable (0) Earliest Deadline First tasks */
+#endif
+
+#ifndef  OS_SCHED_RR_EN
+#define  OS_SCHED_RR_EN               0u    /* Enable (1) or Disable (0) round-robin time slicing      */
+#endif
+
+#ifndef  OS_SCHED_RR_QUANTUM                /* Time slice of tasks sharing a priority (ticks), 0: FIFO */
+#define  OS_SCHED_RR_QUANTUM         (OS_TICKS_PER_SEC / 10u)
+#endif
+
+#ifndef  OS_TASK_PERIODIC_EN
+#define  OS_TASK_PERIODIC_EN          0u    /* Enable (1) or Disable (0) OSTaskCreatePeriodic()        */
+#endif
+
+#ifndef  OS_BUDGET_EN
+#define  OS_BUDGET_EN                 0u    /* Enable (1) or Disable (0) CPU budget enforcement        */
+#endif
+
+#ifndef  OS_PROFILE_EN
+#define  OS_PROFILE_EN                0u    /* Enable (1) or Disable (0) cycle accurate CPU profiling  */
+#endif
+
+#ifndef  OS_CPU_CYCLES                      /* Type of the port's free running cycle counter, read by  */
+#define  OS_CPU_CYCLES               INT32U /* ... OS_CPU_CYCLES_GET() (see OS_PROFILE.C)              */
+#endif
+
+#ifndef  OS_STAT_LOAD_EN
+#define  OS_STAT_LOAD_EN              0u    /* Compute CPU load from measured idle time (1) or from    */
+#endif                                      /* ... OSIdleCtr calibrated by OSStatInit() (0)            */
+
+#ifndef  OS_STK_WM_EN
+#define  OS_STK_WM_EN                 0u    /* Track stack high-water marks incrementally (1) or not   */
+#endif
+
+#ifndef  OS_STK_WM_GAP
+#define  OS_STK_WM_GAP               16u    /* Nbr of consecutive zero entries that end a stack scan   */
+#endif
+
+#ifndef  OS_STK_RED_SIZE
+#define  OS_STK_RED_SIZE              8u    /* Nbr of entries at the end of a stack that mean overflow */
+#endif
+
+#ifndef  OS_CPU_STK_PTR                     /* Stack pointer saved when a task was switched out        */
+#define  OS_CPU_STK_PTR(ptcb)        ((ptcb)->OSTCBStkPtr)
+#endif
+
+#ifndef  OS_MUTEX_CEIL_EN
+#define  OS_MUTEX_CEIL_EN             0u    /* Enable (1) or Disable (0) priority ceiling mutexes      */
+#endif
+
+#ifndef  OS_SLOTQ_EN
+#define  OS_SLOTQ_EN                  0u    /* Enable (1) or Disable (0) zero-copy slot queues         */
+#endif
+
+#ifndef  OS_MAX_SLOTQS
+#define  OS_MAX_SLOTQS                2u    /* Max. number of slot queue control blocks                */
+#endif
+
+#ifndef  OS_SLOTQ_MAX_SLOTS
+#define  OS_SLOTQ_MAX_SLOTS          32u    /* Max. number of slots in a slot queue                    */
+#endif
+
+#ifndef  OS_RING_EN
+#define  OS_RING_EN                   0u    /* Enable (1) or Disable (0) lock-free message rings       */
+#endif
+
+#ifndef  OS_CPU_LOAD_ACQ                    /* Read an INT32U with acquire semantics (see OS_RING.C)   */
+#define  OS_CPU_LOAD_ACQ(p)          (*(volatile INT32U *)(p))
+#endif
+
+#ifndef  OS_CPU_STORE_REL                   /* Write an INT32U with release semantics (see OS_RING.C)  */
+#define  OS_CPU_STORE_REL(p, v)      (*(volatile INT32U *)(p) = (v))
+#endif
+
+#ifndef  OS_Q_POST_N_EN
+#define  OS_Q_POST_N_EN               0u    /* Include code for OSQPostN()                             */
+#endif
+
+#ifndef  OS_SEM_POST_N_EN
+#define  OS_SEM_POST_N_EN             0u    /* Include code for OSSemPostN()                           */
+#endif
+
+#ifndef  OS_MAX_EVENT_NODES
+#define  OS_MAX_EVENT_NODES  OS_MAX_EVENTS  /* Max. number of events waited on at once by multi-pends  */
+#endif
+
+#ifndef  OS_TRACE_EN
+#define  OS_TRACE_EN                  0u    /* Enable (1) or Disable (0) the context switch trace ring */
+#endif
+
+#ifndef  OS_TRACE_BUF_SIZE
+#define  OS_TRACE_BUF_SIZE           64u    /* Number of records in trace ring (MUST be a power of 2)  */
+#endif
+
+#ifndef  OS_TRACE_TS_GET                    /* Time stamp stored in trace records                      */
+#if OS_TIME_GET_SET_EN > 0
+#define  OS_TRACE_TS_GET()           OSTime
+#else
+#define  OS_TRACE_TS_GET()           0L
+#endif
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           PRIORITY BITMAPS
+*
+* Note(s): 1) The ready list (OSRdyGrp, OSRdyTbl[]) and the wait list of each event (OSEventGrp and
+*             OSEventTbl[]) are bitmaps of the same layout: bit X of row Y stands for priority
+*             (Y << OS_PRIO_ROW_SHIFT) + X, and bit Y of the group is set when row Y is not empty.  A TCB
+*             holds the position (OSTCBY, OSTCBX) and the masks (OSTCBBitY, OSTCBBitX) of its priority,
+*             valid in both.
+*
+*          2) The highest priority in a bitmap is found with OS_PRIO_GRP_LOW() on the group, then
+*             OS_PRIO_ROW_LOW() on the row: one count trailing zeros each with OS_CTZ_EN.
+*
+*          3) Above 64 priorities, rows hold 16 priorities, split in bytes for OSUnMapTbl[].  With
+*             OS_PRIO_MAP64_EN they hold 64 priorities instead, in at most 4 rows, and each level is
+*             resolved with a single OS_CPU_CTZ() or OS_CPU_CTZ64().  Every service computes the position
+*             of a priority with OS_PRIO_ROW_SHIFT and OS_PRIO_ROW_MSK and copies wait lists as
+*             OS_PRIO_ROW words, so all of them work with either layout.
+*********************************************************************************************************
+*/
+
+#if OS_LOWEST_PRIO <= 63
+typedef  INT8U          OS_PRIO_GRP;                /* Group of a priority bitmap                      */
+typedef  INT8U          OS_PRIO_ROW;                /* Row   of a priority bitmap                      */
+#define  OS_PRIO_ROW_SHIFT            3u
+#elif OS_PRIO_MAP64_EN > 0
+typedef  INT8U          OS_PRIO_GRP;
+typedef  OS_CPU_INT64U  OS_PRIO_ROW;
+#define  OS_PRIO_ROW_SHIFT            6u
+#else
+typedef  INT16U         OS_PRIO_GRP;
+typedef  INT16U         OS_PRIO_ROW;
+#define  OS_PRIO_ROW_SHIFT            4u
+#endif
+
+#define  OS_PRIO_ROW_MSK            ((1u << OS_PRIO_ROW_SHIFT) - 1u)
+
+#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO >> OS_PRIO_ROW_SHIFT) + 1)  /* Size of event table          */
+#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO >> OS_PRIO_ROW_SHIFT) + 1)  /* Size of ready table          */
+
+#define  OS_PRIO_BIT_Y(y)            ((OS_PRIO_GRP)((OS_PRIO_GRP)1 << (y)))  /* Mask of row Y in group  */
+#define  OS_PRIO_BIT_X(x)            ((OS_PRIO_ROW)((OS_PRIO_ROW)1 << (x)))  /* Mask of bit X in a row  */
+
+#if OS_CTZ_EN > 0                           /* Position of lowest bit set in a non-zero group or row   */
+#define  OS_PRIO_GRP_LOW(grp)        OS_CPU_CTZ(grp)
+#if (OS_LOWEST_PRIO > 63) && (OS_PRIO_MAP64_EN > 0)
+#define  OS_PRIO_ROW_LOW(row)        OS_CPU_CTZ64(row)
+#else
+#define  OS_PRIO_ROW_LOW(row)        OS_CPU_CTZ(row)
+#endif
+#elif OS_LOWEST_PRIO <= 63
+#define  OS_PRIO_GRP_LOW(grp)        OSUnMapTbl[(grp)]
+#define  OS_PRIO_ROW_LOW(row)        OSUnMapTbl[(row)]
+#else
+#define  OS_PRIO_GRP_LOW(grp)        OS_PRIO_LOW16(grp)
+#define  OS_PRIO_ROW_LOW(row)        OS_PRIO_LOW16(row)
+#define  OS_PRIO_LOW16(w)          ((((w) & 0xFFu) != 0) ? OSUnMapTbl[(w) & 0xFFu]                        \
+                                                         : (INT8U)(OSUnMapTbl[((w) >> 8) & 0xFFu] + 8u))
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              READY LIST
+*
+* Note(s): 1) A task is put in the ready list with OS_RDY_INS() and removed from it with OS_RDY_DEL(), at
+*             the priority held in its TCB, and OS_RDY_TST() is true while it is in the list.
+*             OS_TCB_HIGH_RDY() is the task to run once OS_SchedNew() has found OSPrioHighRdy.
+*
+*          2) With OS_SCHED_RR_EN, tasks may share a priority (see OS_RR.C): the ready tasks of each
+*             priority wait in turn in OSRRRdyList[], and the bit of the priority is set in OSRdyTbl[]
+*             while that list is not empty.  Otherwise these macros set, clear and test the task's bit.
+*
+*          3) With OS_SCHED_EDF_EN, a task scheduled by deadline also enters and leaves OSEdfHeap[], the
+*             heap of the ready EDF tasks (see OS_EDF.C).
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+#define  OS_RDY_INS(ptcb)            OS_RRRdy(ptcb)
+#define  OS_RDY_DEL(ptcb)            OS_RRUnrdy(ptcb)
+#define  OS_RDY_TST(ptcb)          ((ptcb)->OSTCBRRNext != (OS_TCB *)0)
+#define  OS_TCB_HIGH_RDY()           OSRRRdyList[OSPrioHighRdy]
+#elif OS_SCHED_EDF_EN > 0
+#define  OS_RDY_INS(ptcb)          { OSRdyGrp                 |= (ptcb)->OSTCBBitY;                   \
+                                     OSRdyTbl[(ptcb)->OSTCBY] |= (ptcb)->OSTCBBitX;                   \
+                                     if ((ptcb)->OSTCBEdfEn == OS_TRUE) {                              \
+                                         OS_EdfRdy(ptcb);                                              \
+                                     } }
+#define  OS_RDY_DEL(ptcb)          { OSRdyTbl[(ptcb)->OSTCBY] &= ~(ptcb)->OSTCBBitX;                  \
+                                     if (OSRdyTbl[(ptcb)->OSTCBY] == 0) {                              \
+                                         OSRdyGrp &= ~(ptcb)->OSTCBBitY;                               \
+                                     }                                                                 \
+                                     if ((ptcb)->OSTCBEdfIx != 0) {                                    \
+                                         OS_EdfUnrdy(ptcb);                                            \
+                                     } }
+#define  OS_RDY_TST(ptcb)          ((OSRdyTbl[(ptcb)->OSTCBY] & (ptcb)->OSTCBBitX) != 0)
+#define  OS_TCB_HIGH_RDY()           OSTCBPrioTbl[OSPrioHighRdy]
+#else
+#define  OS_RDY_INS(ptcb)          { OSRdyGrp                 |= (ptcb)->OSTCBBitY;                   \
+                                     OSRdyTbl[(ptcb)->OSTCBY] |= (ptcb)->OSTCBBitX; }
+#define  OS_RDY_DEL(ptcb)          { OSRdyTbl[(ptcb)->OSTCBY] &= ~(ptcb)->OSTCBBitX;                  \
+                                     if (OSRdyTbl[(ptcb)->OSTCBY] == 0) {                              \
+                                         OSRdyGrp &= ~(ptcb)->OSTCBBitY;                               \
+                                     } }
+#define  OS_RDY_TST(ptcb)          ((OSRdyTbl[(ptcb)->OSTCBY] & (ptcb)->OSTCBBitX) != 0)
+#define  OS_TCB_HIGH_RDY()           OSTCBPrioTbl[OSPrioHighRdy]
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -107,9 +367,11 @@ extern "C" {
 #define  OS_STAT_SUSPEND           0x08u    /* Task is suspended                                       */
 #define  OS_STAT_MUTEX             0x10u    /* Pending on mutual exclusion semaphore                   */
 #define  OS_STAT_FLAG              0x20u    /* Pending on event flag group                             */
+#define  OS_STAT_SLOTQ             0x40u    /* Pending on slot queue                                   */
 #define  OS_STAT_MULTI             0x80u    /* Pending on multiple events                              */
 
-#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG)
+#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG | \
+                                   OS_STAT_SLOTQ)
 
 /*
 *********************************************************************************************************
@@ -131,6 +393,8 @@ extern "C" {
 #define  OS_EVENT_TYPE_SEM            3u
 #define  OS_EVENT_TYPE_MUTEX          4u
 #define  OS_EVENT_TYPE_FLAG           5u
+#define  OS_EVENT_TYPE_SLOTQ          6u
+#define  OS_EVENT_TYPE_MUTEX_CEIL     7u
 
 #define  OS_TMR_TYPE                100u    /* Used to identify Timers ...                             */
                                             /* ... (Must be different value than OS_EVENT_TYPE_xxx)    */
@@ -213,6 +477,33 @@ extern "C" {
 #define  OS_TASK_OPT_STK_CLR     0x0002u    /* Clear the stack when the task is create                 */
 #define  OS_TASK_OPT_SAVE_FP     0x0004u    /* Save the contents of any floating-point registers       */
 
+/*
+*********************************************************************************************************
+*                              BUDGET OVERRUN OPTIONS (see OSTaskBudgetSet())
+*********************************************************************************************************
+*/
+#define  OS_BUDGET_OPT_NONE        0x00u    /* Only count the overruns                                 */
+#define  OS_BUDGET_OPT_THROTTLE    0x01u    /* Delay the task until its next budget period             */
+#define  OS_BUDGET_OPT_HOOK        0x02u    /* Call the task's overrun hook                            */
+
+/*
+*********************************************************************************************************
+*                                  CPU LOAD WINDOWS (see OSTaskLoadGet())
+*********************************************************************************************************
+*/
+#define  OS_LOAD_WIN_100MS            0u    /* Load over the last 1/10 second                          */
+#define  OS_LOAD_WIN_1S               1u    /* Load over the last second                               */
+#define  OS_LOAD_WIN_10S              2u    /* Load over the last 10 seconds                           */
+#define  OS_LOAD_NWIN                 3u    /* Number of windows                                       */
+
+/*
+*********************************************************************************************************
+*                                    RING OPTIONS (see OSRingCreate())
+*********************************************************************************************************
+*/
+#define  OS_RING_OPT_NONE             0u    /* The consumer polls the ring with OSRingAccept()         */
+#define  OS_RING_OPT_PEND             1u    /* The consumer may also wait with OSRingPend()            */
+
 /*
 *********************************************************************************************************
 *                            TIMER OPTIONS (see OSTmrStart() and OSTmrStop())
@@ -261,11 +552,15 @@ extern "C" {
 #define OS_ERR_CREATE_ISR            16u
 #define OS_ERR_NAME_GET_ISR          17u
 #define OS_ERR_NAME_SET_ISR          18u
+#define OS_ERR_EVENT_NODE_DEPLETED   19u
 
 #define OS_ERR_MBOX_FULL             20u
 
 #define OS_ERR_Q_FULL                30u
 #define OS_ERR_Q_EMPTY               31u
+#define OS_ERR_SLOTQ_INVALID_SLOT    32u
+#define OS_ERR_SLOTQ_INVALID_SIZE    33u
+#define OS_ERR_RING_INVALID_SIZE     34u
 
 #define OS_ERR_PRIO_EXIST            40u
 #define OS_ERR_PRIO                  41u
@@ -287,6 +582,8 @@ extern "C" {
 #define OS_ERR_TASK_SUSPEND_IDLE     71u
 #define OS_ERR_TASK_SUSPEND_PRIO     72u
 #define OS_ERR_TASK_WAITING          73u
+#define OS_ERR_TASK_NOT_PERIODIC     74u
+#define OS_ERR_TASK_PERIOD           75u
 
 #define OS_ERR_TIME_NOT_DLY          80u
 #define OS_ERR_TIME_INVALID_MINUTES  81u
@@ -316,6 +613,7 @@ extern "C" {
 #define OS_ERR_FLAG_NAME_TOO_LONG   115u
 
 #define OS_ERR_PIP_LOWER            120u
+#define OS_ERR_CEIL_LOWER           121u
 
 #define OS_ERR_TMR_INVALID_DLY      130u
 #define OS_ERR_TMR_INVALID_PERIOD   131u
@@ -390,20 +688,37 @@ typedef struct os_event {
     INT8U    OSEventType;                    /* Type of event control block (see OS_EVENT_TYPE_xxxx)    */
     void    *OSEventPtr;                     /* Pointer to message or queue structure                   */
     INT16U   OSEventCnt;                     /* Semaphore Count (not used if other EVENT type)          */
-#if OS_LOWEST_PRIO <= 63
-    INT8U    OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-    INT8U    OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-#else
-    INT16U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-    INT16U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-#endif
+    OS_PRIO_GRP OSEventGrp;                  /* Group corresponding to tasks waiting for event to occur */
+    OS_PRIO_ROW OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur              */
 
 #if OS_EVENT_NAME_SIZE > 1
     INT8U    OSEventName[OS_EVENT_NAME_SIZE];
 #endif
+
+#if OS_EVENT_MULTI_EN > 0
+    struct os_event_node *OSEventNodeList;   /* List of multi-pend nodes waiting for event to occur     */
+#endif
 } OS_EVENT;
 #endif
 
+/*
+*********************************************************************************************************
+*                                         MULTI-PEND WAIT NODE
+*********************************************************************************************************
+*/
+
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0) && (OS_EVENT_MULTI_EN > 0)
+typedef struct os_event_node {                      /* One event waited on by OSEventPendMulti()       */
+    struct os_event_node  *OSEventNodeNext;         /* Pointer to next     NODE in event's list        */
+    struct os_event_node  *OSEventNodePrev;         /* Pointer to previous NODE in event's list        */
+    struct os_event_node  *OSEventNodeTaskNext;     /* Pointer to next     NODE of the same task       */
+    struct os_tcb         *OSEventNodeTCB;          /* Pointer to TCB of waiting task                  */
+    OS_EVENT              *OSEventNodeEvent;        /* Pointer to event waited on                      */
+    void                  *OSEventNodeMsg;          /* Message received when the event was posted      */
+    INT8U                  OSEventNodeStat;         /* OS_STAT_PEND_TO until event posted or aborted   */
+} OS_EVENT_NODE;
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -461,13 +776,8 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
 #if OS_MBOX_EN > 0
 typedef struct os_mbox_data {
     void   *OSMsg;                         /* Pointer to message in mailbox                            */
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
-    INT8U   OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
-    INT16U  OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
-#endif
+    OS_PRIO_ROW OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur             */
+    OS_PRIO_GRP OSEventGrp;                /* Group corresponding to tasks waiting for event to occur  */
 } OS_MBOX_DATA;
 #endif
 
@@ -509,13 +819,8 @@ typedef struct os_mem_data {
 
 #if OS_MUTEX_EN > 0
 typedef struct os_mutex_data {
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#endif
+    OS_PRIO_ROW OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur             */
+    OS_PRIO_GRP OSEventGrp;                 /* Group corresponding to tasks waiting for event to occur */
     BOOLEAN OSValue;                        /* Mutex value (OS_FALSE = used, OS_TRUE = available)      */
     INT8U   OSOwnerPrio;                    /* Mutex owner's task priority or 0xFF if no owner         */
     INT8U   OSMutexPIP;                     /* Priority Inheritance Priority or 0xFF if no owner       */
@@ -544,16 +849,54 @@ typedef struct os_q_data {
     void          *OSMsg;               /* Pointer to next message to be extracted from queue          */
     INT16U         OSNMsgs;             /* Number of messages in message queue                         */
     INT16U         OSQSize;             /* Size of message queue                                       */
-#if OS_LOWEST_PRIO <= 63
-    INT8U          OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
-    INT8U          OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
-#else
-    INT16U         OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
-    INT16U         OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
-#endif
+    OS_PRIO_ROW    OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur          */
+    OS_PRIO_GRP    OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
 } OS_Q_DATA;
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            SLOT QUEUE DATA
+*********************************************************************************************************
+*/
+
+#if OS_SLOTQ_EN > 0
+#define  OS_SLOT_FREE                 0u    /* Slot may be reserved by a producer                      */
+#define  OS_SLOT_RESERVED             1u    /* Slot is being written by the producer that reserved it  */
+#define  OS_SLOT_COMMITTED            2u    /* Slot holds a message not yet given to a consumer        */
+#define  OS_SLOT_BORROWED             3u    /* Slot is being read by the consumer that got it          */
+
+typedef struct os_slotq {               /* SLOT QUEUE CONTROL BLOCK                                    */
+    struct os_slotq *OSSlotQPtr;        /* Link to next slot queue control block in list of free blocks*/
+    INT8U           *OSSlotQStart;      /* Pointer to the first slot                                   */
+    INT16U           OSSlotQSlotSize;   /* Size of a slot (bytes)                                      */
+    INT16U           OSSlotQSize;       /* Number of slots                                             */
+    INT16U           OSSlotQIn;         /* Index of the next slot to reserve                           */
+    INT16U           OSSlotQOut;        /* Index of the next slot to give to a consumer                */
+    INT8U            OSSlotQState[OS_SLOTQ_MAX_SLOTS];  /* State of each slot (see OS_SLOT_xxx)       */
+} OS_SLOTQ;
+#endif
+
+/*
+*********************************************************************************************************
+*                                               RING DATA
+*********************************************************************************************************
+*/
+
+#if OS_RING_EN > 0
+typedef struct os_ring {                /* LOCK-FREE SINGLE PRODUCER, SINGLE CONSUMER RING             */
+    volatile INT32U  OSRingIn;          /* Nbr of messages posted   (only written by the producer)     */
+    volatile INT32U  OSRingOut;         /* Nbr of messages received (only written by the consumer)     */
+    void           **OSRingStart;       /* Pointer to the storage of the messages                      */
+    INT32U           OSRingMask;        /* Nbr of entries - 1 (the nbr of entries is a power of 2)     */
+#if OS_SEM_EN > 0
+    OS_EVENT        *OSRingSem;         /* Semaphore the consumer waits on (NULL if it only polls)     */
+    volatile BOOLEAN OSRingWait;        /* The consumer waits for the next message                     */
+#endif
+} OS_RING;
+#endif
+
 /*
 *********************************************************************************************************
 *                                           SEMAPHORE DATA
@@ -563,16 +906,29 @@ typedef struct os_q_data {
 #if OS_SEM_EN > 0
 typedef struct os_sem_data {
     INT16U  OSCnt;                          /* Semaphore count                                         */
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#endif
+    OS_PRIO_ROW OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur             */
+    OS_PRIO_GRP OSEventGrp;                 /* Group corresponding to tasks waiting for event to occur */
 } OS_SEM_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                          PERIODIC TASK DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+typedef struct os_job_data {
+    INT32U  OSJobCtr;                  /* Number of jobs completed                                     */
+    INT32U  OSJobSkipCtr;              /* Number of releases skipped because a job overran its period  */
+    INT32U  OSJobRelease;              /* Release time of the current job                              */
+    INT16U  OSJobRespLast;             /* Response time of the last job (in ticks)                     */
+    INT16U  OSJobRespMin;              /* Shortest response time                                       */
+    INT16U  OSJobRespMax;              /* Longest  response time                                       */
+    INT16U  OSJobJitter;               /* Response time jitter (OSJobRespMax - OSJobRespMin)           */
+} OS_JOB_DATA;
+#endif
+
 /*
 *********************************************************************************************************
 *                                            TASK STACK DATA
@@ -593,6 +949,21 @@ typedef struct os_stk_data {
 *********************************************************************************************************
 */
 
+#if OS_BUDGET_EN > 0
+typedef  void (*OS_BUDGET_HOOK)(INT8U prio);        /* Called when a task overruns its CPU budget      */
+#endif
+
+#if OS_STK_WM_EN > 0
+typedef  void (*OS_STK_OVF_HOOK)(INT8U prio);       /* Called when a task overflows its stack          */
+#endif
+
+#if OS_STAT_LOAD_EN > 0
+typedef struct os_load {
+    INT32U           OSLoadSum[OS_LOAD_NWIN - 1];   /* Sum of the loads of the shorter window so far   */
+    INT16U           OSLoad[OS_LOAD_NWIN];          /* Load over each window (in 0.01 %)               */
+} OS_LOAD;
+#endif
+
 typedef struct os_tcb {
     OS_STK          *OSTCBStkPtr;           /* Pointer to current top of stack                         */
 
@@ -613,33 +984,37 @@ typedef struct os_tcb {
 
 #if (OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0)
     OS_EVENT       **OSTCBEventMultiPtr;    /* Pointer to multiple event control blocks                */
+    OS_EVENT_NODE   *OSTCBEventNodeList;    /* Nodes of the multi-pend, in the order of the events     */
 #endif
 
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
+#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SLOTQ_EN > 0)
     void            *OSTCBMsg;              /* Message received from OSMboxPost() or OSQPost()         */
 #endif
 
 #if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
-#if OS_TASK_DEL_EN > 0
+#if (OS_TASK_DEL_EN > 0) || (OS_EVENT_MULTI_EN > 0)
     OS_FLAG_NODE    *OSTCBFlagNode;         /* Pointer to event flag node                              */
 #endif
     OS_FLAGS         OSTCBFlagsRdy;         /* Event flags that made task ready to run                 */
 #endif
 
     INT16U           OSTCBDly;              /* Nbr ticks to delay task or, timeout waiting for event   */
+                                            /* ... With OS_DLY_LIST_EN, the delay it started with, not */
+                                            /* ... the ticks left: use OS_DlyGet() for those           */
+#if OS_DLY_LIST_EN > 0
+    struct os_tcb   *OSTCBDlyNext;          /* Pointer to next     TCB in the delay list               */
+    struct os_tcb   *OSTCBDlyPrev;          /* Pointer to previous TCB in the delay list               */
+    INT16U           OSTCBDlyDelta;         /* Nbr ticks to expiry after previous TCB in delay list    */
+    BOOLEAN          OSTCBDlyLinked;        /* OS_TRUE if the TCB is in the delay list                 */
+#endif
     INT8U            OSTCBStat;             /* Task      status                                        */
     INT8U            OSTCBStatPend;         /* Task PEND status                                        */
     INT8U            OSTCBPrio;             /* Task priority (0 == highest)                            */
 
     INT8U            OSTCBX;                /* Bit position in group  corresponding to task priority   */
     INT8U            OSTCBY;                /* Index into ready table corresponding to task priority   */
-#if OS_LOWEST_PRIO <= 63
-    INT8U            OSTCBBitX;             /* Bit mask to access bit position in ready table          */
-    INT8U            OSTCBBitY;             /* Bit mask to access bit position in ready group          */
-#else
-    INT16U           OSTCBBitX;             /* Bit mask to access bit position in ready table          */
-    INT16U           OSTCBBitY;             /* Bit mask to access bit position in ready group          */
-#endif
+    OS_PRIO_ROW      OSTCBBitX;             /* Bit mask to access bit position in ready table          */
+    OS_PRIO_GRP      OSTCBBitY;             /* Bit mask to access bit position in ready group          */
 
 #if OS_TASK_DEL_EN > 0
     INT8U            OSTCBDelReq;           /* Indicates whether a task needs to delete itself         */
@@ -647,8 +1022,8 @@ typedef struct os_tcb {
 
 #if OS_TASK_PROFILE_EN > 0
     INT32U           OSTCBCtxSwCtr;         /* Number of time the task was switched in                 */
-    INT32U           OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
-    INT32U           OSTCBCyclesStart;      /* Snapshot of cycle counter at start of task resumption   */
+    OS_CPU_CYCLES    OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
+    OS_CPU_CYCLES    OSTCBCyclesStart;      /* Snapshot of cycle counter at start of task resumption   */
     OS_STK          *OSTCBStkBase;          /* Pointer to the beginning of the task stack              */
     INT32U           OSTCBStkUsed;          /* Number of bytes used from the stack                     */
 #endif
@@ -658,8 +1033,67 @@ typedef struct os_tcb {
 #endif
 
     INT8U  compTime;   /* Remaining computation time*/
-    INT8U  period;     /* Task period */
+    INT16U period;     /* Task period */
     INT32U deadline;     /* Next absolute deadline */
+
+#if OS_DEADLINE_EN > 0
+    INT16U           OSTCBDeadlineIx;       /* Position in OSDeadlineHeap[] + 1, 0 if not monitored    */
+    INT32U           OSTCBDeadlineMissCtr;  /* Number of deadlines missed by the task                  */
+#endif
+
+#if OS_SCHED_EDF_EN > 0
+    INT16U           OSTCBEdfIx;            /* Position in OSEdfHeap[] + 1, 0 if not ready             */
+    BOOLEAN          OSTCBEdfEn;            /* OS_TRUE if task is scheduled by its deadline            */
+#endif
+
+#if OS_SCHED_RR_EN > 0
+    struct os_tcb   *OSTCBRRNext;           /* Next     ready TCB at the same priority, NULL if not rdy */
+    struct os_tcb   *OSTCBRRPrev;           /* Previous ready TCB at the same priority                 */
+    struct os_tcb   *OSTCBRRLevelNext;      /* Next     TCB created at the same priority               */
+    struct os_tcb   *OSTCBRRLevelPrev;      /* Previous TCB created at the same priority               */
+    INT32U           OSTCBRRSeq;            /* Value of OSRRSeq when the task was last made not ready  */
+    INT16U           OSTCBRRQuantumCtr;     /* Ticks left in the task's time slice                     */
+    INT8U            OSTCBRRLevel;          /* Priority the task was created at (or changed to)        */
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0
+    void           (*OSTCBJobFnct)(void *p_arg);  /* Body of each job, NULL if task is not periodic   */
+    INT32U           OSTCBJobRelease;       /* Release time of the current job                         */
+    INT32U           OSTCBJobCtr;           /* Number of jobs completed                                */
+    INT32U           OSTCBJobSkipCtr;       /* Number of releases skipped after a job overran          */
+    INT16U           OSTCBJobDeadline;      /* Relative deadline of each job (in ticks)                */
+    INT16U           OSTCBJobRespLast;      /* Response time of the last job (in ticks)                */
+    INT16U           OSTCBJobRespMin;       /* Shortest response time                                  */
+    INT16U           OSTCBJobRespMax;       /* Longest  response time                                  */
+    INT8U            OSTCBJobComp;          /* Computation time of each job, reloaded in compTime      */
+#endif
+
+#if OS_MUTEX_CEIL_EN > 0
+    INT8U            OSTCBCeilNest;         /* Number of priority ceiling mutexes held by the task     */
+    INT8U            OSTCBCeilBasePrio;     /* Priority before the first of them was locked            */
+#endif
+
+#if OS_BUDGET_EN > 0
+    OS_BUDGET_HOOK   OSTCBBudgetHook;       /* Function called when the budget is overrun              */
+    INT32U           OSTCBBudgetRelease;    /* Start of the current budget period                      */
+    INT32U           OSTCBBudgetOvrCtr;     /* Number of budget periods that were overrun              */
+    INT16U           OSTCBBudget;           /* CPU budget per period (in ticks), 0 if not enforced     */
+    INT16U           OSTCBBudgetLeft;       /* Budget left in the current period                       */
+    INT16U           OSTCBBudgetPeriod;     /* Budget replenishment period (in ticks)                  */
+    INT8U            OSTCBBudgetOpt;        /* Action taken on overrun (see OS_BUDGET_OPT_xxx)         */
+    BOOLEAN          OSTCBBudgetOvr;        /* OS_TRUE if the budget of this period was overrun        */
+#endif
+
+#if OS_STK_WM_EN > 0
+    OS_STK          *OSTCBStkWm;            /* Deepest stack entry known to have been used             */
+    OS_STK          *OSTCBStkLimit;         /* Task overflows when its stack reaches this entry        */
+    BOOLEAN          OSTCBStkOvf;           /* OS_TRUE once the task has overflowed its stack          */
+#endif
+
+#if OS_STAT_LOAD_EN > 0
+    OS_CPU_CYCLES    OSTCBLoadCycles;       /* OSTCBCyclesTot at the previous load sample              */
+    OS_LOAD          OSTCBLoad;             /* Share of the CPU used by the task                       */
+#endif
 } OS_TCB;
 
 /*$PAGE*/
@@ -701,6 +1135,46 @@ typedef  struct  os_tmr_wheel {
 } OS_TMR_WHEEL;
 #endif
 
+/*
+*********************************************************************************************************
+*                                          CONTEXT SWITCH TRACE
+*********************************************************************************************************
+*/
+
+#if OS_TRACE_EN > 0
+#define  OS_TRACE_EVT_PREEMPT         1u    /* Task preempted on ISR exit        (see OSIntExit())     */
+#define  OS_TRACE_EVT_COMPLETE        2u    /* Task gave up the CPU at task level (see OS_Sched())     */
+#define  OS_TRACE_EVT_DEADLINE        3u    /* Task 'From' missed its deadline while 'To' was running  */
+#define  OS_TRACE_EVT_BUDGET          4u    /* Task 'From' overran its CPU budget (see OS_BUDGET.C)    */
+#define  OS_TRACE_EVT_STK_OVF         5u    /* Task 'From' overflowed its stack   (see OS_STK.C)       */
+
+typedef struct os_trace_rec {
+    INT32U   OSTraceTime;                   /* Time stamp of the event (see OS_TRACE_TS_GET())          */
+    INT8U    OSTraceEvent;                  /* Kind of event (see OS_TRACE_EVT_xxx)                     */
+    INT8U    OSTraceFrom;                   /* Priority of the task switched out                       */
+    INT8U    OSTraceTo;                     /* Priority of the task switched in                        */
+} OS_TRACE_REC;
+#endif
+
+/*
+*********************************************************************************************************
+*                                         CPU PROFILE SNAPSHOT
+*********************************************************************************************************
+*/
+
+#if OS_PROFILE_EN > 0
+typedef struct os_profile_snap {
+    OS_CPU_CYCLES  OSProfileTotal;          /* Cycles elapsed since OSStart() or OSProfileReset()      */
+    OS_CPU_CYCLES  OSProfileInt;            /* Cycles spent in ISRs, outside of any task               */
+    OS_CPU_CYCLES  OSProfileTick;           /* Cycles spent in OSTimeTick() (part of OSProfileInt)     */
+    OS_CPU_CYCLES  OSProfileSched;          /* Cycles spent in OS_Sched() up to a context switch       */
+    INT32U         OSProfileIntCtr;         /* Number of ISRs (outermost OSIntEnter() calls)           */
+    INT32U         OSProfileCtxSwCtr;       /* Number of context switches                              */
+    OS_CPU_CYCLES  OSProfileTaskCycles[OS_LOWEST_PRIO + 1];   /* Cycles run by each task, by priority  */
+    INT32U         OSProfileTaskCtxSwCtr[OS_LOWEST_PRIO + 1]; /* Nbr of times each task was switched in*/
+} OS_PROFILE_SNAP;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -713,6 +1187,10 @@ OS_EXT  INT32U            OSCtxSwCtr;               /* Counter of number of cont
 #if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
 OS_EXT  OS_EVENT         *OSEventFreeList;          /* Pointer to list of free EVENT control blocks    */
 OS_EXT  OS_EVENT          OSEventTbl[OS_MAX_EVENTS];/* Table of EVENT control blocks                   */
+#if OS_EVENT_MULTI_EN > 0
+OS_EXT  OS_EVENT_NODE    *OSEventNodeFreeList;      /* Pointer to list of free multi-pend nodes        */
+OS_EXT  OS_EVENT_NODE     OSEventNodeTbl[OS_MAX_EVENT_NODES];  /* Table of multi-pend nodes            */
+#endif
 #endif
 
 #if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
@@ -728,6 +1206,17 @@ OS_EXT  BOOLEAN           OSStatRdy;                /* Flag indicating that the
 OS_EXT  OS_STK            OSTaskStatStk[OS_TASK_STAT_STK_SIZE];      /* Statistics task stack          */
 #endif
 
+#if OS_STAT_LOAD_EN > 0
+OS_EXT  INT16U            OSCPULoad[OS_LOAD_NWIN];  /* CPU load over each window (in 0.01 %)           */
+OS_EXT  OS_CPU_CYCLES     OSLoadTime;               /* Cycle counter at the previous load sample       */
+OS_EXT  INT8U             OSLoadCtr;                /* Nbr of load samples in the current 10 seconds   */
+#endif
+
+#if OS_STK_WM_EN > 0
+OS_EXT  OS_STK_OVF_HOOK   OSStkOvfHook;             /* Function called when a task overflows its stack */
+OS_EXT  INT8U             OSStkOvfCtr;              /* Number of tasks that overflowed their stack     */
+#endif
+
 OS_EXT  INT8U             OSIntNesting;             /* Interrupt nesting level                         */
 
 OS_EXT  INT8U             OSLockNesting;            /* Multitasking lock nesting level                 */
@@ -735,13 +1224,8 @@ OS_EXT  INT8U             OSLockNesting;            /* Multitasking lock nesting
 OS_EXT  INT8U             OSPrioCur;                /* Priority of current task                        */
 OS_EXT  INT8U             OSPrioHighRdy;            /* Priority of highest priority task               */
 
-#if OS_LOWEST_PRIO <= 63
-OS_EXT  INT8U             OSRdyGrp;                        /* Ready list group                         */
-OS_EXT  INT8U             OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
-#else
-OS_EXT  INT16U            OSRdyGrp;                        /* Ready list group                         */
-OS_EXT  INT16U            OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
-#endif
+OS_EXT  OS_PRIO_GRP       OSRdyGrp;                        /* Ready list group                         */
+OS_EXT  OS_PRIO_ROW       OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
 
 OS_EXT  BOOLEAN           OSRunning;                       /* Flag indicating that kernel is running   */
 
@@ -757,6 +1241,27 @@ OS_EXT  OS_TCB           *OSTCBFreeList;                   /* Pointer to list of
 OS_EXT  OS_TCB           *OSTCBHighRdy;                    /* Pointer to highest priority TCB R-to-R   */
 OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly linked list of TCBs    */
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1];/* Table of pointers to created TCBs        */
+
+#if OS_DEADLINE_EN > 0
+OS_EXT  OS_TCB           *OSDeadlineHeap[OS_MAX_TASKS + OS_N_SYS_TASKS]; /* Monitored tasks (min-heap)    */
+OS_EXT  INT16U            OSDeadlineHeapCtr;        /* Number of tasks in OSDeadlineHeap[]                    */
+OS_EXT  INT32U            OSDeadlineMissCtr;        /* Number of deadlines missed by all tasks                */
+#endif
+
+#if OS_DLY_LIST_EN > 0
+OS_EXT  OS_TCB           *OSTCBDlyList;             /* Delayed tasks sorted by expiry (see OSTCBDlyDelta)     */
+#endif
+
+#if OS_SCHED_EDF_EN > 0
+OS_EXT  OS_TCB           *OSEdfHeap[OS_MAX_TASKS + OS_N_SYS_TASKS];      /* Ready EDF tasks (min-heap)    */
+OS_EXT  INT16U            OSEdfHeapCtr;             /* Number of tasks in OSEdfHeap[]                         */
+#endif
+
+#if OS_SCHED_RR_EN > 0
+OS_EXT  OS_TCB           *OSRRRdyList[OS_LOWEST_PRIO + 1];  /* Ready tasks of each priority, in turn       */
+OS_EXT  INT16U            OSRRQuantum;              /* Time slice of tasks sharing a priority, 0 if none      */
+OS_EXT  INT32U            OSRRSeq;                  /* Counts the times a task was made not ready             */
+#endif
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
 #if OS_TICK_STEP_EN > 0
@@ -773,6 +1278,11 @@ OS_EXT  OS_Q             *OSQFreeList;              /* Pointer to list of free Q
 OS_EXT  OS_Q              OSQTbl[OS_MAX_QS];        /* Table of QUEUE control blocks                   */
 #endif
 
+#if OS_SLOTQ_EN > 0
+OS_EXT  OS_SLOTQ         *OSSlotQFreeList;          /* Pointer to list of free slot queue blocks       */
+OS_EXT  OS_SLOTQ          OSSlotQTbl[OS_MAX_SLOTQS];/* Table of slot queue control blocks              */
+#endif
+
 #if OS_TIME_GET_SET_EN > 0
 OS_EXT  volatile  INT32U  OSTime;                   /* Current value of system time (in ticks)         */
 #endif
@@ -792,7 +1302,26 @@ OS_EXT  OS_STK            OSTmrTaskStk[OS_TASK_TMR_STK_SIZE];
 OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_CFG_WHEEL_SIZE];
 #endif
 
+#if OS_TRACE_EN > 0
+OS_EXT  OS_TRACE_REC      OSTraceBuf[OS_TRACE_BUF_SIZE];   /* Context switch trace ring                */
+OS_EXT  INT32U            OSTraceIn;                       /* Free running index of next record to put */
+OS_EXT  INT32U            OSTraceOut;                      /* Free running index of next record to get */
+OS_EXT  INT32U            OSTraceLost;                     /* Nbr of records overwritten before read   */
+#endif
+
+#if OS_PROFILE_EN > 0
+OS_EXT  OS_CPU_CYCLES     OSProfileStart;                  /* Cycle counter at start of the profile    */
+OS_EXT  OS_CPU_CYCLES     OSProfileIntStart;               /* Cycle counter at entry of outermost ISR  */
+OS_EXT  OS_CPU_CYCLES     OSProfileIntCycles;              /* Cycles spent in ISRs                     */
+OS_EXT  OS_CPU_CYCLES     OSProfileTickCycles;             /* Cycles spent in OSTimeTick()             */
+OS_EXT  OS_CPU_CYCLES     OSProfileSchedCycles;            /* Cycles spent in OS_Sched()               */
+OS_EXT  INT32U            OSProfileIntCtr;                 /* Number of ISRs                           */
+OS_EXT  INT32U            OSProfileCtxSwCtr;               /* Number of context switches               */
+#endif
+
+#if OS_CTZ_EN == 0
 extern  INT8U   const     OSUnMapTbl[256];          /* Priority->Index    lookup table                 */
+#endif
 
 /*$PAGE*/
 /*
@@ -826,6 +1355,16 @@ INT16U        OSEventPendMulti        (OS_EVENT       **pevents_pend,
                                        void           **pmsgs_rdy,
                                        INT16U           timeout,
                                        INT8U           *perr);
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+INT16U        OSEventPendMultiExt     (OS_EVENT       **pevents_pend,
+                                       OS_EVENT       **pevents_rdy,
+                                       void           **pmsgs_rdy,
+                                       OS_FLAGS         flags,
+                                       INT8U            wait_type,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+#endif
 #endif
 
 #endif
@@ -998,6 +1537,26 @@ INT8U         OSMutexQuery            (OS_EVENT        *pevent,
 
 #endif
 
+/*
+*********************************************************************************************************
+*                                     PRIORITY CEILING MUTEX MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_CEIL_EN > 0
+BOOLEAN       OSMutexCeilAccept       (OS_EVENT        *pevent,
+                                       INT8U           *perr);
+
+OS_EVENT     *OSMutexCeilCreate       (INT8U            ceil,
+                                       INT8U           *perr);
+
+void          OSMutexCeilPend         (OS_EVENT        *pevent,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSMutexCeilPost         (OS_EVENT        *pevent);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1045,6 +1604,13 @@ INT8U         OSQPostFront            (OS_EVENT        *pevent,
                                        void            *pmsg);
 #endif
 
+#if OS_Q_POST_N_EN > 0
+INT16U        OSQPostN                (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           nmsgs,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_POST_OPT_EN > 0
 INT8U         OSQPostOpt              (OS_EVENT        *pevent,
                                        void            *pmsg,
@@ -1058,6 +1624,66 @@ INT8U         OSQQuery                (OS_EVENT        *pevent,
 
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         SLOT QUEUE MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if OS_SLOTQ_EN > 0
+void         *OSSlotQAccept           (OS_EVENT        *pevent,
+                                       INT8U           *perr);
+
+INT8U         OSSlotQCommit           (OS_EVENT        *pevent,
+                                       void            *pslot);
+
+OS_EVENT     *OSSlotQCreate           (void            *pstart,
+                                       INT16U           nslots,
+                                       INT16U           slot_size,
+                                       INT8U           *perr);
+
+OS_EVENT     *OSSlotQDel              (OS_EVENT        *pevent,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+
+void         *OSSlotQPend             (OS_EVENT        *pevent,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSSlotQRelease          (OS_EVENT        *pevent,
+                                       void            *pslot);
+
+void         *OSSlotQReserve          (OS_EVENT        *pevent,
+                                       INT8U           *perr);
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            RING MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if OS_RING_EN > 0
+void         *OSRingAccept            (OS_RING         *pring,
+                                       INT8U           *perr);
+
+INT8U         OSRingCreate            (OS_RING         *pring,
+                                       void           **pstart,
+                                       INT32U           size,
+                                       INT8U            opt);
+
+#if OS_SEM_EN > 0
+void         *OSRingPend              (OS_RING         *pring,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+#endif
+
+INT8U         OSRingPost              (OS_RING         *pring,
+                                       void            *pmsg);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1090,6 +1716,11 @@ INT8U         OSSemPendAbort          (OS_EVENT        *pevent,
 
 INT8U         OSSemPost               (OS_EVENT        *pevent);
 
+#if OS_SEM_POST_N_EN > 0
+INT8U         OSSemPostN              (OS_EVENT        *pevent,
+                                       INT16U           cnt);
+#endif
+
 #if OS_SEM_QUERY_EN > 0
 INT8U         OSSemQuery              (OS_EVENT        *pevent,
                                        OS_SEM_DATA     *p_sem_data);
@@ -1133,11 +1764,46 @@ INT8U         OSTaskCreateExt         (void           (*task)(void *p_arg),
                                        INT16U           opt);
 #endif
 
+#if OS_TASK_PERIODIC_EN > 0
+INT8U         OSTaskCreatePeriodic    (void           (*task)(void *p_arg),
+                                       void            *p_arg,
+                                       OS_STK          *ptos,
+                                       INT8U            prio,
+                                       INT16U           id,
+                                       OS_STK          *pbos,
+                                       INT32U           stk_size,
+                                       void            *pext,
+                                       INT16U           opt,
+                                       INT8U            comp,
+                                       INT16U           period,
+                                       INT16U           deadline,
+                                       INT16U           phase);
+#endif
+
+#if (OS_SCHED_EDF_EN > 0) || (OS_DEADLINE_EN > 0)
+INT8U         OSTaskDeadlineSet       (INT8U            prio,
+                                       INT32U           deadline);
+#endif
+
 #if OS_TASK_DEL_EN > 0
 INT8U         OSTaskDel               (INT8U            prio);
 INT8U         OSTaskDelReq            (INT8U            prio);
 #endif
 
+#if OS_BUDGET_EN > 0
+INT8U         OSTaskBudgetSet         (INT8U            prio,
+                                       INT16U           budget,
+                                       INT16U           period,
+                                       INT8U            opt,
+                                       OS_BUDGET_HOOK   phook);
+#endif
+
+#if OS_STAT_LOAD_EN > 0
+INT8U         OSTaskLoadGet           (INT8U            prio,
+                                       INT8U            win,
+                                       INT16U          *pload);
+#endif
+
 #if OS_TASK_NAME_SIZE > 1
 INT8U         OSTaskNameGet           (INT8U            prio,
                                        INT8U           *pname,
@@ -1158,6 +1824,26 @@ INT8U         OSTaskStkChk            (INT8U            prio,
                                        OS_STK_DATA     *p_stk_data);
 #endif
 
+#if OS_STK_WM_EN > 0
+void          OSTaskStkOvfHookSet     (OS_STK_OVF_HOOK  phook);
+
+INT8U         OSTaskStkWmGet          (INT8U            prio,
+                                       OS_STK_DATA     *p_stk_data);
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0
+INT8U         OSTaskJobEnd            (void);
+
+INT8U         OSTaskJobQuery          (INT8U            prio,
+                                       OS_JOB_DATA     *p_job_data);
+#endif
+
+#if OS_DEADLINE_EN > 0
+INT8U         OSTaskPeriodSet         (INT8U            prio,
+                                       INT16U           period,
+                                       INT32U           deadline);
+#endif
+
 #if OS_TASK_QUERY_EN > 0
 INT8U         OSTaskQuery             (INT8U            prio,
                                        OS_TCB          *p_task_data);
@@ -1230,6 +1916,29 @@ BOOLEAN      OSTmrStop                (OS_TMR          *ptmr,
 INT8U        OSTmrSignal              (void);
 #endif
 
+/*
+*********************************************************************************************************
+*                                          CONTEXT SWITCH TRACE
+*********************************************************************************************************
+*/
+
+#if OS_TRACE_EN > 0
+INT16U        OSTraceRead             (OS_TRACE_REC    *prec,
+                                       INT16U           nrecs);
+#endif
+
+/*
+*********************************************************************************************************
+*                                             CPU PROFILING
+*********************************************************************************************************
+*/
+
+#if OS_PROFILE_EN > 0
+void          OSProfileReset          (void);
+
+INT8U         OSProfileSnap           (OS_PROFILE_SNAP *psnap);
+#endif
+
 /*
 *********************************************************************************************************
 *                                             MISCELLANEOUS
@@ -1246,6 +1955,10 @@ void          OSSchedLock             (void);
 void          OSSchedUnlock           (void);
 #endif
 
+#if OS_SCHED_RR_EN > 0
+void          OSSchedRRSet            (INT16U           quantum);
+#endif
+
 void          OSStart                 (void);
 
 void          OSStatInit              (void);
@@ -1260,23 +1973,73 @@ INT16U        OSVersion               (void);
 *********************************************************************************************************
 */
 
+#if OS_BUDGET_EN > 0
+void          OS_BudgetTick           (void);
+#endif
+
+#if OS_DEADLINE_EN > 0
+void          OS_DeadlineChk          (void);
+
+void          OS_DeadlineUnlink       (OS_TCB          *ptcb);
+#endif
+
+#if OS_DLY_LIST_EN > 0
+INT16U        OS_DlyGet               (OS_TCB          *ptcb);
+
+void          OS_DlyUnlink            (OS_TCB          *ptcb);
+#endif
+
 #if OS_TASK_DEL_EN > 0
 void          OS_Dummy                (void);
 #endif
 
+#if OS_SCHED_EDF_EN > 0
+void          OS_EdfRdy               (OS_TCB          *ptcb);
+
+INT8U         OS_EdfSchedNew          (void);
+
+void          OS_EdfSet               (OS_TCB          *ptcb,
+                                       INT32U           deadline);
+
+void          OS_EdfUnlink            (OS_TCB          *ptcb);
+
+void          OS_EdfUnrdy             (OS_TCB          *ptcb);
+#endif
+
 #if (OS_EVENT_EN)
 INT8U         OS_EventTaskRdy         (OS_EVENT        *pevent,
                                        void            *pmsg,
                                        INT8U            msk,
                                        INT8U            pend_stat);
 
+OS_TCB       *OS_EventTaskRdyTCB      (OS_EVENT        *pevent,
+                                       void            *pmsg,
+                                       INT8U            msk,
+                                       INT8U            pend_stat);
+
+INT16U        OS_EventTaskRdyAll      (OS_EVENT        *pevent,
+                                       void            *pmsg,
+                                       INT8U            msk,
+                                       INT8U            pend_stat);
+
 void          OS_EventTaskWait        (OS_EVENT        *pevent);
 
 void          OS_EventTaskRemove      (OS_TCB          *ptcb,
                                        OS_EVENT        *pevent);
 
+void          OS_EventTaskMove        (OS_TCB          *ptcb,
+                                       OS_EVENT        *pevent,
+                                       INT8U            prio_old);
+
+#if OS_SCHED_RR_EN > 0
+OS_TCB       *OS_EventTaskFind        (OS_EVENT        *pevent,
+                                       INT8U            prio,
+                                       OS_TCB          *pskip);
+#endif
+
 #if (OS_EVENT_MULTI_EN > 0)
-void          OS_EventTaskWaitMulti   (OS_EVENT       **pevents_wait);
+void          OS_EventMultiRdy        (OS_TCB          *ptcb,
+                                       OS_EVENT_NODE   *pnode_rdy);
 
 void          OS_EventTaskRemoveMulti (OS_TCB          *ptcb,
                                        OS_EVENT       **pevents_multi);
@@ -1290,12 +2053,16 @@ void          OS_FlagInit             (void);
 void          OS_FlagUnlink           (OS_FLAG_NODE    *pnode);
 #endif
 
+#if OS_STAT_LOAD_EN > 0
+void          OS_LoadUpdate           (void);
+#endif
+
 void          OS_MemClr               (INT8U           *pdest,
-                                       INT16U           size);
+                                       INT32U           size);
 
 void          OS_MemCopy              (INT8U           *pdest,
                                        INT8U           *psrc,
-                                       INT16U           size);
+                                       INT32U           size);
 
 #if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
 void          OS_MemInit              (void);
@@ -1305,8 +2072,34 @@ void          OS_MemInit              (void);
 void          OS_QInit                (void);
 #endif
 
+#if OS_PROFILE_EN > 0
+void          OS_ProfileIntEnter      (void);
+void          OS_ProfileIntExit       (void);
+
+void          OS_ProfileSw            (OS_CPU_CYCLES    ts);
+#endif
+
+#if OS_SCHED_RR_EN > 0
+BOOLEAN       OS_RRLevelTst           (INT8U            prio);
+void          OS_RRLevelLink          (OS_TCB          *ptcb);
+void          OS_RRLevelUnlink        (OS_TCB          *ptcb);
+
+void          OS_RRRdy                (OS_TCB          *ptcb);
+void          OS_RRUnrdy              (OS_TCB          *ptcb);
+void          OS_RRTick               (void);
+#endif
+
 void          OS_Sched                (void);
 
+#if OS_SLOTQ_EN > 0
+void          OS_SlotQInit            (void);
+#endif
+
+#if OS_STK_WM_EN > 0
+void          OS_StkWmScan            (OS_TCB          *ptcb);
+void          OS_StkWmSw              (void);
+#endif
+
 #if (OS_EVENT_NAME_SIZE > 1) || (OS_FLAG_NAME_SIZE > 1) || (OS_MEM_NAME_SIZE > 1) || (OS_TASK_NAME_SIZE > 1)
 INT8U         OS_StrCopy              (INT8U           *pdest,
                                        INT8U           *psrc);
@@ -1338,6 +2131,17 @@ INT8U         OS_TCBInit              (INT8U            prio,
                                        void            *pext,
                                        INT16U           opt);
 
+#if (OS_SCHED_EDF_EN > 0) || (OS_DEADLINE_EN > 0)
+void          OS_TaskDeadlineSet      (OS_TCB          *ptcb,
+                                       INT32U           deadline);
+#endif
+
+#if OS_TRACE_EN > 0
+void          OS_TraceRec             (INT8U            event,
+                                       INT8U            from,
+                                       INT8U            to);
+#endif
+
 #if OS_TMR_EN > 0
 void          OSTmr_Init              (void);
 #endif
@@ -1378,6 +2182,10 @@ void          OSTCBInitHook           (OS_TCB          *ptcb);
 void          OSTimeTickHook          (void);
 #endif
 
+#if OS_TICKLESS_EN > 0
+INT16U        OS_CPU_TickSuppress     (INT16U           ticks);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1555,6 +2363,12 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+#if OS_MUTEX_CEIL_EN > 0
+    #if     OS_MAX_EVENTS == 0
+    #error  "OS_CFG.H, OS_MAX_EVENTS must be > 0 to create priority ceiling mutexes (OS_MUTEX_CEIL_EN)"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                              MESSAGE QUEUES
@@ -1648,7 +2462,11 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H,         OS_MAX_TASKS must be >= 2"
     #endif
 
-    #if     OS_MAX_TASKS >  ((OS_LOWEST_PRIO - OS_N_SYS_TASKS) + 1)
+    #if     OS_SCHED_RR_EN > 0
+    #if     OS_MAX_TASKS >  (255 - OS_N_SYS_TASKS)
+    #error  "OS_CFG.H,         OS_MAX_TASKS must be <= 255 - OS_N_SYS_TASKS"
+    #endif
+    #elif   OS_MAX_TASKS >  ((OS_LOWEST_PRIO - OS_N_SYS_TASKS) + 1)
     #error  "OS_CFG.H,         OS_MAX_TASKS must be <= OS_LOWEST_PRIO - OS_N_SYS_TASKS + 1"
     #endif
 
@@ -1776,6 +2594,154 @@ void          OSCtxSw                 (void);
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                           DEADLINE MONITOR
+*********************************************************************************************************
+*/
+
+#if OS_DEADLINE_EN > 0
+    #if     OS_TIME_GET_SET_EN == 0
+    #error  "OS_CFG.H, OS_TIME_GET_SET_EN must be set to 1 for the deadline monitor (OS_DEADLINE_EN)"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                          BUDGET ENFORCEMENT
+*********************************************************************************************************
+*/
+
+#if OS_BUDGET_EN > 0
+    #if     OS_TIME_GET_SET_EN == 0
+    #error  "OS_CFG.H, OS_TIME_GET_SET_EN must be set to 1 for budget enforcement (OS_BUDGET_EN)"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                            PERIODIC TASKS
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+    #if     OS_TASK_CREATE_EXT_EN == 0
+    #error  "OS_CFG.H, OS_TASK_CREATE_EXT_EN must be set to 1 for periodic tasks (OS_TASK_PERIODIC_EN)"
+    #endif
+    #if     OS_SCHED_LOCK_EN == 0
+    #error  "OS_CFG.H, OS_SCHED_LOCK_EN must be set to 1 for periodic tasks (OS_TASK_PERIODIC_EN)"
+    #endif
+    #if     OS_TIME_GET_SET_EN == 0
+    #error  "OS_CFG.H, OS_TIME_GET_SET_EN must be set to 1 for periodic tasks (OS_TASK_PERIODIC_EN)"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                          CONTEXT SWITCH TRACE
+*********************************************************************************************************
+*/
+
+#if OS_TRACE_EN > 0
+    #if     OS_TRACE_BUF_SIZE == 0
+    #error  "OS_CFG.H, OS_TRACE_BUF_SIZE must be > 0"
+    #endif
+    #if     (OS_TRACE_BUF_SIZE & (OS_TRACE_BUF_SIZE - 1)) != 0
+    #error  "OS_CFG.H, OS_TRACE_BUF_SIZE must be a power of 2"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                             CPU PROFILING
+*********************************************************************************************************
+*/
+
+#if OS_PROFILE_EN > 0
+    #if     OS_TASK_PROFILE_EN == 0
+    #error  "OS_CFG.H, OS_TASK_PROFILE_EN must be set to 1 for CPU profiling (OS_PROFILE_EN)"
+    #endif
+    #ifndef OS_CPU_CYCLES_GET
+    #error  "OS_CPU.H, OS_CPU_CYCLES_GET() must read a free running cycle counter for CPU profiling"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                               CPU LOAD
+*********************************************************************************************************
+*/
+
+#if OS_STAT_LOAD_EN > 0
+    #if     OS_PROFILE_EN == 0
+    #error  "OS_CFG.H, OS_PROFILE_EN must be set to 1 to measure the CPU load (OS_STAT_LOAD_EN)"
+    #endif
+    #if     OS_TASK_STAT_EN == 0
+    #error  "OS_CFG.H, OS_TASK_STAT_EN must be set to 1 to measure the CPU load (OS_STAT_LOAD_EN)"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                        STACK HIGH-WATER MARKS
+*********************************************************************************************************
+*/
+
+#if OS_STK_WM_EN > 0
+    #if     OS_TASK_CREATE_EXT_EN == 0
+    #error  "OS_CFG.H, OS_TASK_CREATE_EXT_EN must be set to 1 for stack high-water marks (OS_STK_WM_EN)"
+    #endif
+    #if     OS_STK_WM_GAP == 0
+    #error  "OS_CFG.H, OS_STK_WM_GAP must be > 0"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                           PRIORITY BITMAPS
+*********************************************************************************************************
+*/
+
+#if (OS_PRIO_MAP64_EN > 0) && (OS_LOWEST_PRIO > 63)
+    #if     OS_CTZ_EN == 0
+    #error  "OS_CFG.H, OS_CTZ_EN must be set to 1 for rows of 64 priorities (OS_PRIO_MAP64_EN)"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                         ROUND-ROBIN SCHEDULING
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+    #if     OS_SCHED_EDF_EN > 0
+    #error  "OS_CFG.H, OS_SCHED_RR_EN and OS_SCHED_EDF_EN cannot both be set to 1"
+    #endif
+    #if     OS_SCHED_RR_QUANTUM > 65535u
+    #error  "OS_CFG.H, OS_SCHED_RR_QUANTUM must be <= 65535"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                              SLOT QUEUES
+*********************************************************************************************************
+*/
+
+#if OS_SLOTQ_EN > 0
+    #if     OS_MAX_EVENTS == 0
+    #error  "OS_CFG.H, OS_MAX_EVENTS must be > 0 to create slot queues (OS_SLOTQ_EN)"
+    #endif
+    #if     (OS_MAX_SLOTQS == 0) || (OS_MAX_SLOTQS > 65500u)
+    #error  "OS_CFG.H, OS_MAX_SLOTQS must be > 0 and <= 65500"
+    #endif
+    #if     (OS_SLOTQ_MAX_SLOTS == 0) || (OS_SLOTQ_MAX_SLOTS > 65500u)
+    #error  "OS_CFG.H, OS_SLOTQ_MAX_SLOTS must be > 0 and <= 65500"
+    #endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                            MISCELLANEOUS
@@ -1823,6 +2789,10 @@ void          OSCtxSw                 (void);
 
 #ifndef OS_EVENT_MULTI_EN
 #error  "OS_CFG.H, Missing OS_EVENT_MULTI_EN: Include code for OSEventPendMulti()"
+#else
+    #if     (OS_EVENT_MULTI_EN > 0) && ((OS_MAX_EVENT_NODES == 0) || (OS_MAX_EVENT_NODES > 65500u))
+    #error  "OS_CFG.H, OS_MAX_EVENT_NODES must be > 0 and <= 65500"
+    #endif
 #endif
 
 